@@ -0,0 +1,75 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BenchMain.cpp
+ *
+ *
+ * This file contains the main function of the microbenchmark program ("qsc-bench").
+ * It executes the microbenchmarks of the core kernels and prints the results in CSV format.
+ *
+ * Usage:
+ * 		qsc-bench [--filter <text>] [--min-time <ms>] [--repetitions <n>] [--output <file>] [--list]
+ *
+ * Options:
+ * 		--filter		Executes only the cases whose name ("kernel/parameters") contains the text.
+ * 		--min-time		Minimum duration of a single measure, in milliseconds (default: 100).
+ * 		--repetitions	Number of measures for each case; the median is reported (default: 3).
+ * 		--output		Writes the CSV results on a file, instead of the standard output.
+ * 		--list			Lists the names of the cases, without executing them.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Microbenchmark.hpp"
+
+using namespace quicksc;
+
+int main(int argc, char **argv) {
+	string filter = "";
+	string output_filename = "";
+	double min_time_ms = 100;
+	unsigned int repetitions = 3;
+	bool list_only = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			min_time_ms = std::stod(argv[++i]);
+		} else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+			repetitions = std::stoi(argv[++i]);
+		} else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+			output_filename = argv[++i];
+		} else if (strcmp(argv[i], "--list") == 0) {
+			list_only = true;
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--filter <text>] [--min-time <ms>] [--repetitions <n>] [--output <file>] [--list]" << std::endl;
+			return 1;
+		}
+	}
+
+	Microbenchmark bench = Microbenchmark(min_time_ms, repetitions);
+	registerKernels(bench);
+
+	if (list_only) {
+		for (string name : bench.getCasesNames()) {
+			std::cout << name << std::endl;
+		}
+		return 0;
+	}
+
+	if (output_filename.empty()) {
+		bench.run(filter, std::cout);
+	} else {
+		std::ofstream output_file(output_filename);
+		if (!output_file.is_open()) {
+			std::cerr << "Unable to open the file " << output_filename << std::endl;
+			return 1;
+		}
+		bench.run(filter, output_file);
+	}
+	return 0;
+}
@@ -0,0 +1,976 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * Kernels.cpp
+ *
+ *
+ * This source file contains the registration of the microbenchmarks for the core kernels of the library:
+ * - State::connectChild, parameterized by the alphabet size and the number of children per label
+ * - ConstructedState::computeEpsilonClosure, parameterized by the number of states and the epsilon-degree
+ * - ConstructedState::createNameFromExtension, parameterized by the size of the extension
+ * - SingularityList::insert and SingularityList::pop, parameterized by the size of the list
+ * - Automaton::getState, parameterized by the size of the automaton
+ * - StreamingNFAGenerator::generate, parameterized by the size of the automaton and by the sink (counting only, or building the automaton)
+ * - AlphabetGenerator::generate, parameterized by the cardinality of the alphabet
+ * - SymbolSampler::sample, parameterized by the cardinality of the alphabet and by the Zipf exponent (times 10)
+ * - ProductAutomaton::isEmpty, parameterized by the size of the operands and by the construction (lazy, or materialized)
+ * - ExecutableDFA::run, parameterized by the size of the DFA and by the matching loop (State graph, compiled table, interleaved streams)
+ * - NFASimulator::accepts, parameterized by the size of the NFA, by its homogeneity, and by the matcher (simulation, or determinized DFA)
+ * - AntichainChecker::isUniversal, parameterized by the size of the NFA and by the check (antichains, or Subset Construction)
+ * - BDDSubsetConstruction::run, parameterized by the size of the NFA and by the algorithm (Subset Construction, or BDD Subset Construction)
+ * - DeterminizationWithMintermsAlgorithm::run, parameterized by the width of the classes and by the labels (one per character, or classes)
+ * - DeterminizationWithAlphabetCompressionAlgorithm::run, parameterized by the number of labels and by the compression (disabled, or enabled)
+ * - ReductionAlgorithm::run, parameterized by the size of the NFA and by the relation (bisimulation, or simulation)
+ * - DeterminizationClient::determinize, parameterized by the size of the NFA and by the execution (in the process, or by a server)
+ * - VersionedAutomaton::publish, parameterized by the size of the automaton and by the number of states modified between two versions
+ * - CachedDeterminizationAlgorithm::run, parameterized by the size of the NFA and by the execution (Subset Construction, or cache hit)
+ *
+ * The random values are generated with a fixed seed, so that every execution measures the same structures.
+ */
+
+#include "Microbenchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "Alphabet.hpp"
+#include "Automaton.hpp"
+#include "AlphabetGenerator.hpp"
+#include "AntichainChecker.hpp"
+#include "BDDSubsetConstruction.hpp"
+#include "CachedDeterminizationAlgorithm.hpp"
+#include "CharClass.hpp"
+#include "Configurations.hpp"
+#include "DeterminizationServer.hpp"
+#include "DeterminizationWithAlphabetCompressionAlgorithm.hpp"
+#include "DeterminizationWithMintermsAlgorithm.hpp"
+#include "ExecutableDFA.hpp"
+#include "NFASimulator.hpp"
+#include "ProductAutomaton.hpp"
+#include "Properties.hpp"
+#include "ReductionAlgorithm.hpp"
+#include "Singularity.hpp"
+#include "State.hpp"
+#include "StreamingNFAGenerator.hpp"
+#include "SubsetConstruction.hpp"
+#include "SymbolTable.hpp"
+#include "VersionedAutomaton.hpp"
+
+namespace quicksc {
+
+	#define BENCH_SEED 12345
+
+	/** Creates a vector of "n" states, named "s0", "s1", ... */
+	vector<State*> createStates(unsigned long n) {
+		vector<State*> states;
+		states.reserve(n);
+		for (unsigned long i = 0; i < n; i++) {
+			states.push_back(new State("s" + std::to_string(i)));
+		}
+		return states;
+	}
+
+	/** Deletes a vector of states, after detaching all their transitions. */
+	void deleteStates(vector<State*>& states) {
+		for (State* s : states) {
+			s->detachAllTransitions();
+		}
+		for (State* s : states) {
+			delete s;
+		}
+		states.clear();
+	}
+
+	/** Creates a vector of "k" labels, named "a0", "a1", ... */
+	vector<string> createLabels(unsigned long k) {
+		vector<string> labels;
+		for (unsigned long i = 0; i < k; i++) {
+			labels.push_back("a" + std::to_string(i));
+		}
+		return labels;
+	}
+
+	/** Deletes an automaton together with its states. */
+	void deleteAutomaton(Automaton* automaton) {
+		vector<State*> states = automaton->getStatesVector();
+		delete automaton;
+		deleteStates(states);
+	}
+
+	/**
+	 * Measures the determinization of the NFA: each operation is a run of the algorithm, whose DFA is deleted
+	 * outside the measure. The NFA and the algorithm are deleted at the end.
+	 */
+	void measureDeterminization(BenchmarkContext& ctx, Automaton* nfa, DeterminizationAlgorithm* algorithm) {
+		for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+			algorithm->resetRuntimeStatsValues();
+			ctx.resumeTiming();
+			Automaton* dfa = algorithm->run(nfa);
+			ctx.pauseTiming();
+			deleteAutomaton(dfa);
+		}
+		delete algorithm;
+		deleteAutomaton(nfa);
+	}
+
+	/**
+	 * Benchmark of State::connectChild.
+	 * A single state is connected to "d" children for each one of the "k" labels.
+	 * When all the transitions have been created, the state is replaced (outside the measure).
+	 */
+	void registerConnectChild(Microbenchmark& bench) {
+		for (unsigned long k : {2, 10, 50}) {
+			for (unsigned long d : {1, 4, 16}) {
+				bench.add("State::connectChild", {{"k", k}, {"d", d}}, [k, d](BenchmarkContext& ctx) {
+					vector<State*> children = createStates(d);
+					vector<string> labels = createLabels(k);
+					State* parent = new State("parent");
+					unsigned long transitions_per_state = k * d;
+
+					ctx.resumeTiming();
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						unsigned long index = i % transitions_per_state;
+						if (index == 0 && i > 0) {
+							ctx.pauseTiming();
+							parent->detachAllTransitions();
+							delete parent;
+							parent = new State("parent");
+							ctx.resumeTiming();
+						}
+						parent->connectChild(labels[index / d], children[index % d]);
+					}
+					ctx.pauseTiming();
+
+					parent->detachAllTransitions();
+					delete parent;
+					deleteStates(children);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of ConstructedState::computeEpsilonClosure.
+	 * The automaton has "n" states, each one with "e" epsilon-transitions towards random states.
+	 * Each operation computes the closure of a single random state.
+	 */
+	void registerEpsilonClosure(Microbenchmark& bench) {
+		for (unsigned long n : {100, 1000, 10000}) {
+			for (unsigned long e : {1, 2, 4}) {
+				bench.add("ConstructedState::computeEpsilonClosure", {{"n", n}, {"e", e}}, [n, e](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					vector<State*> states = createStates(n);
+					for (State* s : states) {
+						for (unsigned long j = 0; j < e; j++) {
+							s->connectChild(EPSILON, states[rand() % n]);
+						}
+					}
+					vector<State*> sources;
+					for (unsigned long i = 0; i < 1024; i++) {
+						sources.push_back(states[rand() % n]);
+					}
+
+					unsigned long long total_size = 0;
+					ctx.resumeTiming();
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						total_size += ConstructedState::computeEpsilonClosure(sources[i % sources.size()]).size();
+					}
+					ctx.pauseTiming();
+					ctx.consume(total_size);
+
+					deleteStates(states);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of ConstructedState::createNameFromExtension.
+	 * Each operation creates the name of an extension of "s" states.
+	 */
+	void registerCreateName(Microbenchmark& bench) {
+		for (unsigned long s : {1, 10, 100, 1000}) {
+			bench.add("ConstructedState::createNameFromExtension", {{"s", s}}, [s](BenchmarkContext& ctx) {
+				vector<State*> states = createStates(s);
+				Extension ext = Extension(states.begin(), states.end());
+
+				unsigned long long total_length = 0;
+				ctx.resumeTiming();
+				for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+					total_length += ConstructedState::createNameFromExtension(ext).length();
+				}
+				ctx.pauseTiming();
+				ctx.consume(total_length);
+
+				deleteStates(states);
+			});
+		}
+	}
+
+	/**
+	 * Creates "n" constructed states with a random distance in [0, max_distance),
+	 * each one having an extension of a single state.
+	 */
+	vector<ConstructedState*> createConstructedStates(vector<State*>& base_states, unsigned int max_distance) {
+		vector<ConstructedState*> constructed;
+		for (State* s : base_states) {
+			Extension ext = Extension();
+			ext.insert(s);
+			ConstructedState* cs = new ConstructedState(ext);
+			cs->setDistance(rand() % max_distance);
+			constructed.push_back(cs);
+		}
+		return constructed;
+	}
+
+	/**
+	 * Benchmark of SingularityList::insert and SingularityList::pop.
+	 * The list is filled with "n" singularities, over "n / k" states and "k" labels.
+	 * For the insertion, each operation inserts a singularity; when the list is full, it's emptied (outside the measure).
+	 * For the extraction, each operation pops a singularity; when the list is empty, it's refilled (outside the measure).
+	 */
+	void registerSingularityList(Microbenchmark& bench) {
+		const unsigned long k = 10;
+		for (unsigned long n : {100, 1000, 10000}) {
+
+			auto create_singularities = [n, k](vector<State*>& base_states, vector<ConstructedState*>& constructed) {
+				srand(BENCH_SEED);
+				base_states = createStates(n / k);
+				constructed = createConstructedStates(base_states, 100);
+				vector<string> labels = createLabels(k);
+				vector<Singularity*> singularities;
+				for (ConstructedState* cs : constructed) {
+					for (string& label : labels) {
+						singularities.push_back(new Singularity(cs, label));
+					}
+				}
+				// Shuffling, so that the insertion order is not the sorted one
+				for (unsigned long i = singularities.size() - 1; i > 0; i--) {
+					std::swap(singularities[i], singularities[rand() % (i + 1)]);
+				}
+				return singularities;
+			};
+
+			auto delete_singularities = [](vector<Singularity*>& singularities, vector<State*>& base_states, vector<ConstructedState*>& constructed) {
+				for (Singularity* singularity : singularities) {
+					delete singularity;
+				}
+				for (ConstructedState* cs : constructed) {
+					delete cs;
+				}
+				deleteStates(base_states);
+			};
+
+			bench.add("SingularityList::insert", {{"n", n}, {"k", k}}, [n, create_singularities, delete_singularities](BenchmarkContext& ctx) {
+				vector<State*> base_states;
+				vector<ConstructedState*> constructed;
+				vector<Singularity*> singularities = create_singularities(base_states, constructed);
+				SingularityList* list = new SingularityList();
+
+				ctx.resumeTiming();
+				for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+					unsigned long index = i % singularities.size();
+					if (index == 0 && i > 0) {
+						ctx.pauseTiming();
+						delete list;
+						list = new SingularityList();
+						ctx.resumeTiming();
+					}
+					list->insert(singularities[index]);
+				}
+				ctx.pauseTiming();
+
+				delete list;
+				delete_singularities(singularities, base_states, constructed);
+			});
+
+			bench.add("SingularityList::pop", {{"n", n}, {"k", k}}, [n, create_singularities, delete_singularities](BenchmarkContext& ctx) {
+				vector<State*> base_states;
+				vector<ConstructedState*> constructed;
+				vector<Singularity*> singularities = create_singularities(base_states, constructed);
+				SingularityList* list = new SingularityList();
+
+				ctx.resumeTiming();
+				for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+					if (list->empty()) {
+						ctx.pauseTiming();
+						for (Singularity* singularity : singularities) {
+							list->insert(singularity);
+						}
+						ctx.resumeTiming();
+					}
+					ctx.consume(list->pop());
+				}
+				ctx.pauseTiming();
+
+				delete list;
+				delete_singularities(singularities, base_states, constructed);
+			});
+		}
+	}
+
+	/**
+	 * Benchmark of Automaton::getState.
+	 * The automaton has "n" states; each operation looks up a random existing name.
+	 */
+	void registerGetState(Microbenchmark& bench) {
+		for (unsigned long n : {100, 1000, 10000}) {
+			bench.add("Automaton::getState", {{"n", n}}, [n](BenchmarkContext& ctx) {
+				srand(BENCH_SEED);
+				Automaton* automaton = new Automaton();
+				vector<State*> states = createStates(n);
+				for (State* s : states) {
+					automaton->addState(s);
+				}
+				vector<string> names;
+				for (unsigned long i = 0; i < 1024; i++) {
+					names.push_back(states[rand() % n]->getName());
+				}
+
+				unsigned long long found = 0;
+				ctx.resumeTiming();
+				for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+					if (automaton->getState(names[i % names.size()]) != NULL) {
+						found++;
+					}
+				}
+				ctx.pauseTiming();
+				ctx.consume(found);
+
+				delete automaton;
+				deleteStates(states);
+			});
+		}
+	}
+
+	/**
+	 * Sink that only counts the transitions, so that the benchmark measures the generation alone.
+	 */
+	class CountingSink : public TransitionSink {
+	public:
+		unsigned long long transitions = 0;
+		void begin(unsigned long, const vector<string>&, unsigned long) override {}
+		void addState(unsigned long, bool) override {}
+		void addTransition(unsigned long, uint32_t, unsigned long) override { this->transitions++; }
+		void end() override {}
+	};
+
+	/**
+	 * Benchmark of StreamingNFAGenerator::generate.
+	 * Each operation generates a random NFA of "n" states, with the default settings for the alphabet and the transitions.
+	 * With "b = 0" the transitions are only counted, with "b = 1" the Automaton object is built (and deleted outside the measure).
+	 */
+	void registerStreamingGenerator(Microbenchmark& bench) {
+		for (unsigned long n : {10000, 100000, 1000000}) {
+			for (unsigned long b : {0, 1}) {
+				bench.add("StreamingNFAGenerator::generate", {{"n", n}, {"b", b}}, [n, b](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					// An empty file name loads the default settings
+					Configurations* config = new Configurations();
+					config->load("");
+					config->overrideValue(AutomatonSize, n);
+					config->overrideValue(AutomatonStructure, AUTOMATON_RANDOM);
+					AlphabetGenerator alphabet_generator = AlphabetGenerator();
+					alphabet_generator.setCardinality(config->valueOf<unsigned int>(AlphabetCardinality));
+					StreamingNFAGenerator* generator = new StreamingNFAGenerator(alphabet_generator.generate(), config);
+
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						if (b == 0) {
+							CountingSink sink = CountingSink();
+							ctx.resumeTiming();
+							generator->generate(sink);
+							ctx.pauseTiming();
+							ctx.consume(sink.transitions);
+						} else {
+							AutomatonBuilder builder = AutomatonBuilder("s");
+							ctx.resumeTiming();
+							generator->generate(builder);
+							ctx.pauseTiming();
+							deleteAutomaton(builder.getAutomaton());
+						}
+					}
+
+					delete generator;
+					delete config;
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of AlphabetGenerator::generate.
+	 * Each operation builds the string forms of an alphabet of "n" symbols.
+	 */
+	void registerAlphabetGeneration(Microbenchmark& bench) {
+		for (unsigned long n : {100, 10000, 100000}) {
+			bench.add("AlphabetGenerator::generate", {{"n", n}}, [n](BenchmarkContext& ctx) {
+				AlphabetGenerator alphabet_generator = AlphabetGenerator();
+				alphabet_generator.setCardinality(n);
+
+				unsigned long long total_size = 0;
+				ctx.resumeTiming();
+				for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+					total_size += alphabet_generator.generate().size();
+				}
+				ctx.pauseTiming();
+				ctx.consume(total_size);
+			});
+		}
+	}
+
+	/**
+	 * Benchmark of SymbolSampler::sample.
+	 * Each operation draws a symbol from an alphabet of "n" symbols, with Zipf exponent "z / 10".
+	 * The random values are computed before the measure.
+	 */
+	void registerSymbolSampler(Microbenchmark& bench) {
+		const unsigned long draws = 1024;
+		for (unsigned long n : {100, 100000}) {
+			for (unsigned long z : {0, 10, 15}) {
+				bench.add("SymbolSampler::sample", {{"n", n}, {"z", z}}, [n, z, draws](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					SymbolSampler sampler = SymbolSampler(n, z / 10.0);
+					vector<uint32_t> columns;
+					vector<double> coins;
+					for (unsigned long d = 0; d < draws; d++) {
+						columns.push_back(rand() % n);
+						coins.push_back(static_cast <double> (rand()) / (static_cast <double> (RAND_MAX) + 1.0));
+					}
+
+					unsigned long long total = 0;
+					ctx.resumeTiming();
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						total += sampler.sample(columns[i % draws], coins[i % draws]);
+					}
+					ctx.pauseTiming();
+					ctx.consume(total);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Creates a random automaton of "n" states over "k" labels, with "d" children per label for each state.
+	 * About one state in ten is final.
+	 */
+	Automaton* createRandomAutomaton(unsigned long n, unsigned long k, unsigned long d) {
+		Automaton* automaton = new Automaton();
+		vector<State*> states = createStates(n);
+		vector<string> labels = createLabels(k);
+		for (State* s : states) {
+			s->setFinal(rand() % 10 == 0);
+			automaton->addState(s);
+		}
+		for (State* s : states) {
+			for (string l : labels) {
+				for (unsigned long c = 0; c < d; c++) {
+					s->connectChild(l, states[rand() % n]);
+				}
+			}
+		}
+		automaton->setInitialState(states[0]);
+		return automaton;
+	}
+
+	/**
+	 * Benchmark of ProductAutomaton::isEmpty.
+	 * The operands are two random automata of "n" states; each operation checks the emptiness of their intersection.
+	 * With "m = 0" the product is built on the fly and the check stops at the first final pair,
+	 * with "m = 1" the whole reachable product is materialized before the check.
+	 */
+	void registerProductEmptiness(Microbenchmark& bench) {
+		for (unsigned long n : {30, 100}) {
+			for (unsigned long m : {0, 1}) {
+				bench.add("ProductAutomaton::isEmpty", {{"n", n}, {"m", m}}, [n, m](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* left = createRandomAutomaton(n, 4, 2);
+					Automaton* right = createRandomAutomaton(n, 4, 2);
+
+					unsigned long long empty = 0;
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						ctx.resumeTiming();
+						ProductAutomaton* product = new ProductAutomaton(left, right, ProductAutomaton::PRODUCT_INTERSECTION);
+						Automaton* materialized = NULL;
+						if (m == 1) {
+							materialized = product->materialize();
+						}
+						if (product->isEmpty()) {
+							empty++;
+						}
+						ctx.pauseTiming();
+						if (materialized != NULL) {
+							deleteAutomaton(materialized);
+						}
+						delete product;
+					}
+					ctx.consume(empty);
+
+					deleteAutomaton(left);
+					deleteAutomaton(right);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of ExecutableDFA::run.
+	 * The DFA is a random complete DFA of "n" states over 16 labels; each operation reads one symbol of a random input.
+	 * With "s = 0" the input is read walking the State objects with State::getChild, with "s = 1" it's read with the
+	 * compiled table, with "s = EXECUTABLE_STREAMS" it's split in interleaved streams.
+	 * Since the IDs of the symbols take 4 bytes, the throughput in GB/s is 4 / ns_per_op.
+	 */
+	void registerExecutableDFA(Microbenchmark& bench) {
+		const unsigned long k = 16;
+		const unsigned long chunk = 4096;
+		for (unsigned long n : {100, 10000}) {
+			for (unsigned long s : {0, 1, EXECUTABLE_STREAMS}) {
+				bench.add("ExecutableDFA::run", {{"n", n}, {"s", s}}, [n, s, k, chunk](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* dfa = createRandomAutomaton(n, k, 1);
+					ExecutableDFA* executable = new ExecutableDFA(dfa);
+					vector<string> labels = createLabels(k);
+					vector<string> word;
+					for (unsigned long i = 0; i < chunk * EXECUTABLE_STREAMS; i++) {
+						word.push_back(labels[rand() % k]);
+					}
+					vector<uint32_t> input = executable->encode(word);
+
+					unsigned long long accepted = 0;
+					ctx.resumeTiming();
+					for (unsigned long long done = 0; done < ctx.getIterations(); ) {
+						unsigned long long length = std::min<unsigned long long>(ctx.getIterations() - done, chunk * EXECUTABLE_STREAMS);
+						if (s == 0) {
+							State* current = dfa->getInitialState();
+							for (unsigned long long i = 0; i < length; i++) {
+								current = current->getChild(word[i]);
+							}
+							accepted += current->isFinal();
+						} else if (s == 1) {
+							accepted += executable->accepts(input.data(), length);
+						} else {
+							const uint32_t* inputs[EXECUTABLE_STREAMS];
+							size_t lengths[EXECUTABLE_STREAMS];
+							bool results[EXECUTABLE_STREAMS];
+							for (unsigned int j = 0; j < EXECUTABLE_STREAMS; j++) {
+								inputs[j] = input.data() + j * chunk;
+								lengths[j] = length / EXECUTABLE_STREAMS + (j == 0 ? length % EXECUTABLE_STREAMS : 0);
+							}
+							executable->acceptsInterleaved(inputs, lengths, results);
+							accepted += results[0];
+						}
+						done += length;
+					}
+					ctx.pauseTiming();
+					ctx.consume(accepted);
+
+					delete executable;
+					deleteAutomaton(dfa);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Creates a random homogeneous automaton of "n" states over "k" labels, where all the transitions entering a state
+	 * have the same label. Each state has "d" children for each label.
+	 * About one state in ten is final.
+	 */
+	Automaton* createRandomHomogeneousAutomaton(unsigned long n, unsigned long k, unsigned long d) {
+		Automaton* automaton = new Automaton();
+		vector<State*> states = createStates(n);
+		vector<string> labels = createLabels(k);
+		vector<vector<State*>> entered_by = vector<vector<State*>>(k);
+		for (unsigned long i = 0; i < n; i++) {
+			states[i]->setFinal(rand() % 10 == 0);
+			automaton->addState(states[i]);
+			// Every label enters at least one state
+			entered_by[(i < k) ? i : (rand() % k)].push_back(states[i]);
+		}
+		for (State* s : states) {
+			for (unsigned long l = 0; l < k; l++) {
+				for (unsigned long c = 0; c < d; c++) {
+					s->connectChild(labels[l], entered_by[l][rand() % entered_by[l].size()]);
+				}
+			}
+		}
+		automaton->setInitialState(states[0]);
+		return automaton;
+	}
+
+	/**
+	 * Benchmark of NFASimulator::accepts.
+	 * The NFA has "n" states over 4 labels, with 2 children per label; with "g = 1" it's homogeneous.
+	 * Each operation reads one symbol of a random input. With "d = 0" the input is read by the simulator,
+	 * with "d = 1" by the ExecutableDFA compiled from the determinization of the NFA (only for the smallest NFAs,
+	 * since the determinization of the larger ones blows up); the determinization is not measured.
+	 */
+	void registerNFASimulator(Microbenchmark& bench) {
+		const unsigned long k = 4;
+		const unsigned long chunk = 4096;
+		for (unsigned long n : {16, 64, 1000}) {
+			for (unsigned long g : {0, 1}) {
+				for (unsigned long d : {0, 1}) {
+					if (d == 1 && n > 16) {
+						continue;
+					}
+					bench.add("NFASimulator::accepts", {{"n", n}, {"g", g}, {"d", d}}, [n, g, d, k, chunk](BenchmarkContext& ctx) {
+						srand(BENCH_SEED);
+						Automaton* nfa = (g == 0) ? createRandomAutomaton(n, k, 2) : createRandomHomogeneousAutomaton(n, k, 2);
+						NFASimulator* simulator = new NFASimulator(nfa);
+						Automaton* dfa = NULL;
+						ExecutableDFA* executable = NULL;
+						if (d == 1) {
+							SubsetConstruction sc = SubsetConstruction();
+							dfa = sc.run(nfa);
+							executable = new ExecutableDFA(dfa);
+						}
+						vector<string> labels = createLabels(k);
+						vector<string> word;
+						for (unsigned long i = 0; i < chunk; i++) {
+							word.push_back(labels[rand() % k]);
+						}
+						vector<uint32_t> input = (d == 0) ? simulator->encode(word) : executable->encode(word);
+
+						unsigned long long accepted = 0;
+						ctx.resumeTiming();
+						for (unsigned long long done = 0; done < ctx.getIterations(); ) {
+							unsigned long long length = std::min<unsigned long long>(ctx.getIterations() - done, chunk);
+							if (d == 0) {
+								accepted += simulator->accepts(input.data(), length);
+							} else {
+								accepted += executable->accepts(input.data(), length);
+							}
+							done += length;
+						}
+						ctx.pauseTiming();
+						ctx.consume(accepted);
+
+						delete simulator;
+						if (dfa != NULL) {
+							delete executable;
+							deleteAutomaton(dfa);
+						}
+						deleteAutomaton(nfa);
+					});
+				}
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of AntichainChecker::isUniversal.
+	 * The NFA is a random NFA of "n" states over 4 labels, with 2 children per label, where nine states in ten are final.
+	 * With "a = 0" each operation runs the antichain check, with "a = 1" it determinizes the NFA with the Subset Construction
+	 * and looks for a non-final or incomplete state of the DFA (only for the smallest NFAs).
+	 */
+	void registerAntichainChecker(Microbenchmark& bench) {
+		const unsigned long k = 4;
+		for (unsigned long n : {16, 64}) {
+			for (unsigned long a : {0, 1}) {
+				if (a == 1 && n > 16) {
+					continue;
+				}
+				bench.add("AntichainChecker::isUniversal", {{"n", n}, {"a", a}}, [n, a, k](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = createRandomAutomaton(n, k, 2);
+					for (State* s : nfa->getStatesList()) {
+						s->setFinal(rand() % 10 != 0);
+					}
+
+					unsigned long long universal = 0;
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						if (a == 0) {
+							AntichainChecker checker = AntichainChecker();
+							ctx.resumeTiming();
+							universal += checker.isUniversal(nfa);
+							ctx.pauseTiming();
+						} else {
+							SubsetConstruction sc = SubsetConstruction();
+							ctx.resumeTiming();
+							Automaton* dfa = sc.run(nfa);
+							bool dfa_universal = true;
+							for (State* s : dfa->getStatesList()) {
+								dfa_universal = dfa_universal && s->isFinal() && s->getExitingTransitionsCount() == (int) k;
+							}
+							universal += dfa_universal;
+							ctx.pauseTiming();
+							deleteAutomaton(dfa);
+						}
+					}
+					ctx.consume(universal);
+
+					deleteAutomaton(nfa);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of BDDSubsetConstruction::run.
+	 * The NFA is a random NFA of "n" states over 4 labels, with 2 children per label.
+	 * With "b = 0" each operation runs the Subset Construction, with "b = 1" the BDD Subset Construction.
+	 */
+	void registerBDDSubsetConstruction(Microbenchmark& bench) {
+		for (unsigned long n : {10, 16}) {
+			for (unsigned long b : {0, 1}) {
+				bench.add("BDDSubsetConstruction::run", {{"n", n}, {"b", b}}, [n, b](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					DeterminizationAlgorithm* algorithm = (b == 0)
+							? (DeterminizationAlgorithm*) new SubsetConstruction()
+							: (DeterminizationAlgorithm*) new BDDSubsetConstruction();
+					measureDeterminization(ctx, createRandomAutomaton(n, 4, 2), algorithm);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of DeterminizationWithMintermsAlgorithm::run.
+	 * The NFA has 8 states, each one with 3 exiting transitions labeled with random ranges of "w" code points.
+	 * With "c = 0" every range is expanded into a transition for each character, determinized with the Subset Construction;
+	 * with "c = 1" the ranges are kept as classes, determinized with the Subset Construction on minterms.
+	 */
+	void registerMintermsDeterminization(Microbenchmark& bench) {
+		const unsigned long n = 8;
+		for (unsigned long w : {16, 256}) {
+			for (unsigned long c : {0, 1}) {
+				bench.add("DeterminizationWithMintermsAlgorithm::run", {{"w", w}, {"c", c}}, [n, w, c](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = new Automaton();
+					vector<State*> states = createStates(n);
+					for (State* s : states) {
+						s->setFinal(rand() % 4 == 0);
+						nfa->addState(s);
+					}
+					for (State* s : states) {
+						for (unsigned long t = 0; t < 3; t++) {
+							uint32_t first = rand() % (4 * w);
+							State* child = states[rand() % n];
+							if (c == 1) {
+								s->connectChild(CharClass(first, first + w - 1).toLabel(), child);
+							} else {
+								for (uint32_t code_point = first; code_point < first + w; code_point++) {
+									s->connectChild("c" + std::to_string(code_point), child);
+								}
+							}
+						}
+					}
+					nfa->setInitialState(states[0]);
+
+					DeterminizationAlgorithm* algorithm = (c == 0)
+							? (DeterminizationAlgorithm*) new SubsetConstruction()
+							: (DeterminizationAlgorithm*) new DeterminizationWithMintermsAlgorithm(new SubsetConstruction());
+					measureDeterminization(ctx, nfa, algorithm);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of DeterminizationWithAlphabetCompressionAlgorithm::run.
+	 * The NFA is a random NFA of 12 states over 4 labels, with 2 children per label; each label is then replicated
+	 * into "k / 4" equivalent labels, marking the same transitions.
+	 * With "c = 0" each operation runs the Subset Construction, with "c = 1" the Subset Construction with alphabet compression.
+	 */
+	void registerAlphabetCompression(Microbenchmark& bench) {
+		for (unsigned long k : {4, 64}) {
+			for (unsigned long c : {0, 1}) {
+				bench.add("DeterminizationWithAlphabetCompressionAlgorithm::run", {{"k", k}, {"c", c}}, [k, c](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = createRandomAutomaton(12, 4, 2);
+					for (State* s : nfa->getStatesList()) {
+						map<string, set<State*>> transitions = s->getExitingTransitions();
+						for (auto &pair : transitions) {
+							for (unsigned long copy = 1; copy < k / 4; copy++) {
+								for (State* child : pair.second) {
+									s->connectChild(pair.first + "_" + std::to_string(copy), child);
+								}
+							}
+						}
+					}
+
+					DeterminizationAlgorithm* algorithm = (c == 0)
+							? (DeterminizationAlgorithm*) new SubsetConstruction()
+							: (DeterminizationAlgorithm*) new DeterminizationWithAlphabetCompressionAlgorithm(new SubsetConstruction());
+					measureDeterminization(ctx, nfa, algorithm);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of ReductionAlgorithm::run, in the forward direction.
+	 * The NFA is a random NFA of "n" states over 4 labels, with 2 children per label.
+	 * With "r = 0" each operation computes the quotient by bisimulation, with "r = 1" the quotient by simulation equivalence.
+	 */
+	void registerReduction(Microbenchmark& bench) {
+		for (unsigned long n : {100, 500}) {
+			for (unsigned long r : {0, 1}) {
+				bench.add("ReductionAlgorithm::run", {{"n", n}, {"r", r}}, [n, r](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = createRandomAutomaton(n, 4, 2);
+					ReductionAlgorithm* algorithm = (r == 0)
+							? (ReductionAlgorithm*) new BisimulationReductionAlgorithm()
+							: (ReductionAlgorithm*) new SimulationReductionAlgorithm();
+
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						ctx.resumeTiming();
+						Automaton* reduced_nfa = algorithm->run(nfa);
+						ctx.pauseTiming();
+						deleteAutomaton(reduced_nfa);
+					}
+
+					delete algorithm;
+					deleteAutomaton(nfa);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of DeterminizationClient::determinize, with the Subset Construction.
+	 * The NFA is a small random NFA of "n" states over 2 labels, with 2 children per label.
+	 * With "s = 0" each operation runs the algorithm in the process, with "s = 1" it sends the NFA to a server
+	 * with a single worker, started before the measures, and receives the DFA on the same connection.
+	 */
+	void registerDeterminizationServer(Microbenchmark& bench) {
+		for (unsigned long n : {4, 8}) {
+			for (unsigned long s : {0, 1}) {
+				bench.add("DeterminizationClient::determinize", {{"n", n}, {"s", s}}, [n, s](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = createRandomAutomaton(n, 2, 2);
+					string socket_path = "/tmp/qsc-bench-" + std::to_string(getpid()) + ".sock";
+					DeterminizationServer* server = NULL;
+					DeterminizationClient* client = NULL;
+					DeterminizationAlgorithm* algorithm = new SubsetConstruction();
+					if (s == 1) {
+						server = new DeterminizationServer(NULL, socket_path, SC_ABBR, 1);
+						server->start();
+						client = new DeterminizationClient(socket_path);
+					}
+
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						Automaton* dfa;
+						ctx.resumeTiming();
+						if (s == 0) {
+							algorithm->resetRuntimeStatsValues();
+							dfa = algorithm->run(nfa);
+						} else {
+							dfa = client->determinize(nfa);
+						}
+						ctx.pauseTiming();
+						deleteAutomaton(dfa);
+					}
+
+					if (s == 1) {
+						delete client;
+						delete server;
+					}
+					delete algorithm;
+					deleteAutomaton(nfa);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of VersionedAutomaton::publish.
+	 * The automaton is a random automaton of "n" states over 4 labels, with 2 children per label.
+	 * Before each operation (not measured), "m" random states get a new transition; the operation publishes the new version,
+	 * rebuilding only the rows of the modified states and copying only their chunks.
+	 */
+	void registerVersionedAutomaton(Microbenchmark& bench) {
+		for (unsigned long n : {1000, 10000}) {
+			for (unsigned long m : {1, 100}) {
+				bench.add("VersionedAutomaton::publish", {{"n", n}, {"m", m}}, [n, m](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* automaton = createRandomAutomaton(n, 4, 2);
+					vector<State*> states = automaton->getStatesVector();
+					VersionedAutomaton* versioned_automaton = new VersionedAutomaton();
+					versioned_automaton->attach(automaton);
+
+					for (unsigned long long i = 0; i < ctx.getIterations(); i++) {
+						for (unsigned long j = 0; j < m; j++) {
+							states[rand() % n]->connectChild("a0", states[rand() % n]);
+						}
+						ctx.resumeTiming();
+						versioned_automaton->publish();
+						ctx.pauseTiming();
+					}
+
+					versioned_automaton->detach();
+					delete versioned_automaton;
+					delete automaton;
+					deleteStates(states);
+				});
+			}
+		}
+	}
+
+	/**
+	 * Benchmark of CachedDeterminizationAlgorithm::run, with the Subset Construction.
+	 * The NFA is a random NFA of "n" states over 2 labels, with 2 children per label.
+	 * With "s = 0" each operation runs the algorithm, with "s = 1" it finds the DFA in the cache, filled before the measures:
+	 * the operation includes the fingerprint of the NFA, the reading of the entry and the reconstruction of the DFA.
+	 */
+	void registerCachedDeterminization(Microbenchmark& bench) {
+		for (unsigned long n : {8, 12}) {
+			for (unsigned long s : {0, 1}) {
+				bench.add("CachedDeterminizationAlgorithm::run", {{"n", n}, {"s", s}}, [n, s](BenchmarkContext& ctx) {
+					srand(BENCH_SEED);
+					Automaton* nfa = createRandomAutomaton(n, 2, 2);
+					DeterminizationAlgorithm* algorithm = new SubsetConstruction();
+					// The cache is kept in a new temporary directory, removed at the end
+					char cache_directory[] = "/tmp/qsc-bench-cache-XXXXXX";
+					string cache_entry;
+					if (s == 1) {
+						if (mkdtemp(cache_directory) == NULL) {
+							throw "Cannot create the temporary directory of the cache";
+						}
+						algorithm = new CachedDeterminizationAlgorithm(algorithm, string(cache_directory) + "/");
+						// Filling the cache
+						deleteAutomaton(algorithm->run(nfa));
+						AutomatonFingerprint fingerprint = AutomatonFingerprint(nfa);
+						cache_entry = string(cache_directory) + "/" + fingerprint.getFingerprintString() + "_" + SC_ABBR + FILE_EXTENSION_BINARY;
+					}
+
+					measureDeterminization(ctx, nfa, algorithm);
+
+					if (s == 1) {
+						std::remove(cache_entry.c_str());
+						rmdir(cache_directory);
+					}
+				});
+			}
+		}
+	}
+
+	/**
+	 * Registers all the kernels of the library in the benchmark harness.
+	 */
+	void registerKernels(Microbenchmark& bench) {
+		registerConnectChild(bench);
+		registerEpsilonClosure(bench);
+		registerCreateName(bench);
+		registerSingularityList(bench);
+		registerGetState(bench);
+		registerStreamingGenerator(bench);
+		registerAlphabetGeneration(bench);
+		registerSymbolSampler(bench);
+		registerProductEmptiness(bench);
+		registerExecutableDFA(bench);
+		registerNFASimulator(bench);
+		registerAntichainChecker(bench);
+		registerBDDSubsetConstruction(bench);
+		registerMintermsDeterminization(bench);
+		registerAlphabetCompression(bench);
+		registerReduction(bench);
+		registerDeterminizationServer(bench);
+		registerVersionedAutomaton(bench);
+		registerCachedDeterminization(bench);
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,219 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * Microbenchmark.cpp
+ *
+ *
+ * This source file contains the implementation of the microbenchmark harness.
+ * The allocations performed by the measured kernels are counted by the MemoryProfiler of the library.
+ */
+
+#include "Microbenchmark.hpp"
+
+#include <algorithm>
+
+#include "MemoryProfiler.hpp"
+
+namespace quicksc {
+
+	/** Number of calibration rounds before giving up on reaching the minimum time. */
+	#define MAX_CALIBRATION_ROUNDS 30
+
+	/**
+	 * Constructor.
+	 * The number of iterations is decided by the harness during the calibration.
+	 */
+	BenchmarkContext::BenchmarkContext(unsigned long long iterations) {
+		this->m_iterations = iterations;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BenchmarkContext::~BenchmarkContext() {}
+
+	/**
+	 * Returns the number of operations the body of the case has to execute.
+	 */
+	unsigned long long BenchmarkContext::getIterations() {
+		return this->m_iterations;
+	}
+
+	/**
+	 * Starts (or restarts) the measurement of time and allocations.
+	 */
+	void BenchmarkContext::resumeTiming() {
+		if (this->m_running) {
+			return;
+		}
+		this->m_running = true;
+		this->m_start_allocations = MemoryProfiler::getAllocationsCount();
+		this->m_start_bytes = MemoryProfiler::getAllocatedBytes();
+		this->m_start = std::chrono::steady_clock::now();
+	}
+
+	/**
+	 * Stops the measurement of time and allocations, accumulating the values measured since the last resume.
+	 */
+	void BenchmarkContext::pauseTiming() {
+		if (!this->m_running) {
+			return;
+		}
+		auto end = std::chrono::steady_clock::now();
+		this->m_elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->m_start).count();
+		this->m_allocations += MemoryProfiler::getAllocationsCount() - this->m_start_allocations;
+		this->m_bytes += MemoryProfiler::getAllocatedBytes() - this->m_start_bytes;
+		this->m_running = false;
+	}
+
+	/**
+	 * Returns the total measured time, in nanoseconds.
+	 */
+	unsigned long long BenchmarkContext::getElapsedNanoseconds() {
+		return this->m_elapsed_ns;
+	}
+
+	/**
+	 * Returns the total number of allocations measured.
+	 */
+	unsigned long long BenchmarkContext::getAllocations() {
+		return this->m_allocations;
+	}
+
+	/**
+	 * Returns the total number of allocated bytes measured.
+	 */
+	unsigned long long BenchmarkContext::getAllocatedBytes() {
+		return this->m_bytes;
+	}
+
+	/**
+	 * Constructor.
+	 * Each case is executed with a number of iterations large enough to last at least "min_time_ms" milliseconds,
+	 * and then it's repeated "repetitions" times. The reported result is the median of the repetitions.
+	 */
+	Microbenchmark::Microbenchmark(double min_time_ms, unsigned int repetitions) {
+		this->m_min_time_ms = min_time_ms;
+		this->m_repetitions = (repetitions == 0) ? 1 : repetitions;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	Microbenchmark::~Microbenchmark() {}
+
+	/**
+	 * Registers a new benchmark case.
+	 */
+	void Microbenchmark::add(string kernel, BenchmarkParameters parameters, std::function<void(BenchmarkContext&)> body) {
+		this->m_cases.push_back({kernel, parameters, body});
+	}
+
+	/**
+	 * Returns the names of all the registered cases, in the form "kernel/parameters".
+	 */
+	vector<string> Microbenchmark::getCasesNames() {
+		vector<string> names;
+		for (BenchmarkCase& bench_case : this->m_cases) {
+			names.push_back(bench_case.kernel + "/" + Microbenchmark::formatParameters(bench_case.parameters));
+		}
+		return names;
+	}
+
+	/**
+	 * Private method.
+	 * Executes a single case: first it calibrates the number of iterations, then it executes the repetitions.
+	 */
+	BenchmarkResult Microbenchmark::runCase(BenchmarkCase& bench_case) {
+		const unsigned long long min_time_ns = (unsigned long long) (this->m_min_time_ms * 1e6);
+
+		// Calibration
+		unsigned long long iterations = 1;
+		for (int round = 0; round < MAX_CALIBRATION_ROUNDS; round++) {
+			BenchmarkContext context = BenchmarkContext(iterations);
+			bench_case.body(context);
+			context.pauseTiming();
+			unsigned long long elapsed = context.getElapsedNanoseconds();
+			if (elapsed >= min_time_ns) {
+				break;
+			}
+			// Estimate of the iterations needed, with a growth factor bounded between 2 and 10
+			double factor = (elapsed == 0) ? 10.0 : (1.4 * min_time_ns / elapsed);
+			factor = std::min(10.0, std::max(2.0, factor));
+			iterations = (unsigned long long) (iterations * factor);
+		}
+
+		// Repetitions
+		vector<BenchmarkResult> samples;
+		for (unsigned int rep = 0; rep < this->m_repetitions; rep++) {
+			BenchmarkContext context = BenchmarkContext(iterations);
+			bench_case.body(context);
+			context.pauseTiming();
+			samples.push_back({
+				bench_case.kernel,
+				Microbenchmark::formatParameters(bench_case.parameters),
+				iterations,
+				((double) context.getElapsedNanoseconds()) / iterations,
+				((double) context.getAllocations()) / iterations,
+				((double) context.getAllocatedBytes()) / iterations,
+			});
+		}
+		std::sort(samples.begin(), samples.end(), [](const BenchmarkResult& lhs, const BenchmarkResult& rhs) {
+			return lhs.ns_per_op < rhs.ns_per_op;
+		});
+		return samples[samples.size() / 2];
+	}
+
+	/**
+	 * Executes all the cases whose name ("kernel/parameters") contains the filter string.
+	 * Each result is printed on the output stream as soon as it's available.
+	 */
+	vector<BenchmarkResult> Microbenchmark::run(string filter, std::ostream& output) {
+		vector<BenchmarkResult> results;
+		Microbenchmark::printHeader(output);
+		for (BenchmarkCase& bench_case : this->m_cases) {
+			string name = bench_case.kernel + "/" + Microbenchmark::formatParameters(bench_case.parameters);
+			if (name.find(filter) == string::npos) {
+				continue;
+			}
+			std::cerr << "Running " << name << std::endl;
+			BenchmarkResult result = this->runCase(bench_case);
+			Microbenchmark::printResult(output, result);
+			results.push_back(result);
+		}
+		return results;
+	}
+
+	/**
+	 * Returns a string representation of the parameters, in the form "name=value;name=value".
+	 */
+	string Microbenchmark::formatParameters(const BenchmarkParameters& parameters) {
+		string result = "";
+		for (auto& param : parameters) {
+			if (!result.empty()) {
+				result += ";";
+			}
+			result += param.first + "=" + std::to_string(param.second);
+		}
+		return result;
+	}
+
+	/**
+	 * Prints the CSV header of the results.
+	 */
+	void Microbenchmark::printHeader(std::ostream& output) {
+		output << "kernel,parameters,iterations,ns_per_op,allocs_per_op,bytes_per_op" << std::endl;
+	}
+
+	/**
+	 * Prints a result as a CSV line.
+	 */
+	void Microbenchmark::printResult(std::ostream& output, const BenchmarkResult& result) {
+		char buffer[64];
+		output << result.kernel << "," << result.parameters << "," << result.iterations;
+		snprintf(buffer, sizeof(buffer), ",%.3f,%.3f,%.3f", result.ns_per_op, result.allocs_per_op, result.bytes_per_op);
+		output << buffer << std::endl;
+	}
+
+} /* namespace quicksc */
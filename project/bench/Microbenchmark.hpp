@@ -0,0 +1,121 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * Microbenchmark.hpp
+ *
+ *
+ * This header file contains the definition of a minimal harness for microbenchmarks.
+ * It is used to measure the core kernels of the library (the operations on states, extensions,
+ * singularities and automata) in isolation, outside the end-to-end execution of the "qsc" program.
+ *
+ * Each benchmark case is a kernel (a named operation) with a set of parameters (sizes, degrees, alphabet sizes).
+ * The harness calibrates the number of iterations of each case and reports, in CSV format:
+ * - the time per operation, in nanoseconds
+ * - the number of allocations per operation
+ * - the number of allocated bytes per operation
+ */
+
+#ifndef BENCH_MICROBENCHMARK_HPP_
+#define BENCH_MICROBENCHMARK_HPP_
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace quicksc {
+
+	using std::string;
+	using std::vector;
+	using std::pair;
+
+	/** Parameters of a benchmark case, as a list of couples (name, value). */
+	using BenchmarkParameters = vector<pair<string, unsigned long>>;
+
+	/**
+	 * Context of a single execution of a benchmark case.
+	 * The timing starts paused: the body of the case must resume it right before the measured loop,
+	 * and it can pause it again for setup or teardown operations that must not be measured.
+	 */
+	class BenchmarkContext {
+
+	private:
+		unsigned long long m_iterations;
+		bool m_running = false;
+		std::chrono::steady_clock::time_point m_start;
+		unsigned long long m_elapsed_ns = 0;
+		unsigned long long m_start_allocations = 0;
+		unsigned long long m_start_bytes = 0;
+		unsigned long long m_allocations = 0;
+		unsigned long long m_bytes = 0;
+
+	public:
+		BenchmarkContext(unsigned long long iterations);
+		~BenchmarkContext();
+
+		unsigned long long getIterations();
+		void resumeTiming();
+		void pauseTiming();
+		unsigned long long getElapsedNanoseconds();
+		unsigned long long getAllocations();
+		unsigned long long getAllocatedBytes();
+
+		/**
+		 * Marks the value as used, so that the compiler cannot remove the computations producing it.
+		 * The value is not copied nor stored: the empty assembly block only forces it into a register or in memory.
+		 */
+		template <typename T>
+		static inline void consume(const T& value) {
+			asm volatile("" : : "r,m"(value) : "memory");
+		}
+
+	};
+
+	/** Result of a benchmark case. */
+	struct BenchmarkResult {
+		string kernel;
+		string parameters;
+		unsigned long long iterations;
+		double ns_per_op;
+		double allocs_per_op;
+		double bytes_per_op;
+	};
+
+	/** Registry and runner of the benchmark cases. */
+	class Microbenchmark {
+
+	private:
+		struct BenchmarkCase {
+			string kernel;
+			BenchmarkParameters parameters;
+			std::function<void(BenchmarkContext&)> body;
+		};
+
+		vector<BenchmarkCase> m_cases;
+		double m_min_time_ms;
+		unsigned int m_repetitions;
+
+		BenchmarkResult runCase(BenchmarkCase& bench_case);
+
+	public:
+		Microbenchmark(double min_time_ms, unsigned int repetitions);
+		~Microbenchmark();
+
+		void add(string kernel, BenchmarkParameters parameters, std::function<void(BenchmarkContext&)> body);
+		vector<string> getCasesNames();
+		vector<BenchmarkResult> run(string filter, std::ostream& output);
+
+		static string formatParameters(const BenchmarkParameters& parameters);
+		static void printHeader(std::ostream& output);
+		static void printResult(std::ostream& output, const BenchmarkResult& result);
+
+	};
+
+	void registerKernels(Microbenchmark& bench);
+
+} /* namespace quicksc */
+
+#endif /* BENCH_MICROBENCHMARK_HPP_ */
@@ -12,6 +12,7 @@
 #define INCLUDE_ALPHABETGENERATOR_HPP_
 
 #include "Alphabet.hpp"
+#include "SymbolTable.hpp"
 
 namespace quicksc {
 
@@ -33,6 +34,7 @@ namespace quicksc {
 		const char* getLetters();
 		unsigned int getCardinality();
 
+		SymbolTable generateSymbols();
 		Alphabet generate();
 
 	};
@@ -0,0 +1,76 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AntichainChecker.hpp
+ *
+ *
+ * This header file contains the definition of the AntichainChecker class, which checks the universality of an NFA
+ * and the inclusion between the languages of two NFAs, without determinizing them.
+ *
+ * Both the checks explore the subsets of states of the Subset Construction (epsilon-closed extensions), on the fly,
+ * looking for a rejecting one: a subset without final states (universality), or a state of the first NFA paired
+ * with such a subset of the second one (inclusion). The exploration is breadth-first, so the first rejecting subset
+ * found gives a shortest counterexample, and the check stops there.
+ *
+ * The subsets are pruned with antichains: if a subset S is reached and a subset S' ⊆ S has already been reached
+ * (paired with the same state, for the inclusion), then S can be discarded, since every word rejected from S is rejected
+ * from S' too. Hence, only the subsets that are minimal with respect to the inclusion are explored, which are
+ * usually far fewer than the states of the DFA.
+ * A subset already waiting in the queue is discarded only if the smaller subset has been reached with a path of the same
+ * length: discarding it in favour of a deeper subset could make the counterexample longer.
+ */
+
+#ifndef INCLUDE_ANTICHAINCHECKER_HPP_
+#define INCLUDE_ANTICHAINCHECKER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "Alphabet.hpp"
+#include "Automaton.hpp"
+#include "State.hpp"
+
+namespace quicksc {
+
+	class AntichainChecker {
+
+	private:
+		/**
+		 * Node of the exploration: a state of the first NFA (NULL for the universality) and a subset of the second one.
+		 */
+		struct AntichainNode {
+			State* state;
+			Extension subset;
+			long parent;			// Index of the node from which this node has been reached (-1 for the initial nodes)
+			unsigned long depth;	// Length of the path from the initial node
+			std::string label;		// Label of the transition from the parent
+			bool subsumed;			// True if a smaller subset, paired with the same state, has been reached at the same depth
+		};
+
+		std::vector<AntichainNode> m_nodes;
+		unsigned long m_pruned_count;
+
+		static Extension computeLClosure(const Extension& subset, const std::string& label);
+		static bool isSubset(const Extension& smaller, const Extension& larger);
+
+		bool insertIntoAntichain(std::vector<unsigned long>& antichain, AntichainNode node);
+		void buildCounterexample(unsigned long node_index, std::vector<std::string>* counterexample);
+
+	public:
+		AntichainChecker();
+		~AntichainChecker();
+
+		bool isUniversal(Automaton* nfa, std::vector<std::string>* counterexample = NULL);
+		bool isUniversal(Automaton* nfa, const Alphabet& alphabet, std::vector<std::string>* counterexample = NULL);
+		bool isIncluded(Automaton* included, Automaton* including, std::vector<std::string>* counterexample = NULL);
+		bool isEquivalent(Automaton* first, Automaton* second, std::vector<std::string>* counterexample = NULL);
+
+		unsigned long getExploredCount();
+		unsigned long getPrunedCount();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_ANTICHAINCHECKER_HPP_ */
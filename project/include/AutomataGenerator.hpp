@@ -22,8 +22,10 @@
 #include "Alphabet.hpp"
 #include "Automaton.hpp"
 #include "Configurations.hpp"
+#include "SymbolTable.hpp"
 
 #define UNDEFINED_VALUE -1
+#define DFA_SIZE_UNKNOWN 0
 
 namespace quicksc {
 
@@ -33,7 +35,12 @@ namespace quicksc {
 		AUTOMATON_STRATIFIED_WITH_SAFE_ZONE,
 		AUTOMATON_ACYCLIC,
 		AUTOMATON_WEAK,
-		AUTOMATON_MASLOV
+		AUTOMATON_MASLOV,
+		AUTOMATON_NTH_FROM_END,
+		AUTOMATON_KEYWORDS,
+		AUTOMATON_DFA_UNION,
+		AUTOMATON_POWER_LAW,
+		AUTOMATON_PROTOCOL
 	} AutomatonType;
 
 	class AutomataGenerator {
@@ -48,6 +55,7 @@ namespace quicksc {
 		double m_final_probability;
 		double m_max_distance = UNDEFINED_VALUE;
 		double m_safe_zone_distance = UNDEFINED_VALUE;
+		unsigned int m_components;
 
 		unsigned int m_namesCounter = 0;
 
@@ -55,20 +63,25 @@ namespace quicksc {
 		static const char* default_name_prefix;
 		
 		Configurations* m_configurations;
+		SymbolSampler m_symbol_sampler;		// Frequency distribution of the labels drawn freely from the alphabet
+		unsigned long int m_dfa_size_bound = DFA_SIZE_UNKNOWN;	// Upper bound of the size of the DFA of the last generated automaton
 
 		void resetNames();
 		string generateUniqueName();
 		double generateNormalizedDouble();
+		unsigned int getRandomSymbolIndex();
 		string getRandomLabelFromAlphabet();
 		unsigned long int computeDeterministicTransitionsNumber();
+		static unsigned long int saturatedPowerOfTwo(unsigned long int exponent);
 
 	public:
 		AutomataGenerator(Alphabet alphabet, Configurations* configurations);
 		virtual ~AutomataGenerator();
 
-		Alphabet getAlphabet();
+		const Alphabet& getAlphabet();
 		AutomatonType getAutomatonStructure();
 		unsigned long int getSize();
+		void setSize(unsigned long int size);
 		string getNamePrefix();
 		double getTransitionPercentage();
 		double getEpsilonProbability();
@@ -76,6 +89,8 @@ namespace quicksc {
 		unsigned int getMaxDistance();
 		void setMaxDistance(unsigned int max_distance);
 		unsigned int getSafeZoneDistance();
+		unsigned int getComponents();
+		unsigned long int getDFASizeBound();
 
 		Automaton* generateAutomaton();
 		virtual Automaton* generateRandomAutomaton();
@@ -84,6 +99,11 @@ namespace quicksc {
 		virtual Automaton* generateAcyclicAutomaton();
 		virtual Automaton* generateWeakAutomaton();
 		virtual Automaton* generateMaslovAutomaton();
+		virtual Automaton* generateNthFromEndAutomaton();
+		virtual Automaton* generateKeywordsAutomaton();
+		virtual Automaton* generateDFAUnionAutomaton();
+		virtual Automaton* generatePowerLawAutomaton();
+		virtual Automaton* generateProtocolAutomaton();
 
 	};
 
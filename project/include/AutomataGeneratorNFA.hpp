@@ -11,6 +11,14 @@
  * The NFA is generated with random values; that means that every call returns a different NFA.
  * 
  * The NFA will be used to test the determinization algorithms.
+ *
+ * Besides the basic structures, the generator offers some families modeled on real workloads:
+ * - "n-th symbol from the end" automata, a generalization of the Maslov automata over the whole alphabet;
+ * - keyword-dictionary automata, i.e. a trie of random keywords with a self-loop on every symbol in the root;
+ * - unions of k random DFAs, joined in a single initial state;
+ * - automata whose states have a power-law degree distribution (a few hubs, many states with few transitions);
+ * - protocol-like automata, i.e. cycles of phases connected by handshake symbols, with retry transitions inside each phase.
+ * For each family, the generator computes an upper bound of the DFA size (see AutomataGenerator::getDFASizeBound).
  */
 
 #ifndef INCLUDE_AUTOMATAGENERATORNFA_HPP_
@@ -24,6 +32,8 @@ namespace quicksc {
 
 	private:
 		void generateStates(Automaton* nfa);
+		State* createState(Automaton* nfa, bool final);
+		vector<unsigned long int> splitSize(unsigned long int size, unsigned int parts);
 		State* getRandomState(Automaton* nfa);
 		State* getRandomState(vector<State*>& states);
 		State* getRandomStateWithUnusedLabels(vector<State*>& states, map<State*, Alphabet>& unused_labels);
@@ -41,6 +51,11 @@ namespace quicksc {
 		Automaton* generateAcyclicAutomaton();						// Done
 		Automaton* generateWeakAutomaton();							// Done
 		Automaton* generateMaslovAutomaton();						// Done
+		Automaton* generateNthFromEndAutomaton();
+		Automaton* generateKeywordsAutomaton();
+		Automaton* generateDFAUnionAutomaton();
+		Automaton* generatePowerLawAutomaton();
+		Automaton* generateProtocolAutomaton();
 	};
 
 } /* namespace quicksc */
@@ -0,0 +1,95 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AutomataSerializer.hpp
+ *
+ *
+ * This module converts an automaton to a compact binary form and back.
+ * It's used to move automata between processes (e.g. from an isolated run to the main process) and to store them in files.
+ *
+ * The binary form is composed by:
+ * - a magic number and the version of the format;
+ * - the table of the labels, where each label is written as a length-prefixed string;
+ * - the list of the states, each one with its name and its final flag;
+ * - the index of the initial state;
+ * - the number of transitions, followed by the transitions as triples (origin index, label index, destination index).
+ * All the numbers are written in the native byte order, since the data is meant to be read on the same machine.
+ */
+
+#ifndef INCLUDE_AUTOMATASERIALIZER_HPP_
+#define INCLUDE_AUTOMATASERIALIZER_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "Automaton.hpp"
+
+namespace quicksc {
+
+	#define AUTOMATON_MAGIC_NUMBER 		0x51534341		// "QSCA"
+	#define AUTOMATON_FORMAT_VERSION 	1
+	#define NO_INITIAL_STATE 			0xFFFFFFFF
+
+	/**
+	 * Utility class that appends values in binary form to a buffer.
+	 */
+	class BinaryWriter {
+
+	private:
+		string m_buffer;
+
+	public:
+		BinaryWriter();
+		~BinaryWriter();
+
+		void writeUInt32(uint32_t value);
+		void writeUInt64(uint64_t value);
+		void writeDouble(double value);
+		void writeString(const string& value);
+		void writeBytes(const string& bytes);
+		const string& getBuffer();
+		void clear();
+
+	};
+
+	/**
+	 * Utility class that reads values in binary form from a buffer.
+	 * Reading over the end of the buffer throws an exception.
+	 */
+	class BinaryReader {
+
+	private:
+		const string& m_buffer;
+		size_t m_position;
+
+		void checkAvailable(size_t length);
+
+	public:
+		BinaryReader(const string& buffer);
+		~BinaryReader();
+
+		uint32_t readUInt32();
+		uint64_t readUInt64();
+		double readDouble();
+		string readString();
+		bool hasMore();
+
+	};
+
+	class AutomataSerializer {
+
+	public:
+		static string toBinary(Automaton* automaton);
+		static Automaton* fromBinary(const string& bytes);
+		static void writeAutomaton(BinaryWriter& writer, Automaton* automaton);
+		static Automaton* readAutomaton(BinaryReader& reader);
+
+		static bool saveToFile(Automaton* automaton, string file_name);
+		static Automaton* loadFromFile(string file_name);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_AUTOMATASERIALIZER_HPP_ */
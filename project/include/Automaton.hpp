@@ -14,6 +14,7 @@
 #ifndef INCLUDE_AUTOMATON_H_
 #define INCLUDE_AUTOMATON_H_
 
+#include <functional>
 #include <vector>
 #include <list>
 
@@ -58,6 +59,8 @@ namespace quicksc {
         bool connectStates(State *from, State *to, string label);
         bool connectStates(string from, string to, string label);
         Automaton* clone();
+        Automaton* quotient(const map<State*, unsigned long>& blocks, unsigned long blocks_count, std::function<vector<string>(const string&)> relabeling);
+        Automaton* relabel(std::function<vector<string>(const string&)> relabeling);
         void recomputeAllDistances();
 
         bool operator==(Automaton& other);
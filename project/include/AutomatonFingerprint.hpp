@@ -0,0 +1,79 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AutomatonFingerprint.hpp
+ *
+ *
+ * This module computes a fingerprint of an automaton that doesn't depend on the names of its states, nor on the order
+ * in which they have been inserted: two automata differing only for these aspects have the same fingerprint.
+ *
+ * The fingerprint is computed by color refinement (the Weisfeiler-Leman method): each state starts with a color given by
+ * its final and initial flags; at each round, the color of a state is combined with the multisets of the pairs (label, color)
+ * of its children and of its parents. The refinement stops when the number of colors doesn't grow anymore, and the fingerprint
+ * is the hash of the multiset of the final colors.
+ *
+ * Since different automata can have the same fingerprint, the module computes also a canonical form of the automaton,
+ * to be compared exactly: the states are numbered in the order of their colors, when all the colors are different.
+ * Otherwise, the colors don't distinguish some states (e.g. because of a symmetry of the automaton): a search tree is explored
+ * by individualization and refinement. At each node, the smallest class of states with the same color is chosen, and each one
+ * of its states is given a new color in turn, refining the colors again; the leaves are the numberings with all different colors.
+ * The canonical form is the smallest one among the leaves, and it doesn't depend on the names of the states.
+ * The subtrees equivalent to an already explored one, according to the automorphisms found when two leaves have the same form,
+ * are skipped. The search stops after FINGERPRINT_MAX_LEAVES leaves: beyond that, the canonical form of two equal automata can
+ * differ (and the lookup of a cache misses); two different automata never have the same canonical form.
+ */
+
+#ifndef INCLUDE_AUTOMATONFINGERPRINT_HPP_
+#define INCLUDE_AUTOMATONFINGERPRINT_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Automaton.hpp"
+
+#define FINGERPRINT_MAX_LEAVES		1024		// Maximum number of leaves explored by the search of the canonical form
+
+namespace quicksc {
+
+	class AutomatonFingerprint {
+
+	private:
+		uint64_t m_fingerprint;
+		unsigned int m_rounds;
+		std::vector<State*> m_states;
+		std::map<State*, uint32_t> m_state_indices;
+		std::vector<std::vector<std::pair<uint64_t, uint32_t>>> m_neighbours;	// Pairs (hash of the label and of the direction, state index)
+		std::vector<State*> m_canonical_states;				// States in canonical order
+		std::map<State*, uint32_t> m_canonical_indices;
+		std::string m_canonical_form;
+		std::vector<uint32_t> m_canonical_order;			// Index of each state of the canonical order, in the vector of the states
+		std::vector<std::vector<uint32_t>> m_automorphisms;
+		unsigned long m_leaves_count;
+
+		unsigned int refineColors(std::vector<uint64_t>& colors);
+		void searchCanonicalForm(Automaton* automaton, std::vector<uint64_t>& colors, std::vector<uint32_t>& individualized);
+		std::string writeCanonicalForm(Automaton* automaton, const std::vector<uint32_t>& order);
+
+	public:
+		AutomatonFingerprint(Automaton* automaton);
+		~AutomatonFingerprint();
+
+		uint64_t getFingerprint();
+		std::string getFingerprintString();
+		unsigned int getRefinementRounds();
+		unsigned long getLeavesCount();
+		const std::string& getCanonicalForm();
+		const std::vector<State*>& getCanonicalStates();
+		uint32_t getCanonicalIndex(State* state);
+
+		static uint64_t hashString(const std::string& value);
+		static uint64_t combine(uint64_t seed, uint64_t value);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_AUTOMATONFINGERPRINT_HPP_ */
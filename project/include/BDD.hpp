@@ -0,0 +1,115 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BDD.hpp
+ *
+ *
+ * This header file contains the definition of the BDDManager class, a minimal package of Reduced Ordered Binary Decision Diagrams.
+ *
+ * A BDD represents a boolean function over a set of ordered variables, as a directed acyclic graph where every node
+ * tests a variable and has two children (for the values false and true of the variable). The diagrams are:
+ * - ordered: the variables are tested in increasing order along every path;
+ * - reduced: no node has two equal children, and no two nodes have the same variable and the same children.
+ * With these rules, every function has a unique diagram: the nodes are "hash-consed" in a unique table,
+ * so two functions are equal if and only if they're the same node, and the comparison is a comparison of integers.
+ *
+ * The nodes are identified by integer indexes in a vector owned by the manager; the indexes 0 and 1 are the constant
+ * functions false and true. The results of the recursive operations are memoized in an operation cache, a direct-mapped
+ * table where a new result simply overwrites the old one with the same position: a miss only costs a recomputation.
+ * The cache grows together with the unique table, so that a small computation doesn't pay for a large cache.
+ * The nodes are never freed: a manager is meant to live as long as a single computation (e.g. a determinization).
+ *
+ * In this project, BDDs are used to represent sets of states: every state is numbered, and a set is the characteristic
+ * function of the binary encodings of the numbers of its states. Sets with regular structure share most of their nodes.
+ */
+
+#ifndef INCLUDE_BDD_HPP_
+#define INCLUDE_BDD_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#define BDD_FALSE				0
+#define BDD_TRUE				1
+#define BDD_TERMINAL_VARIABLE	0xFFFFFFFF		// Variable of the terminal nodes, greater than any other variable
+#define BDD_CACHE_INITIAL_BITS	12				// The operation cache starts with 2^BDD_CACHE_INITIAL_BITS entries
+#define BDD_CACHE_BITS			18				// The operation cache grows up to 2^BDD_CACHE_BITS entries
+#define BDD_UNIQUE_INITIAL_BITS	12				// The unique table starts with 2^BDD_UNIQUE_INITIAL_BITS buckets
+
+namespace quicksc {
+
+	/** Node of a BDD, identified by its index in the manager */
+	using BDD = uint32_t;
+
+	class BDDManager {
+
+	private:
+		/**
+		 * Operations memoized in the cache.
+		 */
+		typedef enum {
+			BDD_OP_NONE,
+			BDD_OP_AND,
+			BDD_OP_OR,
+			BDD_OP_AND_EXISTS,
+			BDD_OP_RENAME,
+		} BDDOperation;
+
+		struct BDDNodeData {
+			uint32_t variable;
+			BDD low;		// Child for the value false of the variable
+			BDD high;		// Child for the value true of the variable
+		};
+
+		struct BDDCacheEntry {
+			BDDOperation operation;
+			BDD first;
+			BDD second;
+			BDD third;
+			BDD result;
+		};
+
+		std::vector<BDDNodeData> m_nodes;
+		std::vector<BDD> m_unique_table;			// Open addressing table of the nodes (BDD_FALSE marks an empty bucket)
+		std::vector<BDDCacheEntry> m_cache;
+		std::vector<uint32_t> m_renaming;			// New variable of each variable, for the "rename" operation
+		unsigned long long m_cache_lookups;
+		unsigned long long m_cache_hits;
+
+		static uint64_t hash(uint64_t a, uint64_t b, uint64_t c);
+		void growUniqueTable();
+		void growCache();
+		bool lookupCache(BDDOperation operation, BDD first, BDD second, BDD third, BDD& result);
+		void storeCache(BDDOperation operation, BDD first, BDD second, BDD third, BDD result);
+
+	public:
+		BDDManager();
+		~BDDManager();
+
+		BDD makeNode(uint32_t variable, BDD low, BDD high);
+		uint32_t getVariable(BDD node);
+		BDD getLow(BDD node);
+		BDD getHigh(BDD node);
+
+		BDD variable(uint32_t variable);
+		BDD cube(const std::vector<uint32_t>& variables);
+		BDD minterm(const std::vector<uint32_t>& variables, uint64_t value);
+
+		BDD bddAnd(BDD first, BDD second);
+		BDD bddOr(BDD first, BDD second);
+		BDD andExists(BDD first, BDD second, BDD cube);
+		void setRenaming(const std::vector<uint32_t>& renaming);
+		BDD rename(BDD node);
+
+		void enumerate(BDD node, const std::vector<uint32_t>& variables, std::vector<uint64_t>& values);
+
+		unsigned long getNodesCount();
+		unsigned long long getCacheLookups();
+		unsigned long long getCacheHits();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_BDD_HPP_ */
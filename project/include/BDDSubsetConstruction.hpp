@@ -0,0 +1,52 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BDDSubsetConstruction.hpp
+ *
+ *
+ * This header file contains the definition of the BDDSubsetConstruction class, a variant of the Subset Construction
+ * where the extensions of the DFA states are represented symbolically, as BDDs.
+ *
+ * The states of the NFA are numbered and encoded with b bits; an extension is the BDD of the set of the codes of its states,
+ * over the variables x_0 ... x_(b-1). For each label, the transitions of the NFA (towards the epsilon-closures of the children)
+ * are a relation T_l(x, x') over the variables x and x' = x'_0 ... x'_(b-1), interleaved in the order.
+ * The l-closure of an extension S is then computed with a single relational product:
+ *
+ * 		S_l(x) = (∃x . S(x) ∧ T_l(x, x'))[x' → x]
+ *
+ * Since the BDDs are canonical, two extensions are equal if and only if they are the same node: the lookup of a state
+ * in the DFA is a lookup of an integer, instead of a comparison of sets (or of names built from them).
+ * The states of the DFA are created only at the end, from the extensions enumerated out of the BDDs: they're named as the
+ * ConstructedStates of the canonical Subset Construction, so that the result is the same automaton, but the extensions are
+ * not kept in memory as sets of states.
+ */
+
+#ifndef INCLUDE_BDDSUBSETCONSTRUCTION_HPP_
+#define INCLUDE_BDDSUBSETCONSTRUCTION_HPP_
+
+#include "Automaton.hpp"
+#include "DeterminizationAlgorithm.hpp"
+
+// Runtime Statistics
+#define BDD_NODES						"BDD_NODES      [#] "
+#define BDD_CACHE_HIT_RATE				"BDD_CACHE_HIT  [%] "
+
+namespace quicksc {
+
+	class BDDSubsetConstruction : public DeterminizationAlgorithm {
+
+	public:
+		BDDSubsetConstruction();
+		~BDDSubsetConstruction();
+
+		void resetRuntimeStatsValues();
+		vector<RuntimeStat> getRuntimeStatsList();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_BDDSUBSETCONSTRUCTION_HPP_ */
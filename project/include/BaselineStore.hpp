@@ -0,0 +1,60 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BaselineStore.hpp
+ *
+ *
+ * This module manages the baselines of the tests, i.e. named archives of aggregated statistics.
+ * A baseline is saved in a CSV file of the results folder, where each line contains the aggregated values of a statistic
+ * for a specific configuration (identified by the values of the test parameters).
+ *
+ * When the statistics of a new run are compared with a baseline, the deltas of the averages are printed with a flag
+ * of significance; a cost statistic (time or memory) whose average grows significantly over the configured threshold
+ * is considered a regression.
+ *
+ * The test case is run several times ("#regruns" setting, default 3): the baseline keeps, for each statistic, the run
+ * with the median average, and a regression is reported only if it appears in all the runs compared with it.
+ *
+ * Noise floor: in back-to-back runs of the same binary, the average times of a few milliseconds vary by up to 30-60%
+ * in a single run (with z-scores up to 10), while the memory statistics vary by less than 2%; hence the default
+ * threshold is 25%, and smaller regressions require longer test cases (more testcases, bigger automata).
+ */
+
+#ifndef INCLUDE_BASELINESTORE_HPP_
+#define INCLUDE_BASELINESTORE_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Configurations.hpp"
+#include "ResultCollector.hpp"
+
+namespace quicksc {
+
+	class BaselineStore {
+
+	private:
+		string m_name;
+		string m_file_name;
+		unsigned int m_regressions_count = 0;
+
+		map<string, map<string, AggregatedStat>> loadEntries();
+
+	public:
+		BaselineStore(string name);
+		~BaselineStore();
+
+		static string getConfigurationKey(Configurations* configurations);
+
+		void clear();
+		void save(Configurations* configurations, const vector<vector<AggregatedStat>>& runs);
+		bool compare(Configurations* configurations, const vector<vector<AggregatedStat>>& runs);
+		unsigned int getRegressionsCount();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_BASELINESTORE_HPP_ */
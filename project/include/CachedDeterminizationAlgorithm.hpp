@@ -0,0 +1,77 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * CachedDeterminizationAlgorithm.hpp
+ *
+ *
+ * This header file contains the declaration of the class CachedDeterminizationAlgorithm.
+ * This class is a generic subclass of DeterminizationAlgorithm, which keeps the DFAs computed by another instance of
+ * DeterminizationAlgorithm in a persistent cache on the disk, so that an NFA already determinized (in this or in a previous
+ * execution) is not determinized again.
+ *
+ * Each entry of the cache is a file in binary form, whose name is given by the fingerprint of the NFA (see AutomatonFingerprint)
+ * and by the abbreviation of the inner algorithm. The entry contains the canonical form of the NFA, which is compared
+ * with the one of the NFA to be determinized: hence, a collision of the fingerprints causes a miss, never a wrong result.
+ * The names of the states of the DFA are saved with reference to the canonical order of the states of the NFA, so that
+ * the DFA loaded from the cache has the names it would have if it were computed on the NFA actually received.
+ *
+ * The cache is consulted at every execution; in case of a miss, the inner algorithm is run and its DFA is saved.
+ * The runtime statistics report whether the execution was a hit (their average is the hit rate) and the time of the lookup.
+ */
+
+#ifndef INCLUDE_CACHEDDETERMINIZATIONALGORITHM_HPP_
+#define INCLUDE_CACHEDDETERMINIZATIONALGORITHM_HPP_
+
+#include <string>
+
+#include "Automaton.hpp"
+#include "AutomatonFingerprint.hpp"
+#include "DeterminizationAlgorithm.hpp"
+#include "Properties.hpp"
+
+// Runtime Statistics
+#define CACHE_HIT_RATE						"HIT_RATE       [%] "
+#define CACHE_LOOKUP_TIME					"LOOKUP_TIME    [ms]"
+#define CACHE_STORE_TIME					"STORE_TIME     [ms]"
+#define CACHED_DETERMINIZATION_TIME			"DET_TIME       [ms]"
+
+#define CACHE_ABBR_PREFIX					"ca+"
+
+#define CACHE_ENTRY_MAGIC_NUMBER			0x51534345		// "QSCE"
+#define CACHE_ENTRY_FORMAT_VERSION			1
+#define CACHE_NAME_RAW						0				// Name of a DFA state saved as it is
+#define CACHE_NAME_EXTENSION				1				// Name of a DFA state saved as the canonical indices of its NFA states
+
+namespace quicksc {
+
+	class CachedDeterminizationAlgorithm : public DeterminizationAlgorithm {
+
+	private:
+		DeterminizationAlgorithm* m_determinization_algorithm;
+		std::string m_cache_directory;
+		unsigned long m_lookups_count;
+		unsigned long m_hits_count;
+
+		std::string getEntryFileName(AutomatonFingerprint& fingerprint);
+		Automaton* loadEntry(const std::string& file_name, AutomatonFingerprint& fingerprint);
+		void storeEntry(const std::string& file_name, AutomatonFingerprint& fingerprint, Automaton* dfa);
+
+	public:
+		CachedDeterminizationAlgorithm(DeterminizationAlgorithm* determinization_algorithm, std::string cache_directory = DIR_CACHE);
+		~CachedDeterminizationAlgorithm();
+
+		void resetRuntimeStatsValues();
+		vector<RuntimeStat> getRuntimeStatsList();
+		map<RuntimeStat, double> getRuntimeStatsValues();
+
+		unsigned long getLookupsCount();
+		unsigned long getHitsCount();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_CACHEDDETERMINIZATIONALGORITHM_HPP_ */
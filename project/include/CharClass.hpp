@@ -0,0 +1,75 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * CharClass.hpp
+ *
+ *
+ * This header file contains the definition of the CharClass class, a predicate over characters represented as
+ * a set of disjoint intervals of code points (e.g. [a-z0-9]).
+ *
+ * A class can be used as the label of a transition, written in its textual form:
+ *
+ * 		"[" ( atom | atom "-" atom )* "]"
+ *
+ * where an atom is an ASCII letter or digit, or any code point written as "\x{HEX}". The textual form produced by
+ * the class is canonical (sorted and merged intervals), so two equal classes always produce the same label.
+ * This way, a single transition labeled with a class replaces a transition for each one of its characters,
+ * without changing the representation of the labels in the rest of the project.
+ *
+ * Given a set of classes, their minterms are the non-empty classes obtained by intersecting, for each class, either the class
+ * or its complement: they're disjoint, and every class is the union of some of them. Hence, an automaton whose labels are
+ * overlapping classes can be rewritten with minterms as labels, where two different labels never share a character.
+ */
+
+#ifndef INCLUDE_CHARCLASS_HPP_
+#define INCLUDE_CHARCLASS_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define CHAR_CLASS_MAX_CODE_POINT	0x10FFFF	// Largest Unicode code point
+#define CHAR_CLASS_OPEN				'['
+#define CHAR_CLASS_CLOSE			']'
+
+namespace quicksc {
+
+	class CharClass {
+
+	private:
+		std::vector<std::pair<uint32_t, uint32_t>> m_intervals;		// Closed intervals, sorted, disjoint and not adjacent
+
+		static void appendAtom(std::string& label, uint32_t code_point);
+		static uint32_t parseAtom(const std::string& label, unsigned long& position);
+
+	public:
+		CharClass();
+		CharClass(uint32_t first, uint32_t last);
+		~CharClass();
+
+		static bool isClassLabel(const std::string& label);
+		static CharClass fromLabel(const std::string& label);
+		static std::vector<CharClass> computeMinterms(const std::vector<CharClass>& classes, std::vector<std::vector<unsigned long>>& decompositions);
+		std::string toLabel() const;
+
+		void add(uint32_t first, uint32_t last);
+		CharClass unite(const CharClass& other) const;
+		CharClass intersect(const CharClass& other) const;
+		CharClass subtract(const CharClass& other) const;
+		CharClass complement() const;
+
+		bool isEmpty() const;
+		bool contains(uint32_t code_point) const;
+		uint64_t getCharsCount() const;
+		const std::vector<std::pair<uint32_t, uint32_t>>& getIntervalsRef() const;
+
+		bool operator==(const CharClass& other) const;
+		bool operator<(const CharClass& other) const;
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_CHARCLASS_HPP_ */
@@ -34,11 +34,31 @@ namespace quicksc {
 		AutomatonTransitionsPercentage,
 		AutomatonMaxDistance,
 		AutomatonSafeZoneDistance,
+		AlphabetZipfExponent,
+		AutomatonComponents,
+		PerturbationCount,
+		PerturbationDepth,
+		StreamingGeneration,
 
 		ActiveAutomatonPruning,
 		ActiveRemovingLabel,
 		ActiveDistanceCheckInTranslation,
 
+		ScalingMode,
+		ScalingParameter,
+		ScalingFactor,
+		ScalingTimeBudget,
+		ScalingMaxPoints,
+
+		BaselineThreshold,
+		BaselineRuns,
+
+		IsolationMode,
+		IsolationShipSolution,
+
+		GenerationThreads,
+		GenerationQueueDepth,
+
 		PrintStatistics,
 		LogStatistics,
 		LogStatisticsMin,
@@ -48,6 +68,7 @@ namespace quicksc {
 
 		PrintOriginalAutomaton,
 		PrintSolutionAutomaton,
+		PrintPhases,
 		DrawOriginalAutomaton,
 		DrawSolutionAutomaton,
 
@@ -156,6 +177,7 @@ namespace quicksc {
 
 		int m_session_index;		// Configuration session index
 		vector<map<SettingID, SettingValue*>> m_settings_instances;		// Values of each setting, for each session
+		map<SettingID, SettingValue*> m_overridden_values;				// Original values of the settings overridden in the current session
 
 		static const Setting& getSetting(const SettingID& id);
 
@@ -187,12 +209,16 @@ namespace quicksc {
 
 		static string nameOf(const SettingID& id);
 		static string abbreviationOf(const SettingID& id);
+		static SettingID idOf(const string& name);
 		static bool isTestParam(const SettingID& id);
 		string getValueString();
 		string toString();
 		string toString(const SettingID& id);
 		bool nextTestCase();
 
+		void overrideValue(const SettingID& id, double value);
+		void restoreValue(const SettingID& id);
+
 		template <class T> T valueOf(const SettingID& id);
 
 	};
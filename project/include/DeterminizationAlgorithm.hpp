@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "Automaton.hpp"
+#include "OperationCounters.hpp"
 #include "Statistics.hpp"
 
 namespace quicksc {
@@ -30,9 +31,11 @@ namespace quicksc {
         string m_abbr;
 
 		map<RuntimeStat, double> m_runtime_stats_values;
+		OperationCounts m_operations_start;			// Reading of the operation counters at the start of the execution
 
 	protected:
 		map<RuntimeStat, double>& getRuntimeStatsValuesRef();
+		void collectOperationCounts();
 
 	public:
         DeterminizationAlgorithm(string abbr, string name);
@@ -41,6 +44,7 @@ namespace quicksc {
         const string& abbr();
         const string& name();
 
+		virtual bool hasComparableSolutions();
 		virtual void resetRuntimeStatsValues();
 		virtual vector<RuntimeStat> getRuntimeStatsList();
 		virtual map<RuntimeStat, double> getRuntimeStatsValues();
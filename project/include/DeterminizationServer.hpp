@@ -0,0 +1,125 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationServer.hpp
+ *
+ *
+ * This module implements a long-lived server that determinizes the NFAs sent by other processes on the same machine,
+ * and the client used to send them.
+ *
+ * The server listens on a UNIX domain socket. The requests are served by a pool of worker threads, created at the start:
+ * each worker keeps its own instances of the determinization algorithms, created at the first request that uses them
+ * and reused for all the following ones (up to SERVER_MAX_ALGORITHMS, then the least recently used is deleted). Hence, the configurations
+ * are parsed once, and the process, the threads and the internal structures of the algorithms stay alive between the requests.
+ * A connection is persistent: a client can send any number of requests on it, which are served in order. However, a worker
+ * serves a single request at a time: then the connection goes back to the acceptor thread, which waits for its next request
+ * together with the new connections. Hence, an idle client does not keep a worker busy. The connections with a request
+ * to be served wait in a queue, while all the workers are busy.
+ * A client that stops in the middle of a request for more than SERVER_RECEIVE_TIMEOUT_MS is disconnected.
+ *
+ * Every message is framed as its length (an unsigned integer of 32 bits) followed by its content, written with the
+ * binary form of the AutomataSerializer:
+ * - request: the type of the request; for a determinization, the abbreviation of the algorithm (empty for the default one)
+ *   and the NFA in binary form.
+ * - response: the status; if OK, the DFA in binary form followed by the number of the runtime statistics and the pairs
+ *   (name, value); otherwise, the message of the error.
+ * The abbreviations of the algorithms are the ones printed in the results, e.g. "qsc", "esc", "ger+sc", "ac+qsc", "fbr+mt+sc" or "ca+qsc".
+ */
+
+#ifndef INCLUDE_DETERMINIZATIONSERVER_HPP_
+#define INCLUDE_DETERMINIZATIONSERVER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AutomataSerializer.hpp"
+#include "Automaton.hpp"
+#include "Configurations.hpp"
+#include "DeterminizationAlgorithm.hpp"
+
+// Types of the requests
+#define SERVER_REQUEST_DETERMINIZATION		1
+#define SERVER_REQUEST_SHUTDOWN				2
+
+// Status of the responses
+#define SERVER_STATUS_OK					0
+#define SERVER_STATUS_ERROR					1
+
+#define SERVER_MAX_MESSAGE_SIZE				0x40000000		// 1 GiB, longer messages are considered corrupted
+#define SERVER_RECEIVE_TIMEOUT_MS			5000			// Maximum wait for the rest of a message, once started
+#define SERVER_MAX_ALGORITHMS				16				// Maximum number of algorithms kept by a worker
+
+// Runtime Statistics added by the server to the ones of the algorithm
+#define SERVER_RUN_TIME						"SRV_RUN_TIME   [ms]"
+
+namespace quicksc {
+
+	class DeterminizationServer {
+
+	private:
+		Configurations* m_config_reference;
+		std::string m_socket_path;
+		std::string m_default_algorithm;
+		int m_listen_fd;
+
+		std::thread m_acceptor;
+		std::vector<std::thread> m_workers;
+		std::vector<std::list<std::pair<std::string, DeterminizationAlgorithm*>>> m_algorithms;	// Algorithms kept by each worker, from the most recently used
+		std::deque<int> m_pending_connections;		// Connections with a request to be served
+		std::set<int> m_active_connections;			// Connections whose request is being served
+		std::set<int> m_idle_connections;			// Connections waiting for a request, watched by the acceptor
+		int m_wakeup_fds[2];						// Pipe used to wake up the acceptor when the idle connections change
+		std::mutex m_mutex;
+		std::condition_variable m_pending;
+		bool m_started;
+		bool m_stopped;
+		unsigned long m_requests_count;
+
+		void accept();
+		void work(unsigned int worker);
+		bool serve(unsigned int worker, int connection_fd, bool& shutdown_requested);
+		void wakeUpAcceptor();
+		std::string determinize(unsigned int worker, BinaryReader& reader);
+
+	public:
+		DeterminizationServer(Configurations* configurations, std::string socket_path, std::string default_algorithm, unsigned int workers);
+		~DeterminizationServer();
+
+		void start();
+		void stop();
+		void wait();
+
+		unsigned long getRequestsCount();
+
+		static DeterminizationAlgorithm* createAlgorithm(const std::string& abbr, Configurations* configurations);
+		static void sendMessage(int fd, const std::string& message);
+		static bool receiveMessage(int fd, std::string& message);
+
+	};
+
+	class DeterminizationClient {
+
+	private:
+		int m_fd;
+
+	public:
+		DeterminizationClient(std::string socket_path);
+		~DeterminizationClient();
+
+		Automaton* determinize(Automaton* nfa, const std::string& algorithm = "", map<RuntimeStat, double>* stats = NULL);
+		void shutdownServer();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_DETERMINIZATIONSERVER_HPP_ */
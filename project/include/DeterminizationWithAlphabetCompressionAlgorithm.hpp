@@ -0,0 +1,69 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithAlphabetCompressionAlgorithm.hpp
+ *
+ *
+ * This header file contains the declaration of the class DeterminizationWithAlphabetCompressionAlgorithm.
+ * This class is a generic subclass of DeterminizationAlgorithm, which reduces the alphabet of the NFA before running
+ * another instance of DeterminizationAlgorithm (SC, ESC or QSC).
+ *
+ * Two labels are equivalent when they mark exactly the same transitions, i.e. the same pairs of (parent, child) states.
+ * Equivalent labels are indistinguishable for the determinization: every state of the DFA has the same child for both.
+ * Hence, the algorithm works in three phases:
+ * - compression: the alphabet is partitioned into classes of equivalent labels, and the NFA is copied keeping only
+ *   the transitions marked by the representative of each class (its smallest label).
+ * - determinization, with the inner algorithm, which processes a single label for each class.
+ * - expansion: the transitions of the DFA are copied for all the labels of the classes of their representatives.
+ *   The expansion can be disabled, in which case the DFA keeps only the representatives, and the class map
+ *   (returned by the "getClassMap" method) can be used to read the original labels, e.g. with an ExecutableDFA.
+ */
+
+#ifndef INCLUDE_DETERMINIZATIONWITHALPHABETCOMPRESSIONALGORITHM_HPP_
+#define INCLUDE_DETERMINIZATIONWITHALPHABETCOMPRESSIONALGORITHM_HPP_
+
+#include <map>
+#include <string>
+
+#include "Automaton.hpp"
+#include "DeterminizationAlgorithm.hpp"
+
+// Runtime Statistics
+#define ALPHABET_SIZE						"ALPHABET       [#] "
+#define ALPHABET_CLASSES					"ALPH_CLASSES   [#] "
+#define COMPRESSION_TIME					"COMPRESS_TIME  [ms]"
+#define COMPRESSED_DETERMINIZATION_TIME		"DET_TIME       [ms]"
+#define EXPANSION_TIME						"EXPAND_TIME    [ms]"
+
+#define ALPHABET_COMPRESSION_ABBR_PREFIX	"ac+"
+
+namespace quicksc {
+
+	class DeterminizationWithAlphabetCompressionAlgorithm : public DeterminizationAlgorithm {
+
+	private:
+		DeterminizationAlgorithm* m_determinization_algorithm;
+		bool m_expand_classes;
+		std::map<std::string, std::string> m_class_map;			// Representative of the class of each label
+
+		Automaton* compressAlphabet(Automaton* nfa);
+		void expandClasses(Automaton* dfa);
+
+	public:
+		DeterminizationWithAlphabetCompressionAlgorithm(DeterminizationAlgorithm* determinization_algorithm, bool expand_classes = true);
+		~DeterminizationWithAlphabetCompressionAlgorithm();
+
+		void resetRuntimeStatsValues();
+		vector<RuntimeStat> getRuntimeStatsList();
+		map<RuntimeStat, double> getRuntimeStatsValues();
+
+		const std::map<std::string, std::string>& getClassMap();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_DETERMINIZATIONWITHALPHABETCOMPRESSIONALGORITHM_HPP_ */
@@ -0,0 +1,62 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithMintermsAlgorithm.hpp
+ *
+ *
+ * This header file contains the declaration of the class DeterminizationWithMintermsAlgorithm.
+ * This class is a generic subclass of DeterminizationAlgorithm, determinizing NFAs whose labels are character classes
+ * (see CharClass) with another instance of DeterminizationAlgorithm (SC, ESC or QSC), in three phases:
+ * - refinement: the classes labeling the NFA are replaced by their minterms, so that every transition labeled with a class C
+ *   becomes a transition for each minterm contained in C. Since the minterms are disjoint, the determinization algorithm can
+ *   treat them as plain symbols, and the transitions exiting a DFA state are labeled with disjoint classes.
+ * - determinization, with the inner algorithm.
+ * - merging: the transitions exiting a DFA state and entering the same state are merged into a single transition,
+ *   labeled with the union of their classes.
+ * The labels that are not classes are left untouched, and treated as opaque symbols.
+ * The merged labels are unions of minterms, not the classes of the NFA, so the solutions are not compared with the ones
+ * of the other algorithms, which treat the classes as opaque symbols.
+ */
+
+#ifndef INCLUDE_DETERMINIZATIONWITHMINTERMSALGORITHM_HPP_
+#define INCLUDE_DETERMINIZATIONWITHMINTERMSALGORITHM_HPP_
+
+#include "Automaton.hpp"
+#include "DeterminizationAlgorithm.hpp"
+
+// Runtime Statistics
+#define CLASS_LABELS					"CLASS_LABELS   [#] "
+#define MINTERMS						"MINTERMS       [#] "
+#define REFINEMENT_TIME					"REFINE_TIME    [ms]"
+#define MINTERMS_DETERMINIZATION_TIME	"DET_TIME       [ms]"
+#define MERGING_TIME					"MERGE_TIME     [ms]"
+
+#define MINTERMS_ABBR_PREFIX			"mt+"
+
+namespace quicksc {
+
+	class DeterminizationWithMintermsAlgorithm : public DeterminizationAlgorithm {
+
+	private:
+		DeterminizationAlgorithm* m_determinization_algorithm;
+
+		Automaton* refineLabels(Automaton* nfa);
+		void mergeLabels(Automaton* dfa);
+
+	public:
+		DeterminizationWithMintermsAlgorithm(DeterminizationAlgorithm* determinization_algorithm);
+		~DeterminizationWithMintermsAlgorithm();
+
+		bool hasComparableSolutions();
+		void resetRuntimeStatsValues();
+		vector<RuntimeStat> getRuntimeStatsList();
+		map<RuntimeStat, double> getRuntimeStatsValues();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_DETERMINIZATIONWITHMINTERMSALGORITHM_HPP_ */
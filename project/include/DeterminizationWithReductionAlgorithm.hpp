@@ -0,0 +1,50 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithReductionAlgorithm.hpp
+ *
+ *
+ * This header file contains the declaration of the class DeterminizationWithReductionAlgorithm.
+ * This class is a generic subclass of DeterminizationAlgorithm; it uses two different algorithms
+ * to perform the determinization:
+ * - one for the reduction of the NFA, i.e. an instance of ReductionAlgorithm (bisimulation or simulation, forward or backward).
+ * - one for the determinization, i.e. another instance of DeterminizationAlgorithm. In our case, the latter can be SC, ESC or QSC.
+ * Since the reduced NFA is language-equivalent and usually smaller, the determinization handles smaller extensions.
+ */
+
+#ifndef INCLUDE_DETERMINIZATIONWITHREDUCTIONALGORITHM_HPP_
+#define INCLUDE_DETERMINIZATIONWITHREDUCTIONALGORITHM_HPP_
+
+#include "Automaton.hpp"
+#include "DeterminizationAlgorithm.hpp"
+#include "ReductionAlgorithm.hpp"
+
+// Runtime Statistics
+#define REDUCTION_RATIO					"RED_RATIO      [%] "
+#define REDUCTION_TIME					"RED_TIME       [ms]"
+#define REDUCED_DETERMINIZATION_TIME	"DET_TIME       [ms]"
+
+namespace quicksc {
+
+	class DeterminizationWithReductionAlgorithm : public DeterminizationAlgorithm {
+
+	private:
+		ReductionAlgorithm* m_reduction_algorithm;
+		DeterminizationAlgorithm* m_determinization_algorithm;
+
+	public:
+		DeterminizationWithReductionAlgorithm(ReductionAlgorithm* reduction_algorithm, DeterminizationAlgorithm* determinization_algorithm);
+		~DeterminizationWithReductionAlgorithm();
+
+		void resetRuntimeStatsValues();
+		vector<RuntimeStat> getRuntimeStatsList();
+		map<RuntimeStat, double> getRuntimeStatsValues();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_DETERMINIZATIONWITHREDUCTIONALGORITHM_HPP_ */
@@ -0,0 +1,84 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ExecutableDFA.hpp
+ *
+ *
+ * This header file contains the definition of the ExecutableDFA class, a compiled form of a DFA used to match input words.
+ *
+ * The Automaton class stores the transitions of a state in a map indexed by strings, so reading a symbol costs
+ * a lookup in a map. An ExecutableDFA, instead, stores the transition function as a dense table, with a row
+ * for each state and a column for each symbol, so reading a symbol costs a single load from memory.
+ * - The symbols are identified by integer IDs (0, 1, 2, ...), in the lexicographic order of the labels.
+ *   The input words must be encoded as sequences of IDs, with the "encode" method.
+ * - The states are renumbered in breadth-first order from the initial state, so that the states close to the
+ *   initial one (the most visited, usually) have close rows. The state 0 is the "dead" state, where all the
+ *   missing transitions go and which never accepts; the initial state is the state 1.
+ * - The final states are marked in a bitmap.
+ * - The table stores the offsets of the rows (i.e. the state multiplied by the number of columns), instead of
+ *   the states, so that the matching loop doesn't need any multiplication.
+ * - An additional column, always leading to the dead state, is used for the symbols that don't belong to the alphabet
+ *   of the DFA.
+ * - Optionally, a class map can associate many labels to the same column, when the DFA has been determinized on
+ *   the representatives of classes of equivalent labels.
+ *
+ * The matching loop is a chain of dependent loads: every step needs the result of the previous one.
+ * To hide the latency of the memory, the "acceptsInterleaved" method runs several words at the same time,
+ * with independent chains that the processor can execute in parallel.
+ */
+
+#ifndef INCLUDE_EXECUTABLEDFA_HPP_
+#define INCLUDE_EXECUTABLEDFA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Automaton.hpp"
+
+#define EXECUTABLE_DEAD_STATE		0
+#define EXECUTABLE_INITIAL_STATE	1
+#define EXECUTABLE_STREAMS			4		// Number of words matched at the same time by the interleaved loop
+
+namespace quicksc {
+
+	class ExecutableDFA {
+
+	private:
+		std::vector<std::string> m_symbols;					// Labels of the symbols, indexed by ID
+		std::map<std::string, uint32_t> m_symbols_ids;		// IDs of the symbols, indexed by label (including the labels mapped to a class)
+		std::vector<std::string> m_states_names;			// Names of the original states, indexed by number
+		uint32_t m_states_count;							// Number of states, including the dead state
+		uint32_t m_columns;									// Number of columns of the table, including the column of the unknown symbols
+		std::vector<uint32_t> m_table;						// Offsets of the next rows, indexed by (state * columns + symbol)
+		std::vector<uint64_t> m_accepting;					// Bitmap of the final states
+
+		void compile(Automaton* dfa);
+		uint32_t runFromOffset(uint32_t offset, const uint32_t* input, size_t length);
+
+	public:
+		ExecutableDFA(Automaton* dfa);
+		ExecutableDFA(Automaton* dfa, const std::map<std::string, std::string>& class_map);
+		~ExecutableDFA();
+
+		uint32_t getStatesCount();
+		uint32_t getSymbolsCount();
+		uint32_t getSymbolId(const std::string& label);
+		std::string getStateName(uint32_t state);
+		std::vector<uint32_t> encode(const std::vector<std::string>& word);
+
+		uint32_t step(uint32_t state, uint32_t symbol);
+		bool isAccepting(uint32_t state);
+		uint32_t run(const uint32_t* input, size_t length);
+		bool accepts(const uint32_t* input, size_t length);
+		bool accepts(const std::vector<std::string>& word);
+		void acceptsInterleaved(const uint32_t* const* inputs, const size_t* lengths, bool* results);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_EXECUTABLEDFA_HPP_ */
@@ -0,0 +1,49 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * MemoryProfiler.hpp
+ *
+ *
+ * This header file contains the definition of the MemoryProfiler class, a utility class that measures
+ * the memory used by a block of code (usually, the execution of a determinization algorithm).
+ *
+ * The heap usage is measured by replacing the global allocation operators ("new" and "delete"), that update
+ * a set of thread-local counters; therefore, the measure refers only to the allocations of the current thread.
+ * The peak of the resident set size (RSS) is read from the file "/proc/self/status", where available,
+ * and it refers to the whole process.
+ */
+
+#ifndef INCLUDE_MEMORYPROFILER_HPP_
+#define INCLUDE_MEMORYPROFILER_HPP_
+
+namespace quicksc {
+
+	/**
+	 * Memory used by a block of code, measured by the MemoryProfiler.
+	 */
+	struct MemoryUsage {
+		unsigned long long peak_heap_bytes;		// Maximum amount of heap memory in use at the same time, over the initial amount
+		unsigned long long allocations;			// Number of allocations
+		unsigned long long allocated_bytes;		// Total amount of allocated memory
+		unsigned long long peak_rss_kb;			// Peak of the resident set size of the process (0 if not available)
+	};
+
+	class MemoryProfiler {
+
+	public:
+		static void start();
+		static MemoryUsage stop();
+
+		static unsigned long long getAllocationsCount();
+		static unsigned long long getAllocatedBytes();
+		static long long getCurrentHeapBytes();
+
+		static bool resetPeakRSS();
+		static unsigned long long readPeakRSS();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_MEMORYPROFILER_HPP_ */
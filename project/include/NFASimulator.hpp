@@ -0,0 +1,91 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * NFASimulator.hpp
+ *
+ *
+ * This header file contains the definition of the NFASimulator class, used to match input words directly on an NFA,
+ * without determinizing it.
+ *
+ * The simulator keeps the set of the active states as a bitset, and it advances the whole set at each symbol.
+ * The states are renumbered in breadth-first order from the initial state, and the epsilon-closures are precomputed,
+ * so that every transition of the simulator already leads to an epsilon-closed set.
+ * The symbols are identified by integer IDs, in the lexicographic order of the labels, as in the ExecutableDFA class.
+ *
+ * Two representations are used, according to the number of states:
+ * - Bit-parallel, for NFAs with at most 64 states: the active set is a single machine word, and the step is computed
+ *   with tables indexed by the bytes of the word (8 lookups at most, with no loop over the active states).
+ *   If the NFA is "homogeneous", i.e. all the transitions entering a state have the same label (as in the Glushkov
+ *   automata), the step is factored as in the Shift-And algorithm: the states following the active ones, regardless
+ *   of the label, masked by the states entered by the symbol. The tables are shared by all the symbols.
+ *   Otherwise, each symbol has its own tables.
+ * - Generic, for larger NFAs: the active set is an array of words, and the step is the OR of the rows
+ *   (the sets of the children) of the active states for the symbol.
+ *
+ * Compared to a determinized DFA, a step costs more than a single load, but the construction is linear
+ * in the size of the NFA and it never blows up.
+ */
+
+#ifndef INCLUDE_NFASIMULATOR_HPP_
+#define INCLUDE_NFASIMULATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Automaton.hpp"
+
+#define SIMULATOR_WORD_BITS			64
+#define SIMULATOR_MAX_BIT_PARALLEL	64		// Maximum number of states of the bit-parallel representation
+#define SIMULATOR_NO_ROW			0xFFFFFFFF
+
+namespace quicksc {
+
+	class NFASimulator {
+
+	private:
+		std::vector<std::string> m_symbols;					// Labels of the symbols, indexed by ID
+		std::map<std::string, uint32_t> m_symbols_ids;		// IDs of the symbols, indexed by label
+		uint32_t m_states_count;
+		uint32_t m_words;									// Number of words of an active set
+		bool m_bit_parallel;
+		bool m_homogeneous;
+
+		// Bit-parallel representation
+		uint32_t m_chunks;									// Number of bytes of the active set
+		uint64_t m_initial_word;
+		uint64_t m_final_word;
+		std::vector<uint64_t> m_byte_tables;				// Children of the states of a byte, indexed by ((symbol * chunks + chunk) * 256 + byte)
+		std::vector<uint64_t> m_symbols_masks;				// States entered by each symbol (only for homogeneous NFAs)
+
+		// Generic representation
+		std::vector<uint64_t> m_initial_set;
+		std::vector<uint64_t> m_final_set;
+		std::vector<uint32_t> m_rows_indexes;				// Index of the row of each state, for each symbol, indexed by (symbol * states + state)
+		std::vector<uint64_t> m_rows;						// Rows of the children, each one of "words" words
+
+		bool acceptsBitParallel(const uint32_t* input, size_t length);
+		bool acceptsGeneric(const uint32_t* input, size_t length);
+
+	public:
+		NFASimulator(Automaton* nfa);
+		~NFASimulator();
+
+		uint32_t getStatesCount();
+		uint32_t getSymbolsCount();
+		bool isBitParallel();
+		bool isHomogeneous();
+		uint32_t getSymbolId(const std::string& label);
+		std::vector<uint32_t> encode(const std::vector<std::string>& word);
+
+		bool accepts(const uint32_t* input, size_t length);
+		bool accepts(const std::vector<std::string>& word);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_NFASIMULATOR_HPP_ */
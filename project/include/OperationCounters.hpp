@@ -0,0 +1,82 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * OperationCounters.hpp
+ *
+ *
+ * This header file contains the definition of the counters of the primitive operations on the automata,
+ * such as the creation of a transition or the computation of an epsilon closure.
+ * The counters give a measure of the work done by an algorithm that doesn't depend on the machine,
+ * to be compared with the measured times.
+ *
+ * The counters are thread-local and they're never reset: a measure is the difference between two readings
+ * of the same thread, taken before and after the block of code (usually, the execution of an algorithm).
+ * The counters are exposed as runtime statistics by every determinization algorithm.
+ */
+
+#ifndef INCLUDE_OPERATIONCOUNTERS_HPP_
+#define INCLUDE_OPERATIONCOUNTERS_HPP_
+
+#include <vector>
+
+#include "Statistics.hpp"
+
+// Runtime Statistics
+#define OPERATIONS_CONNECT				"CONNECT        [#] "
+#define OPERATIONS_DISCONNECT			"DISCONNECT     [#] "
+#define OPERATIONS_EPSILON_CLOSURE		"EPS_CLOSURE    [#] "
+#define OPERATIONS_EPSILON_VISIT		"EPS_VISITED    [#] "
+#define OPERATIONS_EXTENSION_INSERT		"EXT_INSERT     [#] "
+#define OPERATIONS_NAME_CONSTRUCTION	"NAME_BUILD     [#] "
+#define OPERATIONS_STATE_LOOKUP			"STATE_LOOKUP   [#] "
+#define OPERATIONS_SINGULARITY_INSERT	"SING_INSERT    [#] "
+#define OPERATIONS_SINGULARITY_DUPLICATE "SING_DUPLICATE [#] "
+
+namespace quicksc {
+
+	/**
+	 * Primitive operations counted during the execution.
+	 */
+	enum Operation {
+		OP_CONNECT_CHILD,				// Calls of "State::connectChild"
+		OP_DISCONNECT_CHILD,			// Calls of "State::disconnectChild"
+		OP_EPSILON_CLOSURE,				// Computations of an epsilon closure
+		OP_EPSILON_VISIT,				// States visited by the computations of the epsilon closures
+		OP_EXTENSION_INSERT,			// Insertions in the extensions built as l-closures or differences of extensions
+		OP_NAME_CONSTRUCTION,			// Constructions of the name of a state from its extension
+		OP_STATE_LOOKUP,				// Searches of a state by name in an automaton
+		OP_SINGULARITY_INSERT,			// Singularities inserted in a list
+		OP_SINGULARITY_DUPLICATE,		// Singularities not inserted in a list, since already present
+
+		OPERATION_END,
+	};
+
+	/** Counters of the current thread, indexed by the Operation enumeration */
+	extern thread_local constinit unsigned long long operation_counters[OPERATION_END];
+
+	/** Increments the counter of an operation, by one or by a given amount */
+	#define COUNT_OPERATION( op )				(quicksc::operation_counters[ op ]++)
+	#define COUNT_OPERATIONS( op, amount )		(quicksc::operation_counters[ op ] += ( amount ))
+
+	/**
+	 * Reading of all the counters of a thread.
+	 */
+	struct OperationCounts {
+		unsigned long long values[OPERATION_END];
+	};
+
+	class OperationCounters {
+
+	public:
+		static OperationCounts read();
+		static OperationCounts since(const OperationCounts& start);
+
+		static RuntimeStat getRuntimeStat(Operation operation);
+		static std::vector<RuntimeStat> getRuntimeStatsList();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_OPERATIONCOUNTERS_HPP_ */
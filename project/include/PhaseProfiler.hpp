@@ -0,0 +1,82 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * PhaseProfiler.hpp
+ *
+ *
+ * This header file contains the definition of the PhaseProfiler class and of the ScopedPhase class,
+ * used to measure the time spent in the phases of an execution (e.g. the phases of an algorithm).
+ *
+ * A ScopedPhase starts measuring when it's created and stops when it's destroyed, or when the "stop" method is called;
+ * the time is read from the monotonic clock of the standard library, with the resolution of the nanosecond.
+ * The phases opened while another phase is running are its sub-phases: for each thread, the PhaseProfiler
+ * builds a tree of the phases, where every node accumulates the time and the number of executions of a phase
+ * in the same position. The cost of a phase is two readings of the clock and a search among the few children
+ * of the current node, so the phases can be left in the release builds.
+ *
+ * The times are returned in milliseconds, as floating point values, so that the short phases are not truncated to zero.
+ */
+
+#ifndef INCLUDE_PHASEPROFILER_HPP_
+#define INCLUDE_PHASEPROFILER_HPP_
+
+#include <string>
+#include <vector>
+
+#define NANOSECONDS_PER_MILLISECOND		1e6
+
+namespace quicksc {
+
+	/**
+	 * Node of the tree of the phases of a thread.
+	 */
+	struct PhaseNode {
+		const char* name;
+		unsigned long long total_ns;		// Time spent in all the executions of the phase
+		unsigned long calls;				// Number of executions of the phase
+		PhaseNode* parent;
+		std::vector<PhaseNode*> children;
+	};
+
+	class PhaseProfiler {
+
+	private:
+		static void deleteNode(PhaseNode* node);
+		static void printNode(const PhaseNode* node, unsigned int depth, std::string& output);
+
+	public:
+		static unsigned long long now();
+		static PhaseNode* enter(const char* name);
+		static void exit(PhaseNode* node, unsigned long long elapsed_ns);
+
+		static void reset();
+		static const PhaseNode* getRoot();
+		static std::string toString();
+
+	};
+
+	/**
+	 * Phase of an execution, measured from its creation to its destruction (or to the call of the "stop" method).
+	 * The name is not copied, so it must be a string literal (or a string living until the reset of the tree).
+	 * The phases of a thread must be closed in the reverse order of their opening, as it happens for scoped objects.
+	 */
+	class ScopedPhase {
+
+	private:
+		PhaseNode* m_node;
+		unsigned long long m_start;
+		double m_elapsed_ms;
+		bool m_running;
+
+	public:
+		ScopedPhase(const char* name);
+		~ScopedPhase();
+
+		double stop();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_PHASEPROFILER_HPP_ */
@@ -8,6 +8,7 @@
  * This header file contains the declaration of multiple classes:
  * - Problem, which represents a generic problem to be solved with some testing;
  * - DeterminizationProblem, which represents a problem that has to be solved directly by a determinization algorithm (more info later).
+ * - DFAPerturbationProblem, a determinization problem whose NFA is a DFA with a few injected non-deterministic transitions.
  * - ProblemGenerator, which is a class representing the generic problem generator;
  * - RandomnessManager, a utility class that manages the randomness of the problem generator.
  *
@@ -31,6 +32,7 @@ namespace quicksc {
 	public:
 		typedef enum {
 			DETERMINIZATION_PROBLEM,
+			DFA_PERTURBATION_PROBLEM,
 		} ProblemType;
 
 	private:
@@ -55,20 +57,47 @@ namespace quicksc {
 
 	private:
 		Automaton* m_nfa;
+		unsigned long int m_dfa_size_bound;		// Upper bound of the size of the solution, if known by the generator
+
+	protected:
+		DeterminizationProblem(ProblemType type, Automaton* nfa, unsigned long int dfa_size_bound);
 
 	public:
-		DeterminizationProblem(Automaton* nfa);
+		DeterminizationProblem(Automaton* nfa, unsigned long int dfa_size_bound = DFA_SIZE_UNKNOWN);
 		~DeterminizationProblem();
 
 		Automaton* getNFA();
+		unsigned long int getDFASizeBound();
+	};
+
+	/**
+	 * This class represents a determinization problem whose NFA is an "almost deterministic" automaton:
+	 * a DFA where a fixed number of non-deterministic (or epsilon) transitions has been injected,
+	 * starting from the states at a fixed distance from the initial state.
+	 * It can be solved exactly like a DeterminizationProblem.
+	 */
+	class DFAPerturbationProblem : public DeterminizationProblem {
+
+	private:
+		unsigned int m_perturbations;
+		unsigned int m_depth;
+
+	public:
+		DFAPerturbationProblem(Automaton* nfa, unsigned int perturbations, unsigned int depth);
+		~DFAPerturbationProblem();
+
+		unsigned int getPerturbations();
+		unsigned int getDepth();
 	};
 
 	/**
 	 * This class has the role of generating the problems on which the algorithms will be tested.
-	 * For now, it only creates a DeterminizationProblem with the method "generateDeterminizationProblem", but it may be extended in the future.
+	 * It creates a DeterminizationProblem with the method "generateDeterminizationProblem", or a DFAPerturbationProblem
+	 * with the method "generateDFAPerturbationProblem", depending on the problem type of the configurations.
 	 * 
-	 * It uses two other generator classes:
-	 * - NFAGenerator, which generates random NFA;
+	 * It uses other generator classes:
+	 * - NFAGenerator, which generates random NFA (or StreamingNFAGenerator, for large NFA);
+	 * - DFAGenerator, which generates the random DFA to be perturbed;
 	 * - AlphabetGenerator, which generates random alphabets.
 	 */
 	class ProblemGenerator {
@@ -76,15 +105,21 @@ namespace quicksc {
 	private:
 		Problem::ProblemType m_problem_type;
 		Alphabet m_alphabet;
-		NFAGenerator* m_nfa_generator;
-		//DFAGenerator* m_dfa_generator;
+		AutomataGenerator* m_nfa_generator = NULL;		// NFAGenerator or StreamingNFAGenerator, depending on the configurations
+		DFAGenerator* m_dfa_generator = NULL;
+		unsigned int m_perturbations;
+		unsigned int m_perturbation_depth;
+		double m_epsilon_probability;
+
+		bool injectPerturbation(Automaton* dfa, vector<State*>& origins, vector<State*>& states);
 
 	public:
-		ProblemGenerator(Configurations* configurations);
+		ProblemGenerator(Configurations* configurations, bool init_randomness = true);
 		~ProblemGenerator();
 
 		Problem* generate();
 		DeterminizationProblem* generateDeterminizationProblem();
+		DFAPerturbationProblem* generateDFAPerturbationProblem();
 
 	};
 
@@ -0,0 +1,68 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ProblemPipeline.hpp
+ *
+ *
+ * This module manages the generation of the problems in background, overlapped with the solving.
+ * A pool of generator threads prepares the upcoming problems (with the distances of their states already computed)
+ * and puts them in a bounded queue; the solver extracts them one by one, waiting only if the queue is empty.
+ *
+ * Each thread owns a ProblemGenerator, since the generators are not thread-safe.
+ * The generators share the random sequence of the standard library ("rand"), so the sequence of the generated problems
+ * is the same of the sequential generation only with a single thread; with more threads, the problems depend on the scheduling.
+ */
+
+#ifndef INCLUDE_PROBLEMPIPELINE_HPP_
+#define INCLUDE_PROBLEMPIPELINE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ProblemGenerator.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Problem prepared by the pipeline, with the time spent to generate it (in milliseconds).
+	 */
+	struct PreparedProblem {
+		Problem* problem;
+		double generation_time;
+	};
+
+	class ProblemPipeline {
+
+	private:
+		vector<ProblemGenerator*> m_generators;
+		vector<std::thread> m_threads;
+		std::deque<PreparedProblem> m_queue;
+		std::mutex m_mutex;
+		std::condition_variable m_not_empty;
+		std::condition_variable m_not_full;
+
+		unsigned int m_depth;				// Maximum number of problems in the queue
+		unsigned long m_to_produce;			// Number of problems not yet assigned to a thread
+		unsigned long m_to_consume;			// Number of problems not yet extracted by the solver
+		bool m_stopped;
+		string m_error;						// Message of the exception thrown by a generator, if any
+
+		void produce(ProblemGenerator* generator);
+
+	public:
+		ProblemPipeline(Configurations* configurations, unsigned int threads, unsigned int depth);
+		~ProblemPipeline();
+
+		void start(unsigned long count);
+		PreparedProblem next();
+		void stop();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_PROBLEMPIPELINE_HPP_ */
@@ -7,6 +7,13 @@
  * This module manages all the procedures that solve a problem.
  * The problem is represented by a Problem object, and it's generated by a ProblemGenerator object.
  * The Problem instance is passed to the ProblemSolver, which will solve it while testing the determinization algorithm.
+ *
+ * In isolation mode, each algorithm run is executed in a forked child process, which sends back its measures
+ * (and optionally the solution, in binary form) through a pipe. This way, the heap state left by an algorithm
+ * does not affect the time and the memory measured for the following ones.
+ *
+ * When the background generation is enabled, the problems of a series are prepared by a ProblemPipeline
+ * while the algorithms are running, and the solver only waits when no problem is ready.
  */
 
 #ifndef INCLUDE_PROBLEMSOLVER_HPP_
@@ -22,12 +29,24 @@ namespace quicksc {
 
 	class ProblemSolver {
 	private:
+		Configurations* configurations;		// Reference to the configurations, used to create the pipeline
 		ProblemGenerator* generator;		// The problem generator
 		ResultCollector* collector;			// Archive of results of the tests
 
 		const vector<DeterminizationAlgorithm*>& algorithms;	// Reference to the list of algorithms to test
 		DeterminizationAlgorithm* benchmark_algorithm_pointer;	// Reference to the benchmark algorithm (needed to form the results)
 
+		bool isolation_mode;				// If true, each algorithm run is executed in a child process
+		bool isolation_ship_solution;		// If true, the child process sends back the solution
+
+		unsigned int generation_threads;	// Number of threads of the background generation (0 = no background generation)
+		unsigned int generation_depth;		// Maximum number of problems generated in advance
+		double current_generation_time;		// Time spent to generate the problem being solved [ms]
+		double current_generation_wait;		// Time spent waiting for the problem being solved [ms]
+
+		void runInProcess(DeterminizationAlgorithm* algo, DeterminizationProblem* problem, Result* result);
+		void runIsolated(DeterminizationAlgorithm* algo, DeterminizationProblem* problem, Result* result);
+
 	public:
 		ProblemSolver(Configurations* configurations, const vector<DeterminizationAlgorithm*>& algorithms);
 		~ProblemSolver();
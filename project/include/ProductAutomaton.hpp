@@ -0,0 +1,87 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ProductAutomaton.hpp
+ *
+ *
+ * This header file contains the definition of the ProductAutomaton class, representing the product of two automata,
+ * used to compute their intersection or their union.
+ *
+ * The states of the product are pairs of states of the two operands, and they're built on the fly: a pair is created
+ * when it's reached for the first time, and its transitions are created only when the pair is expanded.
+ * This way, the algorithms exploring the product (the emptiness check, the Subset Construction) build only
+ * the part of the product they actually reach, which is usually much smaller than the whole product.
+ * The whole reachable product can still be obtained as a normal automaton, with the "materialize" method.
+ *
+ * The transitions marked with a symbol are synchronized: the pair (p, q) moves with the label "a" to (p', q')
+ * if p moves to p' and q moves to q' with the same label. The epsilon-transitions are asynchronous: each operand moves
+ * alone, while the other remains in its state.
+ * In the union, an operand with no transitions for a label moves to a "dead" component (NULL), which never accepts;
+ * this way, the union doesn't require the operands to be complete.
+ *
+ * The name of a pair is "(p,q)", where the names of the components are escaped with a backslash before the characters
+ * '\\', '(', ')', ',' (and before a name equal to "-"), so that the names of different pairs never collide.
+ * The dead component is named "-".
+ *
+ * The operands are not modified, and they must not be modified as long as the product is used.
+ */
+
+#ifndef INCLUDE_PRODUCTAUTOMATON_HPP_
+#define INCLUDE_PRODUCTAUTOMATON_HPP_
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Automaton.hpp"
+
+#define PRODUCT_DEAD_COMPONENT_NAME		"-"
+
+namespace quicksc {
+
+	class ProductAutomaton {
+
+	public:
+		/**
+		 * Operation computed by the product.
+		 */
+		typedef enum {
+			PRODUCT_INTERSECTION,
+			PRODUCT_UNION,
+		} ProductOperation;
+
+	private:
+		Automaton* m_left;
+		Automaton* m_right;
+		ProductOperation m_operation;
+
+		Automaton* m_product;										// States of the product built so far
+		std::map<std::pair<State*, State*>, State*> m_pairs;		// Correspondence between the pairs and the states of the product
+		std::map<State*, std::pair<State*, State*>> m_components;	// Inverse correspondence
+		std::set<State*> m_expanded;								// States of the product whose transitions have been created
+
+		State* getPairState(State* left, State* right);
+
+		static string getComponentName(State* component);
+
+	public:
+		ProductAutomaton(Automaton* left, Automaton* right, ProductOperation operation);
+		~ProductAutomaton();
+
+		State* getInitialState();
+		void expand(State* product_state);
+		unsigned int getBuiltStatesCount();
+
+		Extension computeEpsilonClosure(const Extension& extension);
+		Extension computeLClosure(const Extension& extension, string label);
+
+		bool isEmpty(vector<string>* witness = NULL);
+		Automaton* materialize();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_PRODUCTAUTOMATON_HPP_ */
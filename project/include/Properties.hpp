@@ -18,21 +18,39 @@
 #define ESC_NAME        "Embedded Subset Construction"
 #define QSC_ABBR        "qsc"
 #define QSC_NAME        "Quick Subset Construction"
+#define BSC_ABBR        "bsc"
+#define BSC_NAME        "BDD Subset Construction"
 
 #define NER_ABBR        "ner"
 #define NER_NAME        "Naive Epsilon Removal"
 #define GER_ABBR        "ger"
 #define GER_NAME        "Global Epsilon Removal"
 
+#define FBR_ABBR        "fbr"
+#define FBR_NAME        "Forward Bisimulation Reduction"
+#define BBR_ABBR        "bbr"
+#define BBR_NAME        "Backward Bisimulation Reduction"
+#define FSR_ABBR        "fsr"
+#define FSR_NAME        "Forward Simulation Reduction"
+#define BSR_ABBR        "bsr"
+#define BSR_NAME        "Backward Simulation Reduction"
+
 // Results, folders and files
 #define DIR_RESULTS 						"results/"
+#define DIR_JOBS 							"results/jobs/"
+#define DIR_CACHE 							"results/cache/"
 #define FILE_NAME_ORIGINAL_AUTOMATON 		"original"
 #define FILE_NAME_SOLUTION                  "solution"
 #define FILE_EXTENSION_GRAPHVIZ 			".gv"
 #define FILE_EXTENSION_PDF 					".pdf"
 
 #define FILE_NAME_STATS_LOG                 "stats"
+#define FILE_NAME_SCALING_LOG               "scaling"
+#define FILE_NAME_BASELINE_PREFIX           "baseline_"
 #define FILE_EXTENSION_CSV                  ".csv"
+#define FILE_NAME_TRACE                     "trace"
+#define FILE_EXTENSION_JSON                 ".json"
+#define FILE_EXTENSION_BINARY               ".bin"
 
 #define CONFIG_FILENAME                     "configs.txt"
 
@@ -18,6 +18,7 @@
 #include "DeterminizationAlgorithm.hpp"
 #include "Singularity.hpp"
 #include "Configurations.hpp"
+#include "VersionedAutomaton.hpp"
 
 // Runtime Statistics
 #define IMPACT							"IMPACT         [%] "
@@ -44,6 +45,8 @@ namespace quicksc {
 
 	private:
 		SingularityList* m_singularities;
+		VersionedAutomaton* m_versioned_automaton;		// If not NULL, the DFA is published on it during the restructuring
+		unsigned long m_publication_period;				// Number of singularities processed between two publications
 
 		void cleanInternalStatus();
 
@@ -59,6 +62,8 @@ namespace quicksc {
 		void resetRuntimeStatsValues();
 		vector<RuntimeStat> getRuntimeStatsList();
 
+		void setVersionedAutomaton(VersionedAutomaton* versioned_automaton, unsigned long publication_period = 1);
+
 		Automaton* run(Automaton* nfa);
 
 	};
@@ -0,0 +1,107 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ReductionAlgorithm.hpp
+ *
+ *
+ * This header file contains the definition of the class ReductionAlgorithm, a generic algorithm for reducing
+ * the number of states of an NFA without changing its language, and of its implementations.
+ *
+ * All the implementations compute an equivalence relation over the states of the NFA, and return the quotient
+ * automaton, where each class of equivalent states is merged into a single state. The relations are computed
+ * in one of two directions:
+ * - forward: two states are related when they "behave the same" towards the final states (along the exiting transitions);
+ * - backward: two states are related when they "behave the same" from the initial state (along the incoming transitions).
+ * The epsilon-transitions are treated as transitions marked by an additional label, which preserves the language.
+ */
+
+#ifndef INCLUDE_REDUCTIONALGORITHM_HPP_
+#define INCLUDE_REDUCTIONALGORITHM_HPP_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "Automaton.hpp"
+
+using namespace std;
+
+namespace quicksc {
+
+	/**
+	 * Direction of the relation computed by a reduction algorithm.
+	 */
+	typedef enum {
+		FORWARD_REDUCTION,
+		BACKWARD_REDUCTION,
+	} ReductionDirection;
+
+	class ReductionAlgorithm {
+
+	private:
+		string m_name;
+		string m_abbr;
+
+	protected:
+		ReductionDirection m_direction;
+		vector<State*> m_states;								// States of the NFA, indexed by number
+		vector<bool> m_accepting;								// Final states (forward) or initial state (backward)
+		vector<map<unsigned long, vector<unsigned long>>> m_post;	// Children (forward) or parents (backward) of each state, by label
+		vector<map<unsigned long, vector<unsigned long>>> m_pre;	// Parents (forward) or children (backward) of each state, by label
+
+		void indexAutomaton(Automaton* nfa);
+		Automaton* buildQuotient(Automaton* nfa, const vector<unsigned long>& blocks, unsigned long blocks_count);
+
+	public:
+		ReductionAlgorithm(string abbr, string name, ReductionDirection direction);
+		virtual ~ReductionAlgorithm();
+
+		const string& abbr();
+		const string& name();
+
+		virtual Automaton* run(Automaton* nfa) = 0;
+
+	};
+
+	/**
+	 * This class implements the reduction by bisimulation.
+	 * Two states are (forward) bisimilar when they're both final or both non-final, and for each label, the children
+	 * of one are bisimilar to the children of the other. The coarsest bisimulation is computed by partition refinement:
+	 * starting from the partition {final, non-final}, every block is split according to the signatures of its states,
+	 * i.e. the sets of pairs (label, block of the child), until no block is split anymore.
+	 */
+	class BisimulationReductionAlgorithm : public ReductionAlgorithm {
+
+	public:
+		BisimulationReductionAlgorithm(ReductionDirection direction = FORWARD_REDUCTION);
+		virtual ~BisimulationReductionAlgorithm();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+	/**
+	 * This class implements the reduction by simulation equivalence.
+	 * A state p (forward) simulates a state q when p is final if q is final, and for each transition q --a--> q'
+	 * there is a transition p --a--> p' such that p' simulates q'. Two states are equivalent when they simulate
+	 * each other; this relation is coarser than bisimulation, so it merges more states, at a higher cost.
+	 * The largest simulation is computed by removing the pairs that violate the definition: whenever a pair (q', p')
+	 * is removed, only the pairs of their parents (found through the incoming transitions) need to be checked again.
+	 */
+	class SimulationReductionAlgorithm : public ReductionAlgorithm {
+
+	private:
+		bool checkPair(const vector<uint64_t>& relation, unsigned long words, unsigned long q, unsigned long p);
+
+	public:
+		SimulationReductionAlgorithm(ReductionDirection direction = FORWARD_REDUCTION);
+		virtual ~SimulationReductionAlgorithm();
+
+		Automaton* run(Automaton* nfa);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_REDUCTIONALGORITHM_HPP_ */
@@ -23,6 +23,7 @@
 #include "Statistics.hpp"
 #include "ProblemGenerator.hpp"
 #include "DeterminizationAlgorithm.hpp"
+#include "MemoryProfiler.hpp"
 
 namespace quicksc {
 
@@ -32,12 +33,29 @@ namespace quicksc {
 	 */
 	struct Result {
 		Problem* original_problem;
-		map<DeterminizationAlgorithm*, Automaton*> solutions;
+		double generation_time;												// [ms]
+		double generation_wait;												// [ms]
+		map<DeterminizationAlgorithm*, Automaton*> solutions;				// The solutions can be NULL, when they're computed in an isolated process and not sent back
+		map<DeterminizationAlgorithm*, unsigned int> solution_sizes;
+		map<DeterminizationAlgorithm*, unsigned int> solution_transitions;
 		map<DeterminizationAlgorithm*, double> times;
+		map<DeterminizationAlgorithm*, MemoryUsage> memory;
 		map<DeterminizationAlgorithm*, map<RuntimeStat, double>> runtime_stats;
+		map<DeterminizationAlgorithm*, string> phases;						// Tree of the phases of the execution, as text
 		DeterminizationAlgorithm* benchmark_algorithm;
 	};
 
+	/**
+	 * Aggregated value of a single statistic over all the testcases of a collector.
+	 * The name is the same used in the header of the CSV log (with the abbreviation of the algorithm, if any).
+	 */
+	struct AggregatedStat {
+		string name;
+		std::tuple<double, double, double, double> values;		// (MIN, AVG, MAX, DEV)
+		unsigned int samples;
+		bool is_cost;											// TRUE if a higher value is worse, as for times and memory
+	};
+
 	/**
 	 * Classe che raccoglie i risultati e permette l'analisi
 	 * di semplici statistiche.
@@ -71,6 +89,7 @@ namespace quicksc {
 		std::tuple<double, double, double, double> getStat(ResultStat stat);
 		std::tuple<double, double, double, double> getStat(AlgorithmStat stat, DeterminizationAlgorithm* algorithm);
 		std::tuple<double, double, double, double> getStat(RuntimeStat stat, DeterminizationAlgorithm* algorithm);
+		vector<AggregatedStat> getAggregatedStats();
 
 		void presentResult(Result* result);
 		void presentResults();
@@ -0,0 +1,83 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ScalingAnalyzer.hpp
+ *
+ *
+ * This module manages the "scaling-curve" mode of the tests.
+ * In this mode, a chosen parameter of the configuration (usually the size of the automaton) is grown geometrically,
+ * and every algorithm is tested on each value until its average execution time exceeds a given budget.
+ *
+ * At the end, the analyzer fits a linear regression on the log-log values of the measured statistics (time, peak heap
+ * memory and size of the DFA), obtaining the empirical complexity exponents of each algorithm with respect to the parameter.
+ */
+
+#ifndef INCLUDE_SCALINGANALYZER_HPP_
+#define INCLUDE_SCALINGANALYZER_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Configurations.hpp"
+#include "DeterminizationAlgorithm.hpp"
+#include "ResultCollector.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Statistics measured at each point of the scaling curve.
+	 * They're expressed as strings in the same form of the RuntimeStat values, i.e. with a name and a measure unit.
+	 */
+	#define SCALING_TIME 			"TIME           [ms]"
+	#define SCALING_DFA_SIZE 		"DFA_SIZE       [#]"
+	#define SCALING_PEAK_HEAP 		"PEAK_HEAP      [KiB]"
+
+	/**
+	 * Single point of the scaling curve, i.e. the average values of the statistics
+	 * obtained by each algorithm for a specific value of the parameter.
+	 */
+	struct ScalingPoint {
+		double parameter_value;
+		map<DeterminizationAlgorithm*, map<string, double>> values;
+	};
+
+	/**
+	 * Result of the linear regression of the log-log values: log(y) = slope * log(x) + intercept.
+	 * The slope is the empirical complexity exponent of the statistic.
+	 */
+	struct ScalingFit {
+		double slope;
+		double intercept;
+		double r_squared;
+		unsigned int points;
+	};
+
+	class ScalingAnalyzer {
+
+	private:
+		Configurations* m_config_reference;
+		const vector<DeterminizationAlgorithm*>& m_algorithms;
+		SettingID m_parameter;
+		vector<ScalingPoint> m_points;
+
+		vector<string> getScalingStatsList();
+		ScalingPoint measurePoint(ResultCollector* collector, const vector<DeterminizationAlgorithm*>& active_algorithms, double parameter_value);
+		void printLogHeader(string log_file_name);
+
+	public:
+		ScalingAnalyzer(Configurations* configurations, const vector<DeterminizationAlgorithm*>& algorithms);
+		~ScalingAnalyzer();
+
+		void run();
+		ScalingFit getFit(DeterminizationAlgorithm* algorithm, string stat);
+		void presentResults();
+
+		static ScalingFit fitLogLog(const vector<std::pair<double, double>>& samples);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_SCALINGANALYZER_HPP_ */
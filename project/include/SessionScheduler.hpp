@@ -0,0 +1,57 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * SessionScheduler.hpp
+ *
+ *
+ * This module runs the test cases of the configurations (all the sessions, and all the combinations of their values)
+ * as independent jobs, in parallel worker processes.
+ *
+ * Each job is executed by a forked child process, which inherits the configurations already positioned on its test case;
+ * since every test case sets its own random seed, the results are the same of the sequential execution.
+ * The output of a job and its log files (statistics, scaling) are written in separate files of the "jobs" folder;
+ * when the jobs complete, their output is printed and their logs are merged in the original order.
+ */
+
+#ifndef INCLUDE_SESSIONSCHEDULER_HPP_
+#define INCLUDE_SESSIONSCHEDULER_HPP_
+
+#include <functional>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "Configurations.hpp"
+
+#define NO_JOB -1
+
+namespace quicksc {
+
+	class SessionScheduler {
+
+	private:
+		static int current_job;				// Index of the job executed by the current process, or NO_JOB in the main process
+
+		Configurations* m_config_reference;
+		unsigned int m_workers;
+
+		static string getJobFileName(unsigned int job, string name, string extension);
+		pid_t launch(unsigned int job, std::function<int()> test_case);
+		void printOutput(unsigned int job);
+		void mergeLog(unsigned int jobs_count, string name);
+
+	public:
+		SessionScheduler(Configurations* configurations, unsigned int workers);
+		~SessionScheduler();
+
+		int run(std::function<int()> test_case);
+
+		static string getLogFileName(string name);
+		static string getTraceFileName();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_SESSIONSCHEDULER_HPP_ */
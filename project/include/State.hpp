@@ -29,6 +29,23 @@ using std::set;
 
 namespace quicksc {
 
+	class State;
+
+	/**
+	 * Interface of an object notified of the modifications of the states, e.g. to keep a versioned copy of an automaton.
+	 * The observer is set for a single thread (see State::setObserver): it receives the modifications made by that thread only.
+	 * A state is "modified" when its final flag or its exiting transitions change.
+	 */
+	class StateObserver {
+
+	public:
+		virtual ~StateObserver() {};
+
+		virtual void notifyModification(State* state) = 0;
+		virtual void notifyDestruction(State* state) = 0;
+
+	};
+
 	/**
 	 * Base class for a generic state in a generic automaton, that can be either a DFA or an NFA.
 	 * For DFAs obtained by determinization, the class ConstructedState is used instead.
@@ -44,6 +61,8 @@ namespace quicksc {
 
         State* getThis() const;
 
+		static thread_local StateObserver* observer;		// Observer of the modifications made by the current thread, or NULL
+
 	protected:
 		string m_name = "";									// Name of the state
 		bool m_final = false;								// This flag is true if the state is final, false otherwise
@@ -51,13 +70,14 @@ namespace quicksc {
 
     public:
 		State(string name, bool final = false);				// Constructor
-        ~State();											// Destructor
+        virtual ~State();										// Destructor
 
         string getName() const;
         bool isFinal();
         void setFinal(bool final);
 		bool connectChild(string label, State* child);
 		void disconnectChild(string label, State* child);
+		void disconnectChildren(string label);
 		void detachAllTransitions();
 		State* getChild(string label);
 		set<State*> getChildren(string label);
@@ -91,6 +111,9 @@ namespace quicksc {
 
 		virtual State* clone();
 
+		static void setObserver(StateObserver* observer);
+		static StateObserver* getObserver();
+
 		bool operator<(const State &other) const;
 		bool operator==(const State &other) const;
 		bool operator!=(const State &other) const;
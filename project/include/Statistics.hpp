@@ -30,6 +30,10 @@ namespace quicksc {
         SOL_SIZE,		// Size of the solution automaton obtained from the algorithm
         SOL_GROWTH,		// Ratio between the solution size and the original automaton size
         SOL_TR_COUNT,   // Number of transitions in the solution automaton
+        SOL_BOUND,      // Ratio between the solution size and the DFA size bound of the problem (zero if the bound is unknown)
+        GEN_TIME,       // Time spent to generate the problem (by the solver thread or by a generator thread of the pipeline) [ms]
+        GEN_WAIT,       // Time spent by the solver waiting for the generation of the problem [ms]
+        PERTURBATIONS,  // Number of transitions injected in the DFA of a perturbation problem (zero for the other problems)
 
         RESULTSTAT_END,
     };
@@ -49,6 +53,9 @@ namespace quicksc {
         UNIT_COUNT,     // Number of units processed in the execution, i.e. a transition for SC and a singularity for QSC
         VELOCITY,       // Units processing velocity of the algorithm, i.e. the ratio between the number of units processed and the execution time
         SCALE_FACTOR,   // The ratio between the velocity of the benchmark algorithm and the velocity of the algorithm
+        PEAK_HEAP,      // Maximum amount of heap memory used at the same time by the algorithm (measured on its thread)
+        ALLOCATIONS,    // Number of heap allocations performed by the algorithm
+        PEAK_RSS,       // Peak of the resident set size of the process during the execution of the algorithm
         /* Skip
         UNIT_PROCESSING_TIME, // Time spent by the algorithm to process a single unit of work, i.e. a transition for SC or a singularity for QSC
         CONVENIENCE,    // Convenience percentage of the algorithm w.r.t. the benchmark algorithm, i.e. the ratio between the two unit processing times
@@ -0,0 +1,180 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * StreamingNFAGenerator.hpp
+ *
+ *
+ * This header file contains the definition of the StreamingNFAGenerator class, child of the AutomataGenerator class,
+ * and of the sinks that receive the generated automata.
+ *
+ * The StreamingNFAGenerator is meant for large automata (10^6 - 10^7 states). Differently from the NFAGenerator:
+ * - the states are identified by their index, and the transitions are emitted as triples of indices
+ *   directly into a sink (a builder of Automaton objects, or a binary file), without intermediate copies;
+ * - the transitions are sampled without replacement, i.e. the same transition is never generated twice,
+ *   with a compact hash set of the generated transitions (O(m) time and memory, for m transitions);
+ * - the deterministic parts of the automata are guaranteed with a hash set of the used (state, label) pairs,
+ *   instead of the tables of unused labels.
+ * The original structures of the AutomatonType enumeration (from AUTOMATON_RANDOM to AUTOMATON_MASLOV) are supported,
+ * with the same semantics of the NFAGenerator; the structured families added later (n-th from the end, keywords, DFA union,
+ * power law, protocol) are not, and are rejected by "supportsStructure".
+ */
+
+#ifndef INCLUDE_STREAMINGNFAGENERATOR_HPP_
+#define INCLUDE_STREAMINGNFAGENERATOR_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+
+#include "AutomataGenerator.hpp"
+#include "AutomataSerializer.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Receiver of the automata generated by a StreamingNFAGenerator.
+	 * The calls are always in this order: "begin", then "addState" for all the states (in the order of their indices),
+	 * then "addTransition" for all the transitions, and finally "end".
+	 * The labels are passed as indices of the table received by "begin"; the label of index 0 is always EPSILON.
+	 */
+	class TransitionSink {
+
+	public:
+		virtual ~TransitionSink() {};
+
+		virtual void begin(unsigned long states_count, const vector<string>& labels, unsigned long initial_state) = 0;
+		virtual void addState(unsigned long index, bool final) = 0;
+		virtual void addTransition(unsigned long from, uint32_t label, unsigned long to) = 0;
+		virtual void end() = 0;
+
+	};
+
+	/**
+	 * Sink building an Automaton object in bulk.
+	 * The states are created once and connected by index, without any search by name.
+	 */
+	class AutomatonBuilder : public TransitionSink {
+
+	private:
+		string m_name_prefix;
+		Automaton* m_automaton = NULL;
+		vector<State*> m_states;
+		vector<string> m_labels;
+		unsigned long m_initial_state;
+
+	public:
+		AutomatonBuilder(string name_prefix);
+		~AutomatonBuilder();
+
+		void begin(unsigned long states_count, const vector<string>& labels, unsigned long initial_state) override;
+		void addState(unsigned long index, bool final) override;
+		void addTransition(unsigned long from, uint32_t label, unsigned long to) override;
+		void end() override;
+
+		Automaton* getAutomaton();
+
+	};
+
+	/**
+	 * Sink writing the automaton in a file, in the binary form of the AutomataSerializer.
+	 * The content is buffered in chunks, so the memory used does not depend on the size of the automaton.
+	 */
+	class BinaryFileSink : public TransitionSink {
+
+	private:
+		string m_name_prefix;
+		std::ofstream m_file;
+		BinaryWriter m_writer;
+		unsigned long m_states_count;
+		unsigned long m_initial_state;
+		unsigned long m_states_written;
+		unsigned long m_transitions_written;
+		std::streampos m_transitions_count_position;
+
+		void flush(bool force);
+
+	public:
+		BinaryFileSink(string file_name, string name_prefix);
+		~BinaryFileSink();
+
+		void begin(unsigned long states_count, const vector<string>& labels, unsigned long initial_state) override;
+		void addState(unsigned long index, bool final) override;
+		void addTransition(unsigned long from, uint32_t label, unsigned long to) override;
+		void end() override;
+
+		unsigned long getTransitionsCount();
+
+	};
+
+	/**
+	 * Open-addressing hash set of 64-bit keys, used to sample the transitions without replacement.
+	 * It uses linear probing on a table whose size is a power of two, and it grows when half full.
+	 */
+	class KeySet {
+
+	private:
+		vector<uint64_t> m_table;
+		unsigned long m_size;
+		uint64_t m_mask;
+
+		void grow();
+
+	public:
+		KeySet(unsigned long expected_size);
+		~KeySet();
+
+		bool insert(uint64_t key);
+		bool contains(uint64_t key);
+		unsigned long size();
+
+	};
+
+	class StreamingNFAGenerator : public AutomataGenerator {
+
+	private:
+		std::mt19937_64 m_random;
+		unsigned long m_states_count;
+		uint32_t m_labels_count;			// Number of labels, EPSILON included
+		double m_epsilon_probability;
+
+		unsigned long randomIndex(unsigned long bound);
+		uint32_t randomLabel();
+		uint32_t randomSymbol();
+		uint64_t transitionKey(unsigned long from, uint32_t label, unsigned long to);
+		uint64_t pairKey(unsigned long from, uint32_t label);
+
+		bool emitTransition(TransitionSink& sink, KeySet& transitions, unsigned long from, uint32_t label, unsigned long to);
+		void beginGeneration(TransitionSink& sink, const vector<string>& labels);
+		unsigned long computeTransitionsNumber();
+		vector<vector<unsigned long>> computeStrata();
+
+		void streamRandomAutomaton(TransitionSink& sink);
+		void streamStratifiedAutomaton(TransitionSink& sink, bool with_safe_zone);
+		void streamAcyclicAutomaton(TransitionSink& sink);
+		void streamWeakAutomaton(TransitionSink& sink);
+		void streamMaslovAutomaton(TransitionSink& sink);
+
+		Automaton* buildAutomaton(AutomatonType type);
+
+	public:
+		StreamingNFAGenerator(Alphabet alphabet, Configurations* configurations);
+		~StreamingNFAGenerator();
+
+		static bool supportsStructure(AutomatonType type);
+
+		void generate(TransitionSink& sink);
+		void generate(TransitionSink& sink, AutomatonType type);
+
+		Automaton* generateRandomAutomaton();
+		Automaton* generateStratifiedAutomaton();
+		Automaton* generateStratifiedWithSafeZoneAutomaton();
+		Automaton* generateAcyclicAutomaton();
+		Automaton* generateWeakAutomaton();
+		Automaton* generateMaslovAutomaton();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_STREAMINGNFAGENERATOR_HPP_ */
@@ -15,16 +15,21 @@
 
 #include "Automaton.hpp"
 #include "DeterminizationAlgorithm.hpp"
+#include "ProductAutomaton.hpp"
 
 namespace quicksc {
 
 	class SubsetConstruction : public DeterminizationAlgorithm {
 
+	private:
+		Automaton* construct(State* nfa_initial_state, ProductAutomaton* product);
+
 	public:
 		SubsetConstruction();
 		~SubsetConstruction();
 		
 		Automaton* run(Automaton* nfa);
+		Automaton* run(ProductAutomaton* product);
 
 	};
 }
@@ -0,0 +1,70 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * SymbolTable.hpp
+ *
+ *
+ * This header file contains the definition of the classes used to generate large alphabets.
+ *
+ * A SymbolTable represents an alphabet whose symbols are identified by integer IDs (0, 1, 2, ...).
+ * The string form of a symbol is never stored: it's computed from the ID only when requested, with the same
+ * encoding of the AlphabetGenerator (all the strings of length 1, then all the strings of length 2, and so on).
+ * Hence, the table occupies a constant space for any cardinality, and it can be converted to an Alphabet when needed.
+ *
+ * A SymbolSampler draws the IDs of the symbols with a given frequency distribution. The Zipf distribution with
+ * exponent "s" gives to the symbol of ID i a weight proportional to 1 / (i + 1)^s; with s = 0, the distribution is uniform.
+ * The sampling uses the alias method (Walker / Vose), with constant time per draw.
+ */
+
+#ifndef INCLUDE_SYMBOLTABLE_HPP_
+#define INCLUDE_SYMBOLTABLE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Alphabet.hpp"
+
+#define SYMBOL_NOT_FOUND 0xFFFFFFFF
+
+namespace quicksc {
+
+	class SymbolTable {
+
+	private:
+		std::string m_letters;
+		uint32_t m_cardinality;
+
+	public:
+		SymbolTable(uint32_t cardinality, const char* letters);
+		~SymbolTable();
+
+		uint32_t size();
+		std::string nameOf(uint32_t id);
+		uint32_t idOf(const std::string& name);
+		Alphabet toAlphabet();
+
+	};
+
+	class SymbolSampler {
+
+	private:
+		uint32_t m_cardinality;
+		double m_exponent;
+		std::vector<double> m_probabilities;	// Probability of keeping the column of the table, for each column
+		std::vector<uint32_t> m_aliases;		// Alternative symbol of each column
+
+	public:
+		SymbolSampler(uint32_t cardinality, double zipf_exponent);
+		~SymbolSampler();
+
+		bool isUniform();
+		uint32_t size();
+		uint32_t sample(uint32_t column, double coin);
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_SYMBOLTABLE_HPP_ */
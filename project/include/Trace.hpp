@@ -0,0 +1,105 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * Trace.hpp
+ *
+ *
+ * This header file contains the definition of a structured tracing layer, used to analyze where the time is spent
+ * during an execution. It offers two kinds of events:
+ * - spans, i.e. named intervals of time, opened by the TRACE_SPAN macro and closed at the end of the enclosing scope;
+ * - counters, i.e. named values sampled at a given instant, recorded by the TRACE_COUNTER macro.
+ *
+ * To activate the tracing, the TRACE_MODE macro must be defined for the whole program (with "make TRACE=1", after a "make clean").
+ * When it's not defined, all the macros expand to nothing and the tracing has no cost at all.
+ *
+ * Each thread records its events in its own buffer, made of fixed-size chunks that are never moved, so that no lock
+ * is required while recording. The events are exported in the Chrome trace format (JSON), which can be opened with
+ * "chrome://tracing" or with the Perfetto UI.
+ *
+ * The events of another process (e.g. of an isolated run, in a forked child) can be sent to the main process, which
+ * imports them in a dedicated track: in this way, a single file contains all the events of the execution.
+ *
+ * NOTE: the names of the events are not copied, so they must be string literals (or strings living until the export).
+ * NOTE: the buffers are allocated on the heap, so in a tracing build the memory measures include them.
+ */
+
+#ifndef INCLUDE_TRACE_HPP_
+#define INCLUDE_TRACE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quicksc {
+
+	/**
+	 * Event recorded by the tracing layer.
+	 */
+	struct TraceEvent {
+		const char* name;
+		char phase;							// 'X' for a span (a "complete" event), 'C' for a counter
+		uint64_t timestamp;					// Nanoseconds from the start of the tracing
+		uint64_t duration;					// Nanoseconds, for the spans
+		double value;						// Sampled value, for the counters
+	};
+
+	class Tracer {
+
+	public:
+		static uint64_t now();
+		static void recordSpan(const char* name, uint64_t start, uint64_t end);
+		static void recordCounter(const char* name, double value);
+		static void reset();
+		static bool exportChromeTrace(std::string file_name);
+		static std::vector<TraceEvent> getEvents();
+		static void importEvents(const std::vector<TraceEvent>& events);
+
+	};
+
+	/**
+	 * Span of the tracing layer.
+	 * It records an event covering the time between its construction and its destruction.
+	 */
+	class TraceSpan {
+
+	private:
+		const char* m_name;
+		uint64_t m_start;
+
+	public:
+		TraceSpan(const char* name) : m_name(name), m_start(Tracer::now()) {};
+		~TraceSpan() { Tracer::recordSpan(this->m_name, this->m_start, Tracer::now()); };
+
+	};
+
+	/** Generation of unique IDs for the span variables. It assumes there's only one span per line. */
+	#define _TRACE_CONCAT( x, y )				x ## y
+	#define TRACE_CONCAT( x, y )				_TRACE_CONCAT( x, y )
+
+#ifdef TRACE_MODE
+
+	/** Opens a span that lasts until the end of the current scope. */
+	#define TRACE_SPAN( name )					quicksc::TraceSpan TRACE_CONCAT( trace_span_, __LINE__ )( name )
+
+	/** Records the current value of a counter. */
+	#define TRACE_COUNTER( name, value )		quicksc::Tracer::recordCounter( name, value )
+
+	/** Writes all the events recorded so far in a file, in the Chrome trace format. */
+	#define TRACE_EXPORT( file_name )			quicksc::Tracer::exportChromeTrace( file_name )
+
+	/** Discards all the events recorded so far. It must be called when no other thread is recording. */
+	#define TRACE_RESET()						quicksc::Tracer::reset()
+
+#else
+
+	#define TRACE_SPAN( name )
+	#define TRACE_COUNTER( name, value )
+	#define TRACE_EXPORT( file_name )
+	#define TRACE_RESET()
+
+#endif
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_TRACE_HPP_ */
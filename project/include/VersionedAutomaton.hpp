@@ -0,0 +1,191 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * VersionedAutomaton.hpp
+ *
+ *
+ * This module lets other threads query an automaton while it's modified, e.g. by QSC during the restructuring.
+ *
+ * The states of an automaton are modified in place, so they cannot be read while a thread is changing them.
+ * A VersionedAutomaton keeps instead a sequence of immutable snapshots of the transition structure: the writer thread
+ * modifies the automaton as usual, and it publishes a new version with the "publish" method whenever it's consistent.
+ * The readers pin the current version, which stays valid (and unchanged) until they release it.
+ *
+ * - Snapshot: the states are numbered, and each one is stored as a row with its final flag and its transitions,
+ *   as pairs (label, child) sorted by label. The rows are grouped in chunks of fixed size, shared among the versions:
+ *   a new version copies only the chunks containing the states modified since the previous one.
+ * - Modifications: while attached, the VersionedAutomaton observes the states modified by the writer thread
+ *   (see StateObserver), so the cost of a publication depends on the modified states, not on the size of the automaton.
+ * - Reclamation (epochs): every publication increases a global epoch, and a reader announces the epoch at which it
+ *   pins a snapshot in one of a fixed set of slots. An old version, retired at epoch E, can be read only by the readers
+ *   that announced an epoch lower than E; hence, it's deleted as soon as no slot holds such an epoch.
+ *
+ * The class supports a single writer (the thread that attaches the automaton) and any number of readers.
+ * The observer set on the writer thread before the attachment keeps receiving the notifications, forwarded by the
+ * VersionedAutomaton, and it's restored by the detachment; hence, the attachments of a thread must be nested.
+ */
+
+#ifndef INCLUDE_VERSIONEDAUTOMATON_HPP_
+#define INCLUDE_VERSIONEDAUTOMATON_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "State.hpp"
+
+#define SNAPSHOT_CHUNK_SIZE			64			// Number of rows in a chunk
+#define SNAPSHOT_READER_SLOTS		64			// Maximum number of readers holding a snapshot at the same time
+#define SNAPSHOT_NO_STATE			0xFFFFFFFF
+#define SNAPSHOT_FREE_SLOT			0			// Value of a slot not used by any reader; the epochs start from 1
+
+namespace quicksc {
+
+	/**
+	 * State of a snapshot.
+	 */
+	struct SnapshotRow {
+		bool present = false;									// False if the number doesn't correspond to a state (anymore)
+		bool final = false;
+		std::vector<std::pair<uint32_t, uint32_t>> transitions;	// Pairs (label, child), sorted
+	};
+
+	/**
+	 * Group of consecutive rows, shared by all the snapshots where none of its states has been modified.
+	 */
+	struct SnapshotChunk {
+		SnapshotRow rows[SNAPSHOT_CHUNK_SIZE];
+	};
+
+	/**
+	 * Immutable version of the transition structure of an automaton.
+	 */
+	class AutomatonSnapshot {
+
+		friend class VersionedAutomaton;
+
+	private:
+		uint64_t m_version;
+		uint32_t m_initial_state;
+		uint32_t m_rows_count;
+		uint32_t m_states_count;
+		unsigned long m_transitions_count;
+		std::vector<std::shared_ptr<const SnapshotChunk>> m_chunks;
+		std::shared_ptr<const std::map<std::string, uint32_t>> m_labels;
+
+		const SnapshotRow& getRow(uint32_t state) const;
+		void addEpsilonClosure(std::set<uint32_t>& states) const;
+
+	public:
+		AutomatonSnapshot();
+		~AutomatonSnapshot();
+
+		uint64_t getVersion() const;
+		uint32_t getStatesCount() const;
+		unsigned long getTransitionsCount() const;
+		bool accepts(const std::vector<std::string>& word) const;
+
+	};
+
+	class VersionedAutomaton;
+
+	/**
+	 * Reference to a snapshot pinned by a reader. The snapshot is released when the guard is destroyed.
+	 */
+	class SnapshotGuard {
+
+	private:
+		VersionedAutomaton* m_owner;
+		unsigned int m_slot;
+		const AutomatonSnapshot* m_snapshot;
+
+	public:
+		SnapshotGuard(VersionedAutomaton* owner, unsigned int slot, const AutomatonSnapshot* snapshot);
+		SnapshotGuard(SnapshotGuard&& other);
+		SnapshotGuard(const SnapshotGuard& other) = delete;
+		~SnapshotGuard();
+
+		const AutomatonSnapshot* get() const;
+		const AutomatonSnapshot* operator->() const;
+
+	};
+
+	class VersionedAutomaton : public StateObserver {
+
+		friend class SnapshotGuard;
+		friend class ScopedAttachment;
+
+	private:
+		// Writer side
+		Automaton* m_automaton;
+		StateObserver* m_previous_observer;
+		std::map<State*, uint32_t> m_numbers;
+		uint32_t m_rows_count;
+		uint32_t m_states_count;
+		unsigned long m_transitions_count;
+		bool m_restart;													// True if the next version must not share the chunks of the previous one
+		std::set<State*> m_modified_states;
+		std::vector<uint32_t> m_destroyed_rows;
+		std::map<std::string, uint32_t> m_label_ids;
+		std::shared_ptr<const std::map<std::string, uint32_t>> m_labels;
+		std::vector<std::pair<uint64_t, AutomatonSnapshot*>> m_retired;	// Old versions, with the epoch of their retirement
+		unsigned long m_reclaimed_count;
+
+		// Shared with the readers
+		std::atomic<AutomatonSnapshot*> m_current;
+		std::atomic<uint64_t> m_epoch;
+		std::atomic<uint64_t> m_slots[SNAPSHOT_READER_SLOTS];
+
+		uint32_t getNumber(State* state, std::vector<State*>& to_build);
+		void reclaim();
+		void release(unsigned int slot);
+		void stopObserving();
+
+	public:
+		VersionedAutomaton();
+		~VersionedAutomaton();
+
+		void attach(Automaton* automaton);
+		void detach();
+		void publish();
+		SnapshotGuard pin();
+
+		uint64_t getVersion();
+		unsigned long getRetiredCount();
+		unsigned long getReclaimedCount();
+
+		void notifyModification(State* state);
+		void notifyDestruction(State* state);
+
+	};
+
+	/**
+	 * Attachment of an automaton to a VersionedAutomaton, for the duration of a scope.
+	 * The "detach" method publishes the last version; if the scope is left without calling it (e.g. for an exception),
+	 * the versioning is stopped without publishing, and the previous observer of the thread is restored anyway.
+	 * With a NULL VersionedAutomaton, the guard does nothing.
+	 */
+	class ScopedAttachment {
+
+	private:
+		VersionedAutomaton* m_versioned_automaton;
+
+	public:
+		ScopedAttachment(VersionedAutomaton* versioned_automaton, Automaton* automaton);
+		ScopedAttachment(const ScopedAttachment& other) = delete;
+		~ScopedAttachment();
+
+		void detach();
+
+	};
+
+} /* namespace quicksc */
+
+#endif /* INCLUDE_VERSIONEDAUTOMATON_HPP_ */
@@ -12,8 +12,6 @@
  * - the desidered length of the alphabet's symbols.
  */
 
-#include <cstring>
-
 #include "AlphabetGenerator.hpp"
 
 #include "Debug.hpp"
@@ -51,6 +49,18 @@ namespace quicksc {
 		return this->m_cardinality;
 	}
 
+	/**
+	 * Builds a table of symbols with the cardinality (=number of symbols of the alphabet) fixed,
+	 * starting from a base of n characters passed as a parameter.
+	 * [!] Note that these characters are passed as an array of char and require the terminal character '\0'.
+	 *
+	 * The symbols are identified by integer IDs, and their string forms are computed only when requested;
+	 * for this reason, this method is preferable to "generate" for very large alphabets (10^4 symbols and more).
+	 */
+	SymbolTable AlphabetGenerator::generateSymbols() {
+		return SymbolTable(this->m_cardinality, this->m_letters);
+	}
+
 	/**
 	 * Builds an alphabet with the cardinality (=number of symbols of the alphabet) fixed,
 	 * starting from a base of n characters passed as a parameter.
@@ -58,49 +68,13 @@ namespace quicksc {
 	 * 
 	 * The alphabet's symbols are built as a combination and concatenation of the characters,
 	 * starting with the combinations of shorter length.
+	 * The string forms are those of the table of symbols, ordered by ID.
 	 * 
 	 * Note: as an array of characters it is possible to use the array of characters "letters"
 	 * containing all and only the 26 lowercase letters of the English alphabet.
 	 */
 	Alphabet AlphabetGenerator::generate() {
-		std::vector<std::vector<string>> symbols;
-
-		// Initializing the set of strings of length zero
-		// This procedure is used only as a base step, but the null string will be removed
-		// at the end of the function because it is not required that the automaton contains epsilon transitions.
-		std::vector<string> zero_length_strings;
-		zero_length_strings.push_back("");
-		symbols.push_back(zero_length_strings);
-
-		// Count the number of symbols inserted in the alphabet (without considering the empty string)
-		int counter = 0;
-		// Until the size of the alphabet is less than the desired cardinality
-		while (counter < m_cardinality) {
-
-			// Prepare the vector that will contain the strings of the same size, generated by concatenating any character with any symbol of the previous set of strings.
-			std::vector<string> same_length_strings;
-
-			for (string prefix : symbols[symbols.size() - 1]) {
-
-				for (int l = 0; l < strlen(m_letters) && counter < m_cardinality; l++, counter++) {
-					string newlabel = (prefix + m_letters[l]);
-					same_length_strings.push_back(newlabel);
-				}
-			}
-
-			symbols.push_back(same_length_strings);
-		}
-
-		// Remove the set containing the empty string
-		symbols.erase(symbols.begin());
-
-		// Flatten the vector of vectors of strings
-		Alphabet alpha;
-		for (std::vector<string> string_set : symbols) {
-			for (string s : string_set)
-			alpha.push_back(s);
-		}
-
+		Alphabet alpha = this->generateSymbols().toAlphabet();
 		DEBUG_ASSERT_TRUE(alpha.size() == m_cardinality);
 		return alpha;
 	}
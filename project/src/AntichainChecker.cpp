@@ -0,0 +1,244 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AntichainChecker.cpp
+ *
+ *
+ * This source file contains the implementation of the AntichainChecker class.
+ */
+
+#include "AntichainChecker.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+#include "Trace.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 */
+	AntichainChecker::AntichainChecker() {
+		this->m_pruned_count = 0;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	AntichainChecker::~AntichainChecker() {}
+
+	/**
+	 * Private static method.
+	 * Returns the epsilon-closure of the states reached from the subset with the label.
+	 */
+	Extension AntichainChecker::computeLClosure(const Extension& subset, const std::string& label) {
+		Extension l_children;
+		for (State* state : subset) {
+			auto iterator = state->getExitingTransitionsRef().find(label);
+			if (iterator != state->getExitingTransitionsRef().end()) {
+				l_children.insert(iterator->second.begin(), iterator->second.end());
+			}
+		}
+		return ConstructedState::computeEpsilonClosure(l_children);
+	}
+
+	/**
+	 * Private static method.
+	 * Returns true if the first subset is contained in the second one.
+	 */
+	bool AntichainChecker::isSubset(const Extension& smaller, const Extension& larger) {
+		if (smaller.size() > larger.size()) {
+			return false;
+		}
+		return std::includes(larger.begin(), larger.end(), smaller.begin(), smaller.end(), State::Comparator());
+	}
+
+	/**
+	 * Private method.
+	 * Inserts a node in the antichain, unless a node with a smaller (or equal) subset is already there.
+	 * The nodes of the antichain with a larger subset are removed; if they have the same depth, they're also marked
+	 * as subsumed, so that they won't be expanded.
+	 * Returns true if the node has been inserted; in this case, the node is the last one of the vector of nodes.
+	 */
+	bool AntichainChecker::insertIntoAntichain(std::vector<unsigned long>& antichain, AntichainNode node) {
+		for (unsigned long index : antichain) {
+			if (AntichainChecker::isSubset(this->m_nodes[index].subset, node.subset)) {
+				this->m_pruned_count++;
+				return false;
+			}
+		}
+		unsigned long node_index = this->m_nodes.size();
+		auto last = std::remove_if(antichain.begin(), antichain.end(), [this, &node](unsigned long index) {
+			if (AntichainChecker::isSubset(node.subset, this->m_nodes[index].subset)) {
+				if (this->m_nodes[index].depth == node.depth) {
+					this->m_nodes[index].subsumed = true;
+					this->m_pruned_count++;
+				}
+				return true;
+			}
+			return false;
+		});
+		antichain.erase(last, antichain.end());
+		antichain.push_back(node_index);
+		this->m_nodes.push_back(node);
+		return true;
+	}
+
+	/**
+	 * Private method.
+	 * Fills the vector with the labels of the path from an initial node to the given node.
+	 * The epsilon-transitions are omitted.
+	 */
+	void AntichainChecker::buildCounterexample(unsigned long node_index, std::vector<std::string>* counterexample) {
+		if (counterexample == NULL) {
+			return;
+		}
+		counterexample->clear();
+		for (long index = node_index; this->m_nodes[index].parent >= 0; index = this->m_nodes[index].parent) {
+			if (this->m_nodes[index].label != EPSILON) {
+				counterexample->insert(counterexample->begin(), this->m_nodes[index].label);
+			}
+		}
+	}
+
+	/**
+	 * Checks whether the NFA accepts all the words over its own alphabet.
+	 * If it doesn't and a vector is passed as parameter, it's filled with a shortest rejected word.
+	 */
+	bool AntichainChecker::isUniversal(Automaton* nfa, std::vector<std::string>* counterexample) {
+		Alphabet alphabet;
+		for (std::string label : nfa->getAlphabet()) {
+			if (label != EPSILON) {
+				alphabet.push_back(label);
+			}
+		}
+		return this->isUniversal(nfa, alphabet, counterexample);
+	}
+
+	/**
+	 * Checks whether the NFA accepts all the words over the given alphabet.
+	 * If it doesn't and a vector is passed as parameter, it's filled with a shortest rejected word.
+	 */
+	bool AntichainChecker::isUniversal(Automaton* nfa, const Alphabet& alphabet, std::vector<std::string>* counterexample) {
+		TRACE_SPAN("Antichain universality");
+		DEBUG_ASSERT_NOT_NULL(nfa->getInitialState());
+		this->m_nodes.clear();
+		this->m_pruned_count = 0;
+		std::vector<unsigned long> antichain;
+		std::deque<unsigned long> queue;
+
+		Extension initial_subset = ConstructedState::computeEpsilonClosure(nfa->getInitialState());
+		this->insertIntoAntichain(antichain, { NULL, initial_subset, -1, 0, EPSILON, false });
+		if (!ConstructedState::hasFinalStates(initial_subset)) {
+			this->buildCounterexample(0, counterexample);
+			return false;
+		}
+		queue.push_back(0);
+
+		while (!queue.empty()) {
+			unsigned long current = queue.front();
+			queue.pop_front();
+			if (this->m_nodes[current].subsumed) {
+				continue;
+			}
+			for (const std::string& label : alphabet) {
+				Extension subset = AntichainChecker::computeLClosure(this->m_nodes[current].subset, label);
+				bool rejecting = !ConstructedState::hasFinalStates(subset);
+				if (this->insertIntoAntichain(antichain, { NULL, subset, (long) current, this->m_nodes[current].depth + 1, label, false })) {
+					unsigned long inserted = this->m_nodes.size() - 1;
+					if (rejecting) {
+						DEBUG_LOG("Found a rejecting subset after exploring %lu subsets", this->m_nodes.size());
+						this->buildCounterexample(inserted, counterexample);
+						return false;
+					}
+					queue.push_back(inserted);
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Checks whether the language of the first NFA is included in the language of the second one.
+	 * If it isn't and a vector is passed as parameter, it's filled with a shortest word accepted by the first NFA
+	 * and rejected by the second one (shortest when the first NFA has no epsilon-transitions, which count as steps of the visit).
+	 * The first NFA is explored as it is, state by state; only the second NFA is explored by subsets.
+	 */
+	bool AntichainChecker::isIncluded(Automaton* included, Automaton* including, std::vector<std::string>* counterexample) {
+		TRACE_SPAN("Antichain inclusion");
+		DEBUG_ASSERT_NOT_NULL(included->getInitialState());
+		DEBUG_ASSERT_NOT_NULL(including->getInitialState());
+		this->m_nodes.clear();
+		this->m_pruned_count = 0;
+		std::map<State*, std::vector<unsigned long>> antichains;		// An antichain for each state of the first NFA
+		std::deque<unsigned long> queue;
+
+		Extension initial_subset = ConstructedState::computeEpsilonClosure(including->getInitialState());
+		State* initial_state = included->getInitialState();
+		this->insertIntoAntichain(antichains[initial_state], { initial_state, initial_subset, -1, 0, EPSILON, false });
+		if (initial_state->isFinal() && !ConstructedState::hasFinalStates(initial_subset)) {
+			this->buildCounterexample(0, counterexample);
+			return false;
+		}
+		queue.push_back(0);
+
+		while (!queue.empty()) {
+			unsigned long current = queue.front();
+			queue.pop_front();
+			if (this->m_nodes[current].subsumed) {
+				continue;
+			}
+			State* state = this->m_nodes[current].state;
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (pair.second.empty()) {
+					continue;
+				}
+				// The epsilon-transitions of the first NFA move only its state; the others move both the NFAs
+				Extension subset = (pair.first == EPSILON)
+						? this->m_nodes[current].subset
+						: AntichainChecker::computeLClosure(this->m_nodes[current].subset, pair.first);
+				bool subset_rejecting = !ConstructedState::hasFinalStates(subset);
+				for (State* child : pair.second) {
+					if (this->insertIntoAntichain(antichains[child], { child, subset, (long) current, this->m_nodes[current].depth + 1, pair.first, false })) {
+						unsigned long inserted = this->m_nodes.size() - 1;
+						if (child->isFinal() && subset_rejecting) {
+							DEBUG_LOG("Found a counterexample after exploring %lu pairs", this->m_nodes.size());
+							this->buildCounterexample(inserted, counterexample);
+							return false;
+						}
+						queue.push_back(inserted);
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Checks whether the two NFAs accept the same language, with the inclusion check in both directions.
+	 * If they don't and a vector is passed as parameter, it's filled with a word accepted by only one of them.
+	 */
+	bool AntichainChecker::isEquivalent(Automaton* first, Automaton* second, std::vector<std::string>* counterexample) {
+		return this->isIncluded(first, second, counterexample) && this->isIncluded(second, first, counterexample);
+	}
+
+	/**
+	 * Returns the number of nodes (subsets, or pairs of a state and a subset) explored by the last check.
+	 */
+	unsigned long AntichainChecker::getExploredCount() {
+		return this->m_nodes.size();
+	}
+
+	/**
+	 * Returns the number of nodes discarded by the last check, because subsumed by a node with a smaller subset.
+	 */
+	unsigned long AntichainChecker::getPrunedCount() {
+		return this->m_pruned_count;
+	}
+
+} /* namespace quicksc */
@@ -26,8 +26,11 @@ namespace quicksc {
 	 * Since the alphabet is generated by another class, it is better to make this class independent from it.
 	 * For this reason, the constructor accepts an already generated alphabet.
 	 * The programmer can change the alphabet with the setter methods.
+	 * The labels are drawn with the Zipf distribution of the exponent specified in the configurations (uniformly, if it's zero),
+	 * where the first symbol of the alphabet is the most frequent one.
 	 */
-	AutomataGenerator::AutomataGenerator(Alphabet alphabet, Configurations* configurations) {
+	AutomataGenerator::AutomataGenerator(Alphabet alphabet, Configurations* configurations)
+			: m_symbol_sampler(alphabet.size(), configurations->valueOf<double>(AlphabetZipfExponent)) {
 		this->m_configurations = configurations;
 		this->m_alphabet = alphabet;
 		this->m_automaton_structure = (AutomatonType) configurations->valueOf<int>(AutomatonStructure);
@@ -38,6 +41,7 @@ namespace quicksc {
 		this->m_final_probability = configurations->valueOf<double>(AutomatonFinalProbability);
 		this->m_max_distance = configurations->valueOf<int>(AutomatonMaxDistance);
 		this->m_safe_zone_distance = configurations->valueOf<int>(AutomatonSafeZoneDistance);
+		this->m_components = configurations->valueOf<int>(AutomatonComponents);
 	}
 
 	/**
@@ -76,12 +80,26 @@ namespace quicksc {
 		return (static_cast <double> (rand()) / static_cast <double> (RAND_MAX));
 	}
 
+	/**
+	 * Protected method.
+	 * Returns the index of a random symbol of the alphabet, drawn with the frequency distribution of the configurations.
+	 * With the uniform distribution, a single random number is extracted, so the random sequence is the same of a plain modulo.
+	 */
+	unsigned int AutomataGenerator::getRandomSymbolIndex() {
+		unsigned int column = rand() % this->m_alphabet.size();
+		if (this->m_symbol_sampler.isUniform()) {
+			return column;
+		}
+		double coin = static_cast <double> (rand()) / (static_cast <double> (RAND_MAX) + 1.0);
+		return this->m_symbol_sampler.sample(column, coin);
+	}
+
 	/**
 	 * Protected method.
 	 * Returns a random label chosen from the labels of the alphabet set for the generation of automata.
 	 */
 	string AutomataGenerator::getRandomLabelFromAlphabet() {
-		return (m_alphabet[rand() % m_alphabet.size()]);
+		return this->m_alphabet[this->getRandomSymbolIndex()];
 	}
 
 	/**
@@ -107,11 +125,24 @@ namespace quicksc {
 		return (n < this->getSize() - 1) ? (this->getSize() - 1) : (n);
 	}
 
+	/**
+	 * Protected static method.
+	 * Returns 2 to the power of the exponent, or DFA_SIZE_UNKNOWN if the result cannot be represented.
+	 * It's used to compute the bounds of the DFA sizes, which are often exponential in the size of the NFA.
+	 */
+	unsigned long int AutomataGenerator::saturatedPowerOfTwo(unsigned long int exponent) {
+		if (exponent >= 8 * sizeof(unsigned long int) - 1) {
+			return DFA_SIZE_UNKNOWN;
+		}
+		return 1UL << exponent;
+	}
+
 	/**
 	 * Getter method.
 	 * Returns the alphabet used to generate the automata.
+	 * The alphabet is returned by reference, since it's accessed at every label drawn and it can be very large.
 	 */
-	Alphabet AutomataGenerator::getAlphabet() {
+	const Alphabet& AutomataGenerator::getAlphabet() {
 		return this->m_alphabet;
 	};
 
@@ -129,6 +160,14 @@ namespace quicksc {
 		return this->m_size;
 	}
 
+	/**
+	 * Setter method for the size of the automaton.
+	 * It's used when an automaton is composed by smaller automata, generated by another generator.
+	 */
+	void AutomataGenerator::setSize(unsigned long int size) {
+		this->m_size = size;
+	}
+
 	/**
 	 * Getter method for the prefix of the names of the states of the automaton.
 	 */
@@ -181,6 +220,23 @@ namespace quicksc {
 		return this->m_safe_zone_distance;
 	}
 
+	/**
+	 * Getter method for the number of components of the automaton.
+	 * This parameter is used only for the automata composed by parts (unions of DFAs, protocols with phases).
+	 */
+	unsigned int AutomataGenerator::getComponents() {
+		return this->m_components;
+	}
+
+	/**
+	 * Returns an upper bound of the number of states of the DFA obtained from the last generated automaton
+	 * (by Subset Construction, without minimization), or DFA_SIZE_UNKNOWN if the structure does not provide one.
+	 * For some structures (e.g. the "n-th symbol from the end" automata) the bound is exact.
+	 */
+	unsigned long int AutomataGenerator::getDFASizeBound() {
+		return this->m_dfa_size_bound;
+	}
+
 	/**
 	 * Returns an automaton of the desired type.
 	 * In short, this method is responsible for delegating the creation of the automaton to the other methods of the class, 
@@ -191,6 +247,8 @@ namespace quicksc {
 	 * for DFA automata or for NFA automata.
 	 */
 	Automaton* AutomataGenerator::generateAutomaton() {
+		// The structures that know a bound of the DFA size set it during the generation
+		this->m_dfa_size_bound = DFA_SIZE_UNKNOWN;
 		switch(this->getAutomatonStructure()) {
 
 		case AUTOMATON_RANDOM :
@@ -211,6 +269,21 @@ namespace quicksc {
 		case AUTOMATON_MASLOV :
 			return this->generateMaslovAutomaton();
 
+		case AUTOMATON_NTH_FROM_END :
+			return this->generateNthFromEndAutomaton();
+
+		case AUTOMATON_KEYWORDS :
+			return this->generateKeywordsAutomaton();
+
+		case AUTOMATON_DFA_UNION :
+			return this->generateDFAUnionAutomaton();
+
+		case AUTOMATON_POWER_LAW :
+			return this->generatePowerLawAutomaton();
+
+		case AUTOMATON_PROTOCOL :
+			return this->generateProtocolAutomaton();
+
 		default :
 			DEBUG_LOG_ERROR("Unknown value %d in enumeration <AutomatonType>", this->getAutomatonStructure());
 			return NULL;
@@ -245,5 +318,25 @@ namespace quicksc {
 		AUTOMATON_GENERATION_EXCEPTION(Maslov);
 	}
 
+	Automaton* AutomataGenerator::generateNthFromEndAutomaton() {
+		AUTOMATON_GENERATION_EXCEPTION(NthFromEnd);
+	}
+
+	Automaton* AutomataGenerator::generateKeywordsAutomaton() {
+		AUTOMATON_GENERATION_EXCEPTION(Keywords);
+	}
+
+	Automaton* AutomataGenerator::generateDFAUnionAutomaton() {
+		AUTOMATON_GENERATION_EXCEPTION(DFAUnion);
+	}
+
+	Automaton* AutomataGenerator::generatePowerLawAutomaton() {
+		AUTOMATON_GENERATION_EXCEPTION(PowerLaw);
+	}
+
+	Automaton* AutomataGenerator::generateProtocolAutomaton() {
+		AUTOMATON_GENERATION_EXCEPTION(Protocol);
+	}
+
 
 } /* namespace quicksc */
@@ -15,6 +15,7 @@
 
 #include "AutomataGeneratorNFA.hpp"
 
+#include <climits>
 #include <cmath>
 #include "AutomataGeneratorDFA.hpp"
 #include "Configurations.hpp"
@@ -24,6 +25,7 @@
 
 #define RANDOM_PERCENTAGE ((double) rand() / (RAND_MAX))
 #define INTRA_STRATUM_TRANSITIONS_PERCENTAGE 0.5
+#define MAX_GENERATION_ATTEMPTS 1000
 
 namespace quicksc {
 
@@ -344,7 +346,7 @@ namespace quicksc {
 					if (RANDOM_PERCENTAGE <= this->getEpsilonProbability()) {
 						random_label = EPSILON;
 					} else {
-						random_label = this->getAlphabet()[rand() % this->getAlphabet().size()];
+						random_label = this->getRandomLabelFromAlphabet();
 					}
 
 					nfa->connectStates(parent, state, random_label);
@@ -384,7 +386,7 @@ namespace quicksc {
 				if (RANDOM_PERCENTAGE <= this->getEpsilonProbability()) {
 					label = EPSILON;
 				} else {
-					label = this->getAlphabet()[rand() % this->getAlphabet().size()];
+					label = this->getRandomLabelFromAlphabet();
 				}
 
 			}
@@ -546,6 +548,269 @@ namespace quicksc {
 		// Setting the initial state
 		nfa->setInitialState(states[0]);
 
+		// The DFA has a state for each subset of the chain of states, together with the first state
+		this->m_dfa_size_bound = saturatedPowerOfTwo(states.size() - 1);
+
+		return nfa;
+	}
+
+	/**
+	 * Generates a NFA recognizing the strings whose n-th symbol from the end is the first symbol of the alphabet.
+	 * It generalizes the Maslov topology to the whole alphabet, with n = size - 1:
+	 * - the initial state has a self-loop for each symbol, and a transition with the first symbol to the second state;
+	 * - each one of the following states is connected to the next one with all the symbols;
+	 * - the last state is the only final state, and it has no outgoing transitions.
+	 * The DFA has exactly 2^n states, since it has to remember which ones of the last n symbols were the first symbol.
+	 * This requires at least 2 symbols: with a single symbol the DFA has only n + 1 states, so such an alphabet is rejected.
+	 */
+	Automaton* NFAGenerator::generateNthFromEndAutomaton() {
+		if (this->getSize() < 2) {
+			DEBUG_LOG_ERROR("Cannot generate a \"n-th symbol from the end\" automaton with less than 2 states");
+			throw "Cannot generate a \"n-th symbol from the end\" automaton with less than 2 states";
+		}
+		if (this->getAlphabet().size() < 2) {
+			DEBUG_LOG_ERROR("Cannot generate a \"n-th symbol from the end\" automaton with less than 2 symbols");
+			throw "Cannot generate a \"n-th symbol from the end\" automaton with less than 2 symbols";
+		}
+		Automaton* nfa = new Automaton();
+		vector<State*> states;
+		for (unsigned long int s = 0; s < this->getSize(); s++) {
+			states.push_back(this->createState(nfa, (s == this->getSize() - 1)));
+		}
+
+		const Alphabet& alphabet = this->getAlphabet();
+		for (string label : alphabet) {
+			nfa->connectStates(states[0], states[0], label);
+			for (unsigned long int s = 1; s < states.size() - 1; s++) {
+				nfa->connectStates(states[s], states[s + 1], label);
+			}
+		}
+		nfa->connectStates(states[0], states[1], alphabet[0]);
+
+		nfa->setInitialState(states[0]);
+		this->m_dfa_size_bound = saturatedPowerOfTwo(states.size() - 1);
+
+		return nfa;
+	}
+
+	/**
+	 * Generates a NFA recognizing the strings ending with a keyword of a random dictionary.
+	 * The NFA is the trie of the keywords, where the root (the initial state) has a self-loop for each symbol;
+	 * the states where a keyword ends are final.
+	 * The keywords are added until the trie reaches the requested size; their length is random between 1 and "maxDistance",
+	 * and their symbols follow the frequency distribution of the labels.
+	 * Each state of the DFA is identified by the longest suffix of the input that is a prefix of a keyword,
+	 * so the DFA has at most as many states as the trie.
+	 */
+	Automaton* NFAGenerator::generateKeywordsAutomaton() {
+		Automaton* nfa = new Automaton();
+		State* root = this->createState(nfa, false);
+		for (string label : this->getAlphabet()) {
+			nfa->connectStates(root, root, label);
+		}
+
+		// Children of the trie nodes, separated from the self-loops of the root
+		map<State*, map<string, State*>> trie_children;
+		unsigned int max_length = (this->getMaxDistance() > 0) ? this->getMaxDistance() : 1;
+		unsigned int failures = 0;
+		while ((unsigned long int) nfa->size() < this->getSize() && failures < MAX_GENERATION_ATTEMPTS) {
+			unsigned int length = 1 + rand() % max_length;
+			State* node = root;
+			bool new_node = false;
+			for (unsigned int c = 0; c < length && (unsigned long int) nfa->size() < this->getSize(); c++) {
+				string label = this->getRandomLabelFromAlphabet();
+				auto child = trie_children[node].find(label);
+				if (child == trie_children[node].end()) {
+					State* next = this->createState(nfa, false);
+					nfa->connectStates(node, next, label);
+					trie_children[node][label] = next;
+					node = next;
+					new_node = true;
+				} else {
+					node = child->second;
+				}
+			}
+			if (node != root) {
+				node->setFinal(true);
+			}
+			failures = new_node ? 0 : failures + 1;
+		}
+		DEBUG_LOG("Generated a trie of %d nodes over %lu requested", nfa->size(), this->getSize());
+
+		nfa->setInitialState(root);
+		this->m_dfa_size_bound = nfa->size();
+
+		return nfa;
+	}
+
+	/**
+	 * Generates the union of k random DFAs, where k is the number of components.
+	 * The states of the DFAs (whose sizes sum up to size - 1) are copied in the NFA, and a new initial state
+	 * receives the outgoing transitions of all the initial states of the DFAs; it's final if one of them is final.
+	 * A state of the DFA of the union corresponds to a tuple with a state (or none) of each component,
+	 * so its size is at most the product of (size of the component + 1).
+	 */
+	Automaton* NFAGenerator::generateDFAUnionAutomaton() {
+		if (this->getSize() < 2) {
+			DEBUG_LOG_ERROR("Cannot generate a union of DFAs with less than 2 states");
+			throw "Cannot generate a union of DFAs with less than 2 states";
+		}
+		Automaton* nfa = new Automaton();
+		State* initial = this->createState(nfa, false);
+		DFAGenerator* dfa_generator = new DFAGenerator(this->getAlphabet(), this->m_configurations);
+
+		double bound = 1;
+		for (unsigned long int component_size : this->splitSize(this->getSize() - 1, this->getComponents())) {
+			dfa_generator->setSize(component_size);
+			Automaton* dfa = dfa_generator->generateRandomAutomaton();
+			vector<State*> dfa_states = dfa->getStatesVector();
+
+			// Copy of the states and of the transitions
+			map<State*, State*> copies;
+			for (State* s : dfa_states) {
+				copies[s] = this->createState(nfa, s->isFinal());
+			}
+			for (State* s : dfa_states) {
+				for (auto &pair : s->getExitingTransitionsRef()) {
+					for (State* child : pair.second) {
+						nfa->connectStates(copies[s], copies[child], pair.first);
+					}
+				}
+			}
+
+			// Connection to the initial state of the union
+			State* dfa_initial = dfa->getInitialState();
+			for (auto &pair : dfa_initial->getExitingTransitionsRef()) {
+				for (State* child : pair.second) {
+					nfa->connectStates(initial, copies[child], pair.first);
+				}
+			}
+			if (dfa_initial->isFinal()) {
+				initial->setFinal(true);
+			}
+
+			// The DFA is deleted, together with its states
+			delete dfa;
+			for (State* s : dfa_states) {
+				delete s;
+			}
+			bound *= (component_size + 1);
+		}
+		delete dfa_generator;
+
+		nfa->setInitialState(initial);
+		this->m_dfa_size_bound = (bound < (double) ULONG_MAX) ? ((unsigned long int) bound) : DFA_SIZE_UNKNOWN;
+
+		return nfa;
+	}
+
+	/**
+	 * Generates a NFA whose states have a power-law degree distribution, by preferential attachment:
+	 * the origin of a transition is chosen with probability proportional to its out-degree (+1),
+	 * and the destination with probability proportional to its in-degree (+1).
+	 * The first transitions connect each state to a previous one, guaranteeing the reachability;
+	 * the number of transitions and the labels follow the same rules of the random automata.
+	 * The structure does not provide any bound of the DFA size better than 2^size.
+	 */
+	Automaton* NFAGenerator::generatePowerLawAutomaton() {
+		Automaton* nfa = new Automaton();
+		this->generateStates(nfa);
+		vector<State*> states = nfa->getStatesVector();
+		DEBUG_ASSERT_TRUE( this->getSize() == nfa->size() );
+
+		// Each state appears in the lists once, plus once for each transition it has (as origin or as destination)
+		vector<State*> origins = vector<State*>();
+		vector<State*> destinations = vector<State*>();
+		origins.push_back(states[0]);
+		destinations.push_back(states[0]);
+
+		// Satisfaction of the REACHABILITY property
+		for (unsigned long int i = 1; i < states.size(); i++) {
+			State* parent = origins[rand() % origins.size()];
+			nfa->connectStates(parent, states[i], this->getRandomLabel());
+			origins.push_back(parent);
+			origins.push_back(states[i]);
+			destinations.push_back(states[i]);
+			destinations.push_back(states[i]);
+		}
+
+		// Satisfaction of the NUMBER OF TRANSITIONS property
+		unsigned long int transitions_number = this->computeDeterministicTransitionsNumber();
+		for (	unsigned long int transitions_created = this->getSize() - 1;
+				transitions_created < transitions_number;
+				transitions_created++) {
+			State* from = origins[rand() % origins.size()];
+			State* to = destinations[rand() % destinations.size()];
+			nfa->connectStates(from, to, this->getRandomLabel());
+			origins.push_back(from);
+			destinations.push_back(to);
+		}
+
+		nfa->setInitialState(states[0]);
+		this->m_dfa_size_bound = saturatedPowerOfTwo(states.size());
+
+		return nfa;
+	}
+
+	/**
+	 * Generates a protocol-like NFA, composed by k phases, where k is the number of components.
+	 * Each phase is a cycle of states connected by deterministic transitions, labeled with any symbol but the first one.
+	 * The first symbol of the alphabet is reserved to the handshakes: the last state of each phase is connected
+	 * with it to the first state of the next phase (and the last phase to the first one).
+	 * The non-determinism is given by "retry" transitions (possibly epsilon) that go back to a previous state of the same phase;
+	 * they're as many as the transitions of a random automaton of the same size.
+	 * Since no transition but the handshakes leaves a phase, each state of the DFA is a subset of a single phase,
+	 * so its size is at most 1 + the sum of (2^(size of the phase) - 1).
+	 */
+	Automaton* NFAGenerator::generateProtocolAutomaton() {
+		const Alphabet& alphabet = this->getAlphabet();
+		if (alphabet.size() < 2) {
+			DEBUG_LOG_ERROR("Cannot generate a protocol automaton with less than 2 symbols");
+			throw "Cannot generate a protocol automaton with less than 2 symbols";
+		}
+		Automaton* nfa = new Automaton();
+		vector<vector<State*>> phases;
+		for (unsigned long int phase_size : this->splitSize(this->getSize(), this->getComponents())) {
+			vector<State*> phase;
+			for (unsigned long int s = 0; s < phase_size; s++) {
+				phase.push_back(this->createState(nfa, this->generateNormalizedDouble() < this->getFinalProbability()));
+			}
+			phases.push_back(phase);
+		}
+		phases.back().back()->setFinal(true);
+
+		// Cycles of the phases and handshakes
+		for (unsigned long int p = 0; p < phases.size(); p++) {
+			vector<State*>& phase = phases[p];
+			for (unsigned long int s = 0; s < phase.size(); s++) {
+				string label = alphabet[1 + rand() % (alphabet.size() - 1)];
+				nfa->connectStates(phase[s], phase[(s + 1) % phase.size()], label);
+			}
+			nfa->connectStates(phase.back(), phases[(p + 1) % phases.size()].front(), alphabet[0]);
+		}
+
+		// Retry transitions
+		unsigned long int retries_number = this->computeDeterministicTransitionsNumber();
+		for (unsigned long int retries_created = 0; retries_created < retries_number; retries_created++) {
+			vector<State*>& phase = phases[rand() % phases.size()];
+			int from_index = rand() % phase.size();
+			int to_index = rand() % (from_index + 1);
+			string label;
+			if (RANDOM_PERCENTAGE <= this->getEpsilonProbability()) {
+				label = EPSILON;
+			} else {
+				label = alphabet[1 + rand() % (alphabet.size() - 1)];
+			}
+			nfa->connectStates(phase[from_index], phase[to_index], label);
+		}
+
+		nfa->setInitialState(phases[0][0]);
+		double bound = 1;
+		for (vector<State*>& phase : phases) {
+			bound += std::pow(2.0, phase.size()) - 1;
+		}
+		this->m_dfa_size_bound = (bound < (double) ULONG_MAX) ? ((unsigned long int) bound) : DFA_SIZE_UNKNOWN;
+
 		return nfa;
 	}
 
@@ -571,6 +836,33 @@ namespace quicksc {
 		}
 	}
 
+	/**
+	 * Creates a new state with a unique name, and inserts it into the NFA passed as parameter.
+	 */
+	State* NFAGenerator::createState(Automaton* nfa, bool final) {
+		State* state = new State(this->generateUniqueName(), final);
+		nfa->addState(state);
+		return state;
+	}
+
+	/**
+	 * Splits a size in (at most) the requested number of parts, as balanced as possible.
+	 * Each part contains at least one unit.
+	 */
+	vector<unsigned long int> NFAGenerator::splitSize(unsigned long int size, unsigned int parts) {
+		if (parts == 0) {
+			parts = 1;
+		}
+		if (parts > size) {
+			parts = size;
+		}
+		vector<unsigned long int> sizes;
+		for (unsigned int p = 0; p < parts; p++) {
+			sizes.push_back(size / parts + ((p < size % parts) ? 1 : 0));
+		}
+		return sizes;
+	}
+
 	/**
 	 * Extracts a random state from the NFA passed as parameter.
 	 * NOTE: This method requires the construction of the vector of states of the automaton at each call,
@@ -668,7 +960,7 @@ namespace quicksc {
 		if (RANDOM_PERCENTAGE <= this->getEpsilonProbability()) {
 			return EPSILON;
 		} else {
-			return this->getAlphabet()[rand() % this->getAlphabet().size()];
+			return this->getRandomLabelFromAlphabet();
 		}
 	}
 
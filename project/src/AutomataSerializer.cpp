@@ -0,0 +1,335 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AutomataSerializer.cpp
+ *
+ *
+ * This source file contains the implementation of the classes BinaryWriter, BinaryReader and AutomataSerializer.
+ */
+
+#include "AutomataSerializer.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+using namespace std;
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 */
+	BinaryWriter::BinaryWriter() {
+		this->m_buffer = string();
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BinaryWriter::~BinaryWriter() {}
+
+	/**
+	 * Appends an unsigned integer of 32 bits.
+	 */
+	void BinaryWriter::writeUInt32(uint32_t value) {
+		this->m_buffer.append((const char*) &value, sizeof(value));
+	}
+
+	/**
+	 * Appends an unsigned integer of 64 bits.
+	 */
+	void BinaryWriter::writeUInt64(uint64_t value) {
+		this->m_buffer.append((const char*) &value, sizeof(value));
+	}
+
+	/**
+	 * Appends a floating point value.
+	 */
+	void BinaryWriter::writeDouble(double value) {
+		this->m_buffer.append((const char*) &value, sizeof(value));
+	}
+
+	/**
+	 * Appends a string, prefixed by its length.
+	 */
+	void BinaryWriter::writeString(const string& value) {
+		this->writeUInt32((uint32_t) value.length());
+		this->m_buffer.append(value);
+	}
+
+	/**
+	 * Appends a sequence of bytes, prefixed by its length.
+	 * It's equivalent to the writing of a string, but it makes explicit that the content is binary.
+	 */
+	void BinaryWriter::writeBytes(const string& bytes) {
+		this->writeString(bytes);
+	}
+
+	/**
+	 * Returns the buffer containing all the written values.
+	 */
+	const string& BinaryWriter::getBuffer() {
+		return this->m_buffer;
+	}
+
+	/**
+	 * Empties the buffer, e.g. after its content has been written on a file.
+	 */
+	void BinaryWriter::clear() {
+		this->m_buffer.clear();
+	}
+
+	/**
+	 * Constructor.
+	 * The reader keeps a reference to the buffer, which must not be destroyed while reading.
+	 */
+	BinaryReader::BinaryReader(const string& buffer) : m_buffer(buffer) {
+		this->m_position = 0;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BinaryReader::~BinaryReader() {}
+
+	/**
+	 * Private method.
+	 * Checks that the buffer contains at least "length" bytes after the current position.
+	 */
+	void BinaryReader::checkAvailable(size_t length) {
+		if (this->m_position + length > this->m_buffer.length()) {
+			DEBUG_LOG_ERROR("Cannot read %lu bytes from position %lu of a buffer of %lu bytes", length, this->m_position, this->m_buffer.length());
+			throw "Unexpected end of the binary buffer";
+		}
+	}
+
+	/**
+	 * Reads an unsigned integer of 32 bits.
+	 */
+	uint32_t BinaryReader::readUInt32() {
+		uint32_t value;
+		this->checkAvailable(sizeof(value));
+		memcpy(&value, this->m_buffer.data() + this->m_position, sizeof(value));
+		this->m_position += sizeof(value);
+		return value;
+	}
+
+	/**
+	 * Reads an unsigned integer of 64 bits.
+	 */
+	uint64_t BinaryReader::readUInt64() {
+		uint64_t value;
+		this->checkAvailable(sizeof(value));
+		memcpy(&value, this->m_buffer.data() + this->m_position, sizeof(value));
+		this->m_position += sizeof(value);
+		return value;
+	}
+
+	/**
+	 * Reads a floating point value.
+	 */
+	double BinaryReader::readDouble() {
+		double value;
+		this->checkAvailable(sizeof(value));
+		memcpy(&value, this->m_buffer.data() + this->m_position, sizeof(value));
+		this->m_position += sizeof(value);
+		return value;
+	}
+
+	/**
+	 * Reads a string prefixed by its length.
+	 */
+	string BinaryReader::readString() {
+		uint32_t length = this->readUInt32();
+		this->checkAvailable(length);
+		string value = this->m_buffer.substr(this->m_position, length);
+		this->m_position += length;
+		return value;
+	}
+
+	/**
+	 * Returns true if there are still bytes to read.
+	 */
+	bool BinaryReader::hasMore() {
+		return this->m_position < this->m_buffer.length();
+	}
+
+	/**
+	 * Static method.
+	 * Writes the binary form of the automaton with the writer passed as parameter.
+	 */
+	void AutomataSerializer::writeAutomaton(BinaryWriter& writer, Automaton* automaton) {
+		DEBUG_ASSERT_NOT_NULL(automaton);
+		vector<State*> states = automaton->getStatesVector();
+
+		// Indexing the states and the labels
+		map<State*, uint32_t> state_indices;
+		for (uint32_t i = 0; i < states.size(); i++) {
+			state_indices[states[i]] = i;
+		}
+		map<string, uint32_t> label_indices;
+		vector<string> labels;
+		vector<uint32_t> transitions;
+		for (State* state : states) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (label_indices.count(pair.first) == 0) {
+					label_indices[pair.first] = labels.size();
+					labels.push_back(pair.first);
+				}
+				for (State* child : pair.second) {
+					transitions.push_back(state_indices[state]);
+					transitions.push_back(label_indices[pair.first]);
+					transitions.push_back(state_indices[child]);
+				}
+			}
+		}
+
+		writer.writeUInt32(AUTOMATON_MAGIC_NUMBER);
+		writer.writeUInt32(AUTOMATON_FORMAT_VERSION);
+
+		writer.writeUInt32(labels.size());
+		for (string& label : labels) {
+			writer.writeString(label);
+		}
+
+		writer.writeUInt32(states.size());
+		for (State* state : states) {
+			writer.writeString(state->getName());
+			writer.writeUInt32(state->isFinal() ? 1 : 0);
+		}
+
+		State* initial_state = automaton->getInitialState();
+		writer.writeUInt32(initial_state != NULL ? state_indices[initial_state] : NO_INITIAL_STATE);
+
+		writer.writeUInt32(transitions.size() / 3);
+		for (uint32_t value : transitions) {
+			writer.writeUInt32(value);
+		}
+	}
+
+	/**
+	 * Static method.
+	 * Reads an automaton in binary form with the reader passed as parameter.
+	 * The states of the new automaton are instances of the base class State, even if the original states were constructed ones.
+	 */
+	Automaton* AutomataSerializer::readAutomaton(BinaryReader& reader) {
+		if (reader.readUInt32() != AUTOMATON_MAGIC_NUMBER) {
+			DEBUG_LOG_ERROR("The buffer does not contain an automaton in binary form");
+			throw "Invalid binary form of an automaton";
+		}
+		uint32_t version = reader.readUInt32();
+		if (version != AUTOMATON_FORMAT_VERSION) {
+			DEBUG_LOG_ERROR("The version %u of the binary format is not supported", version);
+			throw "Unsupported version of the binary form of an automaton";
+		}
+
+		uint32_t labels_count = reader.readUInt32();
+		vector<string> labels;
+		for (uint32_t i = 0; i < labels_count; i++) {
+			labels.push_back(reader.readString());
+		}
+
+		Automaton* automaton = new Automaton();
+		vector<State*> states;
+		// On a malformed or truncated buffer, the states already created are deleted, since the automaton doesn't own them
+		try {
+			uint32_t states_count = reader.readUInt32();
+			for (uint32_t i = 0; i < states_count; i++) {
+				string name = reader.readString();
+				bool final = reader.readUInt32() != 0;
+				State* state = new State(name, final);
+				states.push_back(state);
+				automaton->addState(state);
+			}
+
+			uint32_t initial_index = reader.readUInt32();
+
+			uint32_t transitions_count = reader.readUInt32();
+			for (uint32_t i = 0; i < transitions_count; i++) {
+				uint32_t from = reader.readUInt32();
+				uint32_t label = reader.readUInt32();
+				uint32_t to = reader.readUInt32();
+				if (from >= states_count || label >= labels_count || to >= states_count) {
+					DEBUG_LOG_ERROR("The transition (%u, %u, %u) refers to a non-existent state or label", from, label, to);
+					throw "Invalid transition in the binary form of an automaton";
+				}
+				states[from]->connectChild(labels[label], states[to]);
+			}
+
+			// The initial state is set at the end, because it computes the distances of all the states
+			if (initial_index != NO_INITIAL_STATE) {
+				if (initial_index >= states_count) {
+					DEBUG_LOG_ERROR("The initial state %u does not exist", initial_index);
+					throw "Invalid initial state in the binary form of an automaton";
+				}
+				automaton->setInitialState(states[initial_index]);
+			}
+		} catch (const char* message) {
+			delete automaton;
+			for (State* state : states) {
+				delete state;
+			}
+			throw;
+		}
+		return automaton;
+	}
+
+	/**
+	 * Static method.
+	 * Returns the binary form of the automaton.
+	 */
+	string AutomataSerializer::toBinary(Automaton* automaton) {
+		BinaryWriter writer = BinaryWriter();
+		AutomataSerializer::writeAutomaton(writer, automaton);
+		return writer.getBuffer();
+	}
+
+	/**
+	 * Static method.
+	 * Returns a new automaton built from its binary form.
+	 */
+	Automaton* AutomataSerializer::fromBinary(const string& bytes) {
+		BinaryReader reader = BinaryReader(bytes);
+		return AutomataSerializer::readAutomaton(reader);
+	}
+
+	/**
+	 * Static method.
+	 * Saves the binary form of the automaton in a file.
+	 * Returns false if the file cannot be written.
+	 */
+	bool AutomataSerializer::saveToFile(Automaton* automaton, string file_name) {
+		ofstream file_out(file_name, ios::binary | ios::trunc);
+		if (!file_out) {
+			DEBUG_LOG_ERROR("Cannot open the file \"%s\"", file_name.c_str());
+			return false;
+		}
+		string bytes = AutomataSerializer::toBinary(automaton);
+		file_out.write(bytes.data(), bytes.length());
+		file_out.close();
+		return true;
+	}
+
+	/**
+	 * Static method.
+	 * Loads an automaton from a file containing its binary form.
+	 * Returns NULL if the file cannot be read.
+	 */
+	Automaton* AutomataSerializer::loadFromFile(string file_name) {
+		ifstream file_in(file_name, ios::binary);
+		if (!file_in) {
+			DEBUG_LOG_ERROR("Cannot open the file \"%s\"", file_name.c_str());
+			return NULL;
+		}
+		stringstream content;
+		content << file_in.rdbuf();
+		return AutomataSerializer::fromBinary(content.str());
+	}
+
+} /* namespace quicksc */
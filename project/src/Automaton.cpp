@@ -14,6 +14,8 @@
 
 #include <algorithm>
 
+#include "OperationCounters.hpp"
+
 //#define DEBUG_MODE
 #include "Debug.hpp"
 
@@ -67,6 +69,7 @@ namespace quicksc {
      * In case of states with the same name, this method would return a positive result.
      */
     bool Automaton::hasState(string name) {
+    	COUNT_OPERATION(OP_STATE_LOOKUP);
     	for (State* s : m_states) {
     		if (s->getName() == name) {
     			return true;
@@ -86,6 +89,7 @@ namespace quicksc {
      * which returns a set containing ALL states with the same name.
      */
     State* Automaton::getState(string name) {
+    	COUNT_OPERATION(OP_STATE_LOOKUP);
     	for (State* s : m_states) {
     		if (s->getName() == name) {
     			return s;
@@ -101,6 +105,7 @@ namespace quicksc {
      * where there is more than one state with the same name. In that case, it is better to use this method and not "getState".
      */
     const vector<State*> Automaton::getStatesByName(string name) {
+    	COUNT_OPERATION(OP_STATE_LOOKUP);
     	vector<State*> namesake_states; // Homonymous states
     	for (State* s : m_states) {
     		if (s->getName() == name) {
@@ -380,6 +385,62 @@ namespace quicksc {
     	return clone;
     }
 
+    /**
+     * Returns a new automaton, obtained by merging the states of each block into a single state, and by replacing
+     * the label of each transition with the labels returned by the relabeling function (none, to drop the transition).
+     * The blocks are numbered from 0 to blocks_count - 1; each block becomes a state named as its first state,
+     * which is final if the block contains a final state.
+     * The automaton is not modified.
+     */
+    Automaton* Automaton::quotient(const map<State*, unsigned long>& blocks, unsigned long blocks_count, std::function<vector<string>(const string&)> relabeling) {
+        Automaton* quotient = new Automaton();
+        vector<State*> block_states = vector<State*>(blocks_count, NULL);
+        for (State* s : this->m_states) {
+            unsigned long block = blocks.at(s);
+            if (block_states[block] == NULL) {
+                block_states[block] = new State(s->getName());
+                quotient->addState(block_states[block]);
+            }
+            if (s->isFinal()) {
+                block_states[block]->setFinal(true);
+            }
+        }
+
+        for (State* s : this->m_states) {
+            State* block_state = block_states[blocks.at(s)];
+            for (auto &pair : s->getExitingTransitionsRef()) {
+                if (pair.second.empty()) {
+                    continue;
+                }
+                for (const string& label : relabeling(pair.first)) {
+                    for (State* child : pair.second) {
+                        block_state->connectChild(label, block_states[blocks.at(child)]);
+                    }
+                }
+            }
+        }
+
+        // Setting the initial state at the end computes the distances, used by QSC
+        if (this->m_initial_state != NULL) {
+            quotient->setInitialState(block_states[blocks.at(this->m_initial_state)]);
+        }
+        return quotient;
+    }
+
+    /**
+     * Returns a copy of the automaton, where the label of each transition is replaced with the labels
+     * returned by the relabeling function (none, to drop the transition).
+     * The automaton is not modified.
+     */
+    Automaton* Automaton::relabel(std::function<vector<string>(const string&)> relabeling) {
+        map<State*, unsigned long> blocks;
+        for (State* s : this->m_states) {
+            unsigned long block = blocks.size();
+            blocks[s] = block;
+        }
+        return this->quotient(blocks, blocks.size(), relabeling);
+    }
+
     /**
      * Recomputes all the distances of the states of the automaton from the initial state.
      * In order to do this, it uses the BFS algorithm, resetting all the distances in advance.
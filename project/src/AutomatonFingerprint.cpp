@@ -0,0 +1,336 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * AutomatonFingerprint.cpp
+ *
+ *
+ * This source file contains the implementation of the class AutomatonFingerprint.
+ */
+
+#include "AutomatonFingerprint.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <utility>
+
+#include "AutomataSerializer.hpp"
+#include "State.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+#define FINGERPRINT_SEED			0x51534346		// "QSCF"
+#define FINGERPRINT_CHILD_TAG		1
+#define FINGERPRINT_PARENT_TAG		2
+#define FINGERPRINT_INDIVIDUALIZED_TAG	3
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It computes the fingerprint and the canonical form of the automaton, which must not be modified while the object is used.
+	 */
+	AutomatonFingerprint::AutomatonFingerprint(Automaton* automaton) {
+		this->m_states = automaton->getStatesVector();
+		for (uint32_t index = 0; index < this->m_states.size(); index++) {
+			this->m_state_indices[this->m_states[index]] = index;
+		}
+
+		// The neighbours of each state, with the labels and the directions of the transitions reduced to hashes
+		std::map<std::string, uint64_t> label_hashes;
+		this->m_neighbours.resize(this->m_states.size());
+		for (uint32_t index = 0; index < this->m_states.size(); index++) {
+			State* state = this->m_states[index];
+			for (int direction : { FINGERPRINT_CHILD_TAG, FINGERPRINT_PARENT_TAG }) {
+				const map<string, set<State*>>& transitions = (direction == FINGERPRINT_CHILD_TAG)
+						? state->getExitingTransitionsRef()
+						: state->getIncomingTransitionsRef();
+				for (auto &pair : transitions) {
+					auto iterator = label_hashes.find(pair.first);
+					if (iterator == label_hashes.end()) {
+						iterator = label_hashes.insert({ pair.first, AutomatonFingerprint::hashString(pair.first) }).first;
+					}
+					uint64_t label_hash = AutomatonFingerprint::combine(iterator->second, direction);
+					for (State* other : pair.second) {
+						this->m_neighbours[index].push_back({ label_hash, this->m_state_indices[other] });
+					}
+				}
+			}
+		}
+
+		std::vector<uint64_t> colors;
+		for (State* state : this->m_states) {
+			colors.push_back(AutomatonFingerprint::combine(FINGERPRINT_SEED,
+					(state->isFinal() ? 1 : 0) + (automaton->isInitial(state) ? 2 : 0)));
+		}
+		this->m_rounds = this->refineColors(colors);
+
+		// The fingerprint is the hash of the multiset of the colors
+		std::vector<uint64_t> sorted_colors = colors;
+		std::sort(sorted_colors.begin(), sorted_colors.end());
+		this->m_fingerprint = AutomatonFingerprint::combine(FINGERPRINT_SEED, sorted_colors.size());
+		for (uint64_t color : sorted_colors) {
+			this->m_fingerprint = AutomatonFingerprint::combine(this->m_fingerprint, color);
+		}
+
+		this->m_leaves_count = 0;
+		std::vector<uint32_t> individualized;
+		this->searchCanonicalForm(automaton, colors, individualized);
+		for (uint32_t index : this->m_canonical_order) {
+			this->m_canonical_indices[this->m_states[index]] = this->m_canonical_states.size();
+			this->m_canonical_states.push_back(this->m_states[index]);
+		}
+		DEBUG_LOG("Canonical form of %lu states found after %lu leaves, with %lu automorphisms",
+				this->m_states.size(), this->m_leaves_count, this->m_automorphisms.size());
+
+		// The structures of the search aren't needed anymore
+		std::vector<std::vector<std::pair<uint64_t, uint32_t>>>().swap(this->m_neighbours);
+		std::vector<std::vector<uint32_t>>().swap(this->m_automorphisms);
+	}
+
+	/**
+	 * Destructor.
+	 */
+	AutomatonFingerprint::~AutomatonFingerprint() {}
+
+	/**
+	 * Static method.
+	 * Returns the hash of a string, with the FNV-1a function.
+	 */
+	uint64_t AutomatonFingerprint::hashString(const std::string& value) {
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for (unsigned char c : value) {
+			hash ^= c;
+			hash *= 0x100000001B3ULL;
+		}
+		return hash;
+	}
+
+	/**
+	 * Static method.
+	 * Combines a value into a hash; the value is mixed first (with the finalizer of SplitMix64), so that similar values
+	 * give very different results.
+	 */
+	uint64_t AutomatonFingerprint::combine(uint64_t seed, uint64_t value) {
+		value += 0x9E3779B97F4A7C15ULL;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		value = value ^ (value >> 31);
+		return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+	}
+
+	/**
+	 * Private method.
+	 * Refines the colors of the states, until the number of different colors is stable, and returns the number of rounds.
+	 * The colors don't depend on the names of the states, but only on the structure of the automaton, on its labels and on
+	 * the initial colors.
+	 */
+	unsigned int AutomatonFingerprint::refineColors(std::vector<uint64_t>& colors) {
+		unsigned long colors_count = std::set<uint64_t>(colors.begin(), colors.end()).size();
+		unsigned int rounds = 0;
+		std::vector<uint64_t> new_colors = std::vector<uint64_t>(colors.size());
+		std::vector<uint64_t> signature;
+		while (true) {
+			std::set<uint64_t> distinct_colors;
+			for (uint32_t index = 0; index < colors.size(); index++) {
+				// Signature: the pairs (label, color) of the children and of the parents, in any order
+				signature.clear();
+				for (auto &neighbour : this->m_neighbours[index]) {
+					signature.push_back(AutomatonFingerprint::combine(neighbour.first, colors[neighbour.second]));
+				}
+				std::sort(signature.begin(), signature.end());
+				uint64_t color = colors[index];
+				for (uint64_t element : signature) {
+					color = AutomatonFingerprint::combine(color, element);
+				}
+				new_colors[index] = color;
+				distinct_colors.insert(color);
+			}
+			rounds++;
+			colors.swap(new_colors);
+			// Since the new color includes the old one, the number of colors can only grow
+			if (distinct_colors.size() == colors_count) {
+				break;
+			}
+			colors_count = distinct_colors.size();
+		}
+		DEBUG_LOG("The colors of %lu states are stable after %u rounds, with %lu distinct colors", colors.size(), rounds, colors_count);
+		return rounds;
+	}
+
+	/**
+	 * Private method.
+	 * Explores the node of the search tree given by the (refined) colors and by the states individualized so far.
+	 * In a leaf, the canonical form is updated if the numbering of the leaf gives a smaller form, and an automorphism is
+	 * recorded if it gives the same form.
+	 */
+	void AutomatonFingerprint::searchCanonicalForm(Automaton* automaton, std::vector<uint64_t>& colors, std::vector<uint32_t>& individualized) {
+		if (this->m_leaves_count >= FINGERPRINT_MAX_LEAVES) {
+			return;
+		}
+
+		// Classes of states with the same color, ordered by color
+		std::map<uint64_t, std::vector<uint32_t>> cells;
+		for (uint32_t index = 0; index < colors.size(); index++) {
+			cells[colors[index]].push_back(index);
+		}
+		const std::vector<uint32_t>* target = NULL;
+		for (auto &pair : cells) {
+			if (pair.second.size() > 1 && (target == NULL || pair.second.size() < target->size())) {
+				target = &pair.second;
+			}
+		}
+
+		if (target == NULL) {
+			this->m_leaves_count++;
+			std::vector<uint32_t> order;
+			for (auto &pair : cells) {
+				order.push_back(pair.second.front());
+			}
+			std::string form = this->writeCanonicalForm(automaton, order);
+			if (this->m_leaves_count == 1 || form < this->m_canonical_form) {
+				this->m_canonical_form = form;
+				this->m_canonical_order = order;
+			} else if (form == this->m_canonical_form) {
+				// The two numberings differ by an automorphism of the automaton
+				std::vector<uint32_t> automorphism = std::vector<uint32_t>(order.size());
+				for (uint32_t position = 0; position < order.size(); position++) {
+					automorphism[this->m_canonical_order[position]] = order[position];
+				}
+				this->m_automorphisms.push_back(automorphism);
+			}
+			return;
+		}
+
+		std::vector<uint32_t> explored;
+		for (uint32_t candidate : *target) {
+			if (this->m_leaves_count >= FINGERPRINT_MAX_LEAVES) {
+				break;
+			}
+			// The candidate is skipped if an automorphism fixing the individualized states maps an explored candidate into it
+			std::set<uint32_t> orbit = std::set<uint32_t>(explored.begin(), explored.end());
+			std::vector<uint32_t> queue = explored;
+			while (!queue.empty() && orbit.count(candidate) == 0) {
+				uint32_t index = queue.back();
+				queue.pop_back();
+				for (auto &automorphism : this->m_automorphisms) {
+					bool fixes_individualized = std::all_of(individualized.begin(), individualized.end(),
+							[&automorphism](uint32_t fixed) { return automorphism[fixed] == fixed; });
+					if (fixes_individualized && orbit.insert(automorphism[index]).second) {
+						queue.push_back(automorphism[index]);
+					}
+				}
+			}
+			if (orbit.count(candidate) > 0) {
+				continue;
+			}
+			explored.push_back(candidate);
+
+			std::vector<uint64_t> child_colors = colors;
+			child_colors[candidate] = AutomatonFingerprint::combine(child_colors[candidate], FINGERPRINT_INDIVIDUALIZED_TAG);
+			this->refineColors(child_colors);
+			individualized.push_back(candidate);
+			this->searchCanonicalForm(automaton, child_colors, individualized);
+			individualized.pop_back();
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Writes the canonical form of the automaton for a numbering of the states, given as the vector of their indices:
+	 * the number of states, the position of the initial state (plus one, or zero if absent) and, for each state in order,
+	 * its final flag and its transitions as pairs (label, child positions).
+	 */
+	std::string AutomatonFingerprint::writeCanonicalForm(Automaton* automaton, const std::vector<uint32_t>& order) {
+		std::vector<uint32_t> positions = std::vector<uint32_t>(order.size());
+		for (uint32_t position = 0; position < order.size(); position++) {
+			positions[order[position]] = position;
+		}
+
+		BinaryWriter writer = BinaryWriter();
+		writer.writeUInt32(order.size());
+		State* initial_state = automaton->getInitialState();
+		writer.writeUInt32(initial_state != NULL ? positions[this->m_state_indices.at(initial_state)] + 1 : 0);
+		for (uint32_t index : order) {
+			State* state = this->m_states[index];
+			writer.writeUInt32(state->isFinal() ? 1 : 0);
+			const map<string, set<State*>>& transitions = state->getExitingTransitionsRef();
+			writer.writeUInt32(std::count_if(transitions.begin(), transitions.end(), [](auto &pair) { return !pair.second.empty(); }));
+			for (auto &pair : transitions) {
+				if (pair.second.empty()) {
+					continue;
+				}
+				std::vector<uint32_t> children;
+				for (State* child : pair.second) {
+					children.push_back(positions[this->m_state_indices.at(child)]);
+				}
+				std::sort(children.begin(), children.end());
+				writer.writeString(pair.first);
+				writer.writeUInt32(children.size());
+				for (uint32_t child : children) {
+					writer.writeUInt32(child);
+				}
+			}
+		}
+		return writer.getBuffer();
+	}
+
+	/**
+	 * Returns the fingerprint of the automaton.
+	 */
+	uint64_t AutomatonFingerprint::getFingerprint() {
+		return this->m_fingerprint;
+	}
+
+	/**
+	 * Returns the fingerprint of the automaton as a string of 16 hexadecimal digits.
+	 */
+	std::string AutomatonFingerprint::getFingerprintString() {
+		char buffer[17];
+		snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long) this->m_fingerprint);
+		return std::string(buffer);
+	}
+
+	/**
+	 * Returns the number of rounds of the color refinement.
+	 */
+	unsigned int AutomatonFingerprint::getRefinementRounds() {
+		return this->m_rounds;
+	}
+
+	/**
+	 * Returns the number of leaves explored by the search of the canonical form.
+	 */
+	unsigned long AutomatonFingerprint::getLeavesCount() {
+		return this->m_leaves_count;
+	}
+
+	/**
+	 * Returns the canonical form of the automaton, in binary form.
+	 */
+	const std::string& AutomatonFingerprint::getCanonicalForm() {
+		return this->m_canonical_form;
+	}
+
+	/**
+	 * Returns the states of the automaton in canonical order.
+	 */
+	const std::vector<State*>& AutomatonFingerprint::getCanonicalStates() {
+		return this->m_canonical_states;
+	}
+
+	/**
+	 * Returns the index of the state in the canonical order.
+	 */
+	uint32_t AutomatonFingerprint::getCanonicalIndex(State* state) {
+		auto iterator = this->m_canonical_indices.find(state);
+		if (iterator == this->m_canonical_indices.end()) {
+			DEBUG_LOG_ERROR("The state \"%s\" does not belong to the automaton of the fingerprint", state->getName().c_str());
+			throw "The state does not belong to the automaton of the fingerprint";
+		}
+		return iterator->second;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,392 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BDD.cpp
+ *
+ *
+ * This source file contains the implementation of the BDDManager class.
+ */
+
+#include "BDD.hpp"
+
+#include <algorithm>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It creates the two terminal nodes, the empty unique table and the empty operation cache.
+	 */
+	BDDManager::BDDManager() {
+		this->m_nodes.push_back({ BDD_TERMINAL_VARIABLE, BDD_FALSE, BDD_FALSE });
+		this->m_nodes.push_back({ BDD_TERMINAL_VARIABLE, BDD_TRUE, BDD_TRUE });
+		this->m_unique_table = std::vector<BDD>(1UL << BDD_UNIQUE_INITIAL_BITS, BDD_FALSE);
+		this->m_cache = std::vector<BDDCacheEntry>(1UL << BDD_CACHE_INITIAL_BITS, { BDD_OP_NONE, 0, 0, 0, 0 });
+		this->m_cache_lookups = 0;
+		this->m_cache_hits = 0;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BDDManager::~BDDManager() {}
+
+	/**
+	 * Private static method.
+	 * Mixes three values into a hash.
+	 */
+	uint64_t BDDManager::hash(uint64_t a, uint64_t b, uint64_t c) {
+		uint64_t h = a * 0x9E3779B97F4A7C15ULL;
+		h ^= b + 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+		h ^= c + 0x165667B19E3779F9ULL + (h << 6) + (h >> 2);
+		return h ^ (h >> 29);
+	}
+
+	/**
+	 * Private method.
+	 * Doubles the number of buckets of the unique table, and reinserts all the nodes.
+	 * The operation cache is enlarged as well, until it reaches the size of the unique table or its maximum size.
+	 */
+	void BDDManager::growUniqueTable() {
+		std::vector<BDD> table = std::vector<BDD>(this->m_unique_table.size() * 2, BDD_FALSE);
+		uint64_t mask = table.size() - 1;
+		for (BDD node = 2; node < this->m_nodes.size(); node++) {
+			const BDDNodeData& data = this->m_nodes[node];
+			uint64_t bucket = BDDManager::hash(data.variable, data.low, data.high) & mask;
+			while (table[bucket] != BDD_FALSE) {
+				bucket = (bucket + 1) & mask;
+			}
+			table[bucket] = node;
+		}
+		this->m_unique_table.swap(table);
+		if (this->m_cache.size() < this->m_unique_table.size() && this->m_cache.size() < (1UL << BDD_CACHE_BITS)) {
+			this->growCache();
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Doubles the number of entries of the operation cache, and reinserts all the memoized results.
+	 */
+	void BDDManager::growCache() {
+		std::vector<BDDCacheEntry> cache = std::vector<BDDCacheEntry>(this->m_cache.size() * 2, { BDD_OP_NONE, 0, 0, 0, 0 });
+		this->m_cache.swap(cache);
+		for (const BDDCacheEntry& entry : cache) {
+			if (entry.operation != BDD_OP_NONE) {
+				this->storeCache(entry.operation, entry.first, entry.second, entry.third, entry.result);
+			}
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Looks for the result of an operation in the cache. Returns true if found.
+	 */
+	bool BDDManager::lookupCache(BDDOperation operation, BDD first, BDD second, BDD third, BDD& result) {
+		this->m_cache_lookups++;
+		const BDDCacheEntry& entry = this->m_cache[BDDManager::hash(operation * 0x51ED27 + first, second, third) & (this->m_cache.size() - 1)];
+		if (entry.operation == operation && entry.first == first && entry.second == second && entry.third == third) {
+			this->m_cache_hits++;
+			result = entry.result;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Private method.
+	 * Stores the result of an operation in the cache, overwriting the previous entry in the same position.
+	 */
+	void BDDManager::storeCache(BDDOperation operation, BDD first, BDD second, BDD third, BDD result) {
+		this->m_cache[BDDManager::hash(operation * 0x51ED27 + first, second, third) & (this->m_cache.size() - 1)] =
+				{ operation, first, second, third, result };
+	}
+
+	/**
+	 * Returns the node testing the variable with the given children, creating it if it doesn't exist.
+	 * If the children are equal, no node is needed and the child is returned.
+	 */
+	BDD BDDManager::makeNode(uint32_t variable, BDD low, BDD high) {
+		if (low == high) {
+			return low;
+		}
+		DEBUG_ASSERT_TRUE(variable < this->m_nodes[low].variable && variable < this->m_nodes[high].variable);
+		uint64_t mask = this->m_unique_table.size() - 1;
+		uint64_t bucket = BDDManager::hash(variable, low, high) & mask;
+		while (this->m_unique_table[bucket] != BDD_FALSE) {
+			const BDDNodeData& data = this->m_nodes[this->m_unique_table[bucket]];
+			if (data.variable == variable && data.low == low && data.high == high) {
+				return this->m_unique_table[bucket];
+			}
+			bucket = (bucket + 1) & mask;
+		}
+		BDD node = this->m_nodes.size();
+		this->m_nodes.push_back({ variable, low, high });
+		this->m_unique_table[bucket] = node;
+		// The load of the table is kept under one half
+		if (2 * this->m_nodes.size() > this->m_unique_table.size()) {
+			this->growUniqueTable();
+		}
+		return node;
+	}
+
+	/**
+	 * Returns the variable tested by the node (BDD_TERMINAL_VARIABLE for the terminal nodes).
+	 */
+	uint32_t BDDManager::getVariable(BDD node) {
+		return this->m_nodes[node].variable;
+	}
+
+	/**
+	 * Returns the child of the node for the value false of its variable.
+	 */
+	BDD BDDManager::getLow(BDD node) {
+		return this->m_nodes[node].low;
+	}
+
+	/**
+	 * Returns the child of the node for the value true of its variable.
+	 */
+	BDD BDDManager::getHigh(BDD node) {
+		return this->m_nodes[node].high;
+	}
+
+	/**
+	 * Returns the function that is true when the variable is true.
+	 */
+	BDD BDDManager::variable(uint32_t variable) {
+		return this->makeNode(variable, BDD_FALSE, BDD_TRUE);
+	}
+
+	/**
+	 * Returns the conjunction of the variables, used to specify the variables of a quantification.
+	 * The variables must be sorted in increasing order.
+	 */
+	BDD BDDManager::cube(const std::vector<uint32_t>& variables) {
+		BDD result = BDD_TRUE;
+		for (auto iterator = variables.rbegin(); iterator != variables.rend(); iterator++) {
+			result = this->makeNode(*iterator, BDD_FALSE, result);
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the function that is true only for the given assignment of the variables.
+	 * The first variable (the smallest one) takes the most significant bit of the value.
+	 */
+	BDD BDDManager::minterm(const std::vector<uint32_t>& variables, uint64_t value) {
+		BDD result = BDD_TRUE;
+		for (unsigned long i = variables.size(); i > 0; i--) {
+			bool bit = (value >> (variables.size() - i)) & 1ULL;
+			result = bit ? this->makeNode(variables[i - 1], BDD_FALSE, result) : this->makeNode(variables[i - 1], result, BDD_FALSE);
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the conjunction of two functions.
+	 */
+	BDD BDDManager::bddAnd(BDD first, BDD second) {
+		if (first == BDD_FALSE || second == BDD_FALSE) {
+			return BDD_FALSE;
+		}
+		if (first == BDD_TRUE || first == second) {
+			return second;
+		}
+		if (second == BDD_TRUE) {
+			return first;
+		}
+		if (first > second) {
+			std::swap(first, second);
+		}
+		BDD result;
+		if (this->lookupCache(BDD_OP_AND, first, second, 0, result)) {
+			return result;
+		}
+		uint32_t first_variable = this->m_nodes[first].variable;
+		uint32_t second_variable = this->m_nodes[second].variable;
+		uint32_t top = std::min(first_variable, second_variable);
+		BDD first_low = (first_variable == top) ? this->m_nodes[first].low : first;
+		BDD first_high = (first_variable == top) ? this->m_nodes[first].high : first;
+		BDD second_low = (second_variable == top) ? this->m_nodes[second].low : second;
+		BDD second_high = (second_variable == top) ? this->m_nodes[second].high : second;
+		BDD low = this->bddAnd(first_low, second_low);
+		BDD high = this->bddAnd(first_high, second_high);
+		result = this->makeNode(top, low, high);
+		this->storeCache(BDD_OP_AND, first, second, 0, result);
+		return result;
+	}
+
+	/**
+	 * Returns the disjunction of two functions.
+	 */
+	BDD BDDManager::bddOr(BDD first, BDD second) {
+		if (first == BDD_TRUE || second == BDD_TRUE) {
+			return BDD_TRUE;
+		}
+		if (first == BDD_FALSE || first == second) {
+			return second;
+		}
+		if (second == BDD_FALSE) {
+			return first;
+		}
+		if (first > second) {
+			std::swap(first, second);
+		}
+		BDD result;
+		if (this->lookupCache(BDD_OP_OR, first, second, 0, result)) {
+			return result;
+		}
+		uint32_t first_variable = this->m_nodes[first].variable;
+		uint32_t second_variable = this->m_nodes[second].variable;
+		uint32_t top = std::min(first_variable, second_variable);
+		BDD first_low = (first_variable == top) ? this->m_nodes[first].low : first;
+		BDD first_high = (first_variable == top) ? this->m_nodes[first].high : first;
+		BDD second_low = (second_variable == top) ? this->m_nodes[second].low : second;
+		BDD second_high = (second_variable == top) ? this->m_nodes[second].high : second;
+		BDD low = this->bddOr(first_low, second_low);
+		BDD high = this->bddOr(first_high, second_high);
+		result = this->makeNode(top, low, high);
+		this->storeCache(BDD_OP_OR, first, second, 0, result);
+		return result;
+	}
+
+	/**
+	 * Returns the conjunction of two functions, where the variables of the cube are existentially quantified.
+	 * This is the "relational product", computed in a single recursion without building the whole conjunction.
+	 */
+	BDD BDDManager::andExists(BDD first, BDD second, BDD cube) {
+		if (first == BDD_FALSE || second == BDD_FALSE) {
+			return BDD_FALSE;
+		}
+		if (first == BDD_TRUE && second == BDD_TRUE) {
+			return BDD_TRUE;
+		}
+		if (cube == BDD_TRUE) {
+			return this->bddAnd(first, second);
+		}
+		if (first > second) {
+			std::swap(first, second);
+		}
+		uint32_t first_variable = this->m_nodes[first].variable;
+		uint32_t second_variable = this->m_nodes[second].variable;
+		uint32_t top = std::min(first_variable, second_variable);
+		// The variables of the cube above the top variable don't appear in the functions
+		while (this->m_nodes[cube].variable < top) {
+			cube = this->m_nodes[cube].high;
+		}
+		if (cube == BDD_TRUE) {
+			return this->bddAnd(first, second);
+		}
+
+		BDD result;
+		if (this->lookupCache(BDD_OP_AND_EXISTS, first, second, cube, result)) {
+			return result;
+		}
+		BDD first_low = (first_variable == top) ? this->m_nodes[first].low : first;
+		BDD first_high = (first_variable == top) ? this->m_nodes[first].high : first;
+		BDD second_low = (second_variable == top) ? this->m_nodes[second].low : second;
+		BDD second_high = (second_variable == top) ? this->m_nodes[second].high : second;
+		if (this->m_nodes[cube].variable == top) {
+			BDD rest = this->m_nodes[cube].high;
+			BDD low = this->andExists(first_low, second_low, rest);
+			result = (low == BDD_TRUE) ? BDD_TRUE : this->bddOr(low, this->andExists(first_high, second_high, rest));
+		} else {
+			BDD low = this->andExists(first_low, second_low, cube);
+			BDD high = this->andExists(first_high, second_high, cube);
+			result = this->makeNode(top, low, high);
+		}
+		this->storeCache(BDD_OP_AND_EXISTS, first, second, cube, result);
+		return result;
+	}
+
+	/**
+	 * Sets the renaming of the variables used by the "rename" method: the variable v is replaced by renaming[v].
+	 * The renaming must preserve the order of the variables appearing in the renamed functions.
+	 * The cached results of the previous renaming are discarded.
+	 */
+	void BDDManager::setRenaming(const std::vector<uint32_t>& renaming) {
+		this->m_renaming = renaming;
+		for (BDDCacheEntry& entry : this->m_cache) {
+			if (entry.operation == BDD_OP_RENAME) {
+				entry.operation = BDD_OP_NONE;
+			}
+		}
+	}
+
+	/**
+	 * Returns the function obtained by replacing the variables according to the current renaming.
+	 */
+	BDD BDDManager::rename(BDD node) {
+		if (node == BDD_FALSE || node == BDD_TRUE) {
+			return node;
+		}
+		BDD result;
+		if (this->lookupCache(BDD_OP_RENAME, node, 0, 0, result)) {
+			return result;
+		}
+		const BDDNodeData data = this->m_nodes[node];
+		BDD low = this->rename(data.low);
+		BDD high = this->rename(data.high);
+		result = this->makeNode(this->m_renaming[data.variable], low, high);
+		this->storeCache(BDD_OP_RENAME, node, 0, 0, result);
+		return result;
+	}
+
+	/**
+	 * Appends to the vector all the assignments of the variables satisfying the function, as values whose
+	 * most significant bit is the first variable (as in the "minterm" method).
+	 * The function must depend only on the given variables, which must be sorted in increasing order.
+	 */
+	void BDDManager::enumerate(BDD node, const std::vector<uint32_t>& variables, std::vector<uint64_t>& values) {
+		// Depth-first visit, with an explicit stack of (node, level, prefix)
+		struct Frame { BDD node; unsigned long level; uint64_t prefix; };
+		std::vector<Frame> stack = { { node, 0, 0 } };
+		while (!stack.empty()) {
+			Frame frame = stack.back();
+			stack.pop_back();
+			if (frame.node == BDD_FALSE) {
+				continue;
+			}
+			if (frame.level == variables.size()) {
+				DEBUG_ASSERT_TRUE(frame.node == BDD_TRUE);
+				values.push_back(frame.prefix);
+				continue;
+			}
+			BDD low = frame.node, high = frame.node;
+			if (this->m_nodes[frame.node].variable == variables[frame.level]) {
+				low = this->m_nodes[frame.node].low;
+				high = this->m_nodes[frame.node].high;
+			}
+			// The high child is pushed first, so that the values are produced in increasing order
+			stack.push_back({ high, frame.level + 1, (frame.prefix << 1) | 1ULL });
+			stack.push_back({ low, frame.level + 1, frame.prefix << 1 });
+		}
+	}
+
+	/**
+	 * Returns the number of nodes created by the manager, including the terminal ones.
+	 */
+	unsigned long BDDManager::getNodesCount() {
+		return this->m_nodes.size();
+	}
+
+	/**
+	 * Returns the number of lookups in the operation cache.
+	 */
+	unsigned long long BDDManager::getCacheLookups() {
+		return this->m_cache_lookups;
+	}
+
+	/**
+	 * Returns the number of lookups in the operation cache that found the result.
+	 */
+	unsigned long long BDDManager::getCacheHits() {
+		return this->m_cache_hits;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,208 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BDDSubsetConstruction.cpp
+ *
+ *
+ * This source file contains the implementation of the BDDSubsetConstruction class.
+ */
+
+#include "BDDSubsetConstruction.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "BDD.hpp"
+#include "Properties.hpp"
+#include "State.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 */
+	BDDSubsetConstruction::BDDSubsetConstruction() : DeterminizationAlgorithm(BSC_ABBR, BSC_NAME) {}
+
+	/**
+	 * Destructor.
+	 */
+	BDDSubsetConstruction::~BDDSubsetConstruction() {}
+
+	/**
+	 * Resets the values of the runtime statistics.
+	 */
+	void BDDSubsetConstruction::resetRuntimeStatsValues() {
+		// Calling parent method
+		DeterminizationAlgorithm::resetRuntimeStatsValues();
+		// Initializing the values
+		map<RuntimeStat, double>& stats = this->getRuntimeStatsValuesRef();
+		for (RuntimeStat stat : this->getRuntimeStatsList()) {
+			stats[stat] = (double) 0;
+		}
+	}
+
+	/**
+	 * Definition of the runtime statistics of the algorithm.
+	 */
+	vector<RuntimeStat> BDDSubsetConstruction::getRuntimeStatsList() {
+		vector<RuntimeStat> list = DeterminizationAlgorithm::getRuntimeStatsList();
+		list.push_back(BDD_NODES);							// Number of nodes created by the BDD manager
+		list.push_back(BDD_CACHE_HIT_RATE);					// Percentage of the lookups in the operation cache that found the result
+		return list;
+	}
+
+	/**
+	 * Returns the DFA obtained by the Subset Construction algorithm, with the extensions represented as BDDs.
+	 */
+	Automaton* BDDSubsetConstruction::run(Automaton* nfa) {
+		TRACE_SPAN("BSC");
+		State* nfa_initial_state = nfa->getInitialState();
+		DEBUG_ASSERT_NOT_NULL(nfa_initial_state);
+		BDDManager manager;
+
+		// Numbering of the states reachable from the initial one, and collection of the labels
+		std::map<State*, uint64_t> numbers;
+		std::vector<State*> states = { nfa_initial_state };
+		std::set<string> labels;
+		std::deque<State*> queue = { nfa_initial_state };
+		numbers[nfa_initial_state] = 0;
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			for (auto &pair : current->getExitingTransitionsRef()) {
+				if (pair.first != EPSILON && !pair.second.empty()) {
+					labels.insert(pair.first);
+				}
+				for (State* child : pair.second) {
+					if (numbers.count(child) == 0) {
+						numbers[child] = states.size();
+						states.push_back(child);
+						queue.push_back(child);
+					}
+				}
+			}
+		}
+
+		// Variables of the encoding: the current bit j is the variable 2j, the next bit j is the variable 2j+1
+		unsigned long bits = 1;
+		while ((1ULL << bits) < states.size()) {
+			bits++;
+		}
+		std::vector<uint32_t> current_variables, next_variables;
+		std::vector<uint32_t> renaming = std::vector<uint32_t>(2 * bits);
+		for (uint32_t j = 0; j < bits; j++) {
+			current_variables.push_back(2 * j);
+			next_variables.push_back(2 * j + 1);
+			renaming[2 * j] = 2 * j;
+			renaming[2 * j + 1] = 2 * j;
+		}
+		manager.setRenaming(renaming);
+		BDD current_cube = manager.cube(current_variables);
+
+		// Sets of the epsilon-closures of the states, over the next variables
+		std::vector<BDD> closures = std::vector<BDD>(states.size(), BDD_FALSE);
+		for (uint64_t s = 0; s < states.size(); s++) {
+			for (State* state : ConstructedState::computeEpsilonClosure(states[s])) {
+				closures[s] = manager.bddOr(closures[s], manager.minterm(next_variables, numbers[state]));
+			}
+		}
+
+		// Transition relations, one for each label
+		std::map<string, BDD> relations;
+		for (string label : labels) {
+			relations[label] = BDD_FALSE;
+		}
+		for (uint64_t s = 0; s < states.size(); s++) {
+			BDD source = manager.minterm(current_variables, s);
+			for (auto &pair : states[s]->getExitingTransitionsRef()) {
+				if (pair.first == EPSILON || pair.second.empty()) {
+					continue;
+				}
+				BDD targets = BDD_FALSE;
+				for (State* child : pair.second) {
+					targets = manager.bddOr(targets, closures[numbers[child]]);
+				}
+				relations[pair.first] = manager.bddOr(relations[pair.first], manager.bddAnd(source, targets));
+			}
+		}
+
+		// Exploration of the extensions, identified by their BDD nodes
+		BDD initial_extension = manager.rename(closures[0]);
+		std::vector<BDD> extensions = { initial_extension };
+		std::unordered_map<BDD, unsigned long> indexes = { { initial_extension, 0 } };
+		std::vector<std::vector<std::pair<string, unsigned long>>> transitions = { {} };
+		for (unsigned long current = 0; current < extensions.size(); current++) {
+			for (auto &pair : relations) {
+				BDD l_closure = manager.rename(manager.andExists(extensions[current], pair.second, current_cube));
+				if (l_closure == BDD_FALSE) {
+					continue;
+				}
+				auto iterator = indexes.find(l_closure);
+				unsigned long target;
+				if (iterator == indexes.end()) {
+					target = extensions.size();
+					indexes[l_closure] = target;
+					extensions.push_back(l_closure);
+					transitions.push_back({});
+				} else {
+					target = iterator->second;
+				}
+				transitions[current].push_back({ pair.first, target });
+			}
+		}
+		DEBUG_LOG("Explored %lu extensions with %lu BDD nodes", extensions.size(), manager.getNodesCount());
+
+		// Creation of the states of the DFA, from the extensions enumerated out of the BDDs
+		// The states have the names of the ConstructedStates of the Subset Construction, but they don't keep the extensions as sets:
+		// they're not needed after the exploration, and they'd take more memory than all the rest of the DFA
+		Automaton* dfa = new Automaton();
+		std::vector<State*> dfa_states;
+		std::vector<uint64_t> codes;
+		std::vector<string> names;
+		for (BDD extension_bdd : extensions) {
+			codes.clear();
+			manager.enumerate(extension_bdd, current_variables, codes);
+			names.clear();
+			bool final = false;
+			for (uint64_t code : codes) {
+				names.push_back(states[code]->getName());
+				final = final || states[code]->isFinal();
+			}
+			std::sort(names.begin(), names.end());
+			string name = "{";
+			for (string& nfa_name : names) {
+				name += nfa_name + ',';
+			}
+			name.back() = '}';
+			State* dfa_state = new State(name, final);
+			dfa->addState(dfa_state);
+			dfa_states.push_back(dfa_state);
+		}
+		for (unsigned long index = 0; index < transitions.size(); index++) {
+			for (auto &pair : transitions[index]) {
+				dfa_states[index]->connectChild(pair.first, dfa_states[pair.second]);
+			}
+		}
+
+		// Set the initial state of the DFA
+		// This procedure sets the distances from the initial state to all the other states, automatically
+		dfa->setInitialState(dfa_states[0]);
+
+		this->getRuntimeStatsValuesRef()[BDD_NODES] = manager.getNodesCount();
+		this->getRuntimeStatsValuesRef()[BDD_CACHE_HIT_RATE] = (manager.getCacheLookups() == 0) ? 0
+				: (100.0 * manager.getCacheHits() / manager.getCacheLookups());
+		TRACE_COUNTER("BSC states", dfa->size());
+		this->collectOperationCounts();
+
+		return dfa;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,242 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * BaselineStore.cpp
+ *
+ *
+ * This source file contains the implementation of the class BaselineStore.
+ *
+ * The significance of a delta is estimated with the standard error of the difference between the two averages,
+ * computed from the standard deviations and the number of samples of both the runs: the delta is significant
+ * when it's larger than BASELINE_SIGNIFICANCE_Z standard errors.
+ * The standard error accounts only for the variance within a run, not for the one between different runs
+ * (e.g. due to the frequency of the CPU or to the other processes), hence a regression must appear in all the runs.
+ */
+
+#include "BaselineStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "Properties.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+using namespace std;
+
+namespace quicksc {
+
+	/** Number of standard errors over which a delta is considered significant (about 95% of confidence). */
+	#define BASELINE_SIGNIFICANCE_Z 2.0
+
+	/**
+	 * Constructor.
+	 * The baseline is stored in the file "baseline_<name>.csv" of the results folder.
+	 */
+	BaselineStore::BaselineStore(string name) {
+		this->m_name = name;
+		this->m_file_name = string(DIR_RESULTS) + FILE_NAME_BASELINE_PREFIX + name + FILE_EXTENSION_CSV;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BaselineStore::~BaselineStore() {}
+
+	/**
+	 * Static method.
+	 * Returns the key identifying the current configuration, i.e. the values of the test parameters separated by semicolons.
+	 * The random seed and the number of testcases are not part of the key: different runs on the same kind of automata are comparable.
+	 */
+	string BaselineStore::getConfigurationKey(Configurations* configurations) {
+		string values = configurations->getValueString();
+		string key = "";
+		for (char c : values) {
+			if (c == ' ') {
+				continue;
+			}
+			key += (c == ',') ? ';' : c;
+		}
+		if (!key.empty() && key.back() == ';') {
+			key.pop_back();
+		}
+		return key;
+	}
+
+	/**
+	 * Private method.
+	 * Reads all the entries of the baseline file, as a map (configuration key -> statistic name -> values).
+	 */
+	map<string, map<string, AggregatedStat>> BaselineStore::loadEntries() {
+		map<string, map<string, AggregatedStat>> entries;
+		ifstream file_in(this->m_file_name);
+		string line;
+		while (getline(file_in, line)) {
+			vector<string> fields;
+			stringstream line_stream(line);
+			string field;
+			while (getline(line_stream, field, ',')) {
+				// Trimming the leading space of the field
+				fields.push_back(field.substr(field.find_first_not_of(" ") == string::npos ? field.length() : field.find_first_not_of(" ")));
+			}
+			if (fields.size() < 8) {
+				DEBUG_LOG_ERROR("Cannot interpret the line \"%s\" of the baseline file", line.c_str());
+				continue;
+			}
+			AggregatedStat stat;
+			stat.name = fields[1];
+			stat.samples = stoul(fields[2]);
+			stat.values = make_tuple(stod(fields[3]), stod(fields[4]), stod(fields[5]), stod(fields[6]));
+			stat.is_cost = (fields[7] == "1");
+			entries[fields[0]][stat.name] = stat;
+		}
+		return entries;
+	}
+
+	/**
+	 * Removes all the entries of the baseline.
+	 * It must be called once, before saving the statistics of a new run.
+	 */
+	void BaselineStore::clear() {
+		ofstream file_out(this->m_file_name, ios::trunc);
+		file_out.close();
+	}
+
+	/**
+	 * Saves the aggregated statistics of the current configuration in the baseline.
+	 * The statistics are given for one or more runs of the same test case: for each statistic, the run with the median
+	 * average is saved, so that a single fast or slow run doesn't move the baseline.
+	 */
+	void BaselineStore::save(Configurations* configurations, const vector<vector<AggregatedStat>>& runs) {
+		if (runs.empty()) {
+			return;
+		}
+		string key = BaselineStore::getConfigurationKey(configurations);
+		ofstream file_out(this->m_file_name, ios::app);
+		for (unsigned int index = 0; index < runs.front().size(); index++) {
+			vector<const AggregatedStat*> values;
+			for (const vector<AggregatedStat>& run : runs) {
+				if (index < run.size() && run[index].name == runs.front()[index].name) {
+					values.push_back(&run[index]);
+				}
+			}
+			std::sort(values.begin(), values.end(), [](const AggregatedStat* first, const AggregatedStat* second) {
+				return std::get<1>(first->values) < std::get<1>(second->values);
+			});
+			const AggregatedStat& stat = *values[values.size() / 2];
+
+			file_out << key << ", " << stat.name << ", " << stat.samples << ", ";
+			file_out << std::to_string(std::get<0>(stat.values)) << ", ";
+			file_out << std::to_string(std::get<1>(stat.values)) << ", ";
+			file_out << std::to_string(std::get<2>(stat.values)) << ", ";
+			file_out << std::to_string(std::get<3>(stat.values)) << ", ";
+			file_out << (stat.is_cost ? 1 : 0) << std::endl;
+		}
+		file_out.close();
+		printf("Statistics saved in the baseline " COLOR_BLUE("%s") " (median of %lu runs)\n", this->m_name.c_str(), runs.size());
+	}
+
+	/**
+	 * Macro defining the format of the output.
+	 */
+	#define BASELINE_FORMAT "\t" COLOR_PINK("%-28s") " | %11.4f | %11.4f | %+10.2f%% | %10.2f | %5u/%-5u | %s\n"
+
+	/**
+	 * Compares the aggregated statistics of the current configuration with the ones saved in the baseline,
+	 * and prints the deltas of the averages.
+	 * The statistics are given for one or more runs of the same test case: for each statistic, the run with the smallest
+	 * delta is printed, together with the number of runs where the statistic has grown significantly over the threshold
+	 * defined in the configurations ("BaselineThreshold" setting).
+	 * Returns TRUE if at least a regression has been found, i.e. if a cost statistic (time or memory) has grown
+	 * significantly over the threshold in all the runs: a single run is too noisy to detect a regression (see the header).
+	 */
+	bool BaselineStore::compare(Configurations* configurations, const vector<vector<AggregatedStat>>& runs) {
+		string key = BaselineStore::getConfigurationKey(configurations);
+		double threshold = configurations->valueOf<double>(BaselineThreshold);
+
+		map<string, map<string, AggregatedStat>> entries = this->loadEntries();
+		if (entries.count(key) == 0) {
+			printf(COLOR_YELLOW("No entry in the baseline \"%s\" for the configuration [%s]") "\n", this->m_name.c_str(), key.c_str());
+			return false;
+		}
+		if (runs.empty()) {
+			return false;
+		}
+		map<string, AggregatedStat>& baseline_stats = entries[key];
+
+		printf("BASELINE COMPARISON with " COLOR_BLUE("%s") " (threshold = %.1f%%, runs = %lu):\n", this->m_name.c_str(), threshold * 100, runs.size());
+		printf("\n_____________________________________|____" COLOR_YELLOW("BASE") "_____|_____" COLOR_YELLOW("NEW") "_____|____" COLOR_YELLOW("DELTA") "____|______" COLOR_YELLOW("Z") "_____|___" COLOR_YELLOW("RUNS") "____|\n");
+
+		bool regression_found = false;
+		for (unsigned int index = 0; index < runs.front().size(); index++) {
+			const string& name = runs.front()[index].name;
+			if (baseline_stats.count(name) == 0) {
+				continue;
+			}
+			const AggregatedStat& base = baseline_stats[name];
+			double base_avg = std::get<1>(base.values);
+			double base_dev = std::get<3>(base.values);
+
+			// The run with the smallest delta is the one printed
+			double best_avg = 0, best_relative_delta = INFINITY, best_z = 0;
+			bool best_significant = false, is_cost = false;
+			unsigned int increases = 0, decreases = 0;
+			for (const vector<AggregatedStat>& run : runs) {
+				if (index >= run.size() || run[index].name != name) {
+					continue;
+				}
+				const AggregatedStat& stat = run[index];
+				is_cost = stat.is_cost;
+				double new_avg = std::get<1>(stat.values);
+				double new_dev = std::get<3>(stat.values);
+
+				double delta = new_avg - base_avg;
+				double relative_delta = (base_avg != 0) ? (delta / fabs(base_avg)) : ((delta == 0) ? 0 : INFINITY);
+
+				// Standard error of the difference of the averages
+				double standard_error = 0;
+				if (base.samples > 0 && stat.samples > 0) {
+					standard_error = sqrt((base_dev * base_dev) / base.samples + (new_dev * new_dev) / stat.samples);
+				}
+				double z = (standard_error > 0) ? (fabs(delta) / standard_error) : ((delta == 0) ? 0 : INFINITY);
+				bool significant = (z >= BASELINE_SIGNIFICANCE_Z);
+
+				if (significant && relative_delta > threshold) {
+					increases++;
+				} else if (significant && relative_delta < -threshold) {
+					decreases++;
+				}
+				if (relative_delta <= best_relative_delta) {
+					best_avg = new_avg;
+					best_relative_delta = relative_delta;
+					best_z = z;
+					best_significant = significant;
+				}
+			}
+
+			string flag = best_significant ? "*" : "";
+			if (is_cost && increases == runs.size()) {
+				flag = COLOR_RED("* REGRESSION");
+				regression_found = true;
+				this->m_regressions_count++;
+			} else if (is_cost && decreases == runs.size()) {
+				flag = COLOR_GREEN("* IMPROVEMENT");
+			}
+
+			printf(BASELINE_FORMAT, name.c_str(), base_avg, best_avg, best_relative_delta * 100, best_z, increases, (unsigned int) runs.size(), flag.c_str());
+		}
+		return regression_found;
+	}
+
+	/**
+	 * Returns the number of regressions found in all the comparisons done with this object.
+	 */
+	unsigned int BaselineStore::getRegressionsCount() {
+		return this->m_regressions_count;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,371 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * CachedDeterminizationAlgorithm.cpp
+ *
+ *
+ * This source file contains the implementation of the CachedDeterminizationAlgorithm class.
+ */
+
+#include "CachedDeterminizationAlgorithm.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "AutomataSerializer.hpp"
+#include "PhaseProfiler.hpp"
+#include "State.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * The name and the abbreviation of the algorithm are derived from the ones of the inner determinization algorithm.
+	 * The entries of the cache are kept in the directory "cache_directory", which is created at the first store.
+	 */
+	CachedDeterminizationAlgorithm::CachedDeterminizationAlgorithm(DeterminizationAlgorithm* determinization_algorithm, std::string cache_directory)
+	: DeterminizationAlgorithm(
+		CACHE_ABBR_PREFIX + determinization_algorithm->abbr(),
+		determinization_algorithm->name() + " with Cache"
+		), m_determinization_algorithm(determinization_algorithm), m_cache_directory(cache_directory),
+		m_lookups_count(0), m_hits_count(0) {
+		if (!this->m_cache_directory.empty() && this->m_cache_directory.back() != '/') {
+			this->m_cache_directory += '/';
+		}
+	}
+
+	/**
+	 * Destructor.
+	 * ATTENTION: It deletes the inner determinization algorithm.
+	 */
+	CachedDeterminizationAlgorithm::~CachedDeterminizationAlgorithm() {
+		delete this->m_determinization_algorithm;
+	}
+
+	/**
+	 * Resets the values of the runtime statistics, including the ones of the inner algorithm.
+	 */
+	void CachedDeterminizationAlgorithm::resetRuntimeStatsValues() {
+		// Calling parent method
+		DeterminizationAlgorithm::resetRuntimeStatsValues();
+		// Initializing the values
+		map<RuntimeStat, double>& stats = this->getRuntimeStatsValuesRef();
+		for (RuntimeStat stat : this->getRuntimeStatsList()) {
+			stats[stat] = (double) 0;
+		}
+		// Calling method on the inner determinization algorithm
+		this->m_determinization_algorithm->resetRuntimeStatsValues();
+	}
+
+	/**
+	 * Definition of the runtime statistics of the algorithm.
+	 * The statistics of the inner algorithm are included with the prefix "in-"; they're zero when the DFA comes from the cache.
+	 */
+	vector<RuntimeStat> CachedDeterminizationAlgorithm::getRuntimeStatsList() {
+		vector<RuntimeStat> list = DeterminizationAlgorithm::getRuntimeStatsList();
+		for (RuntimeStat stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			list.push_back("in-" + stat);
+		}
+		list.push_back(CACHE_HIT_RATE);					// 100 for a hit, 0 for a miss: the average over the runs is the hit rate
+		list.push_back(CACHE_LOOKUP_TIME);				// Fingerprint, reading of the entry and reconstruction of the DFA
+		list.push_back(CACHED_DETERMINIZATION_TIME);
+		list.push_back(CACHE_STORE_TIME);
+		return list;
+	}
+
+	/** @override **/
+	map<RuntimeStat, double> CachedDeterminizationAlgorithm::getRuntimeStatsValues() {
+		map<RuntimeStat, double> inner_stats = this->m_determinization_algorithm->getRuntimeStatsValues();
+		for (RuntimeStat inner_stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			this->getRuntimeStatsValuesRef()["in-" + inner_stat] = inner_stats[inner_stat];
+		}
+		return this->getRuntimeStatsValuesRef();
+	}
+
+	/**
+	 * Returns the number of lookups in the cache since the construction of the object.
+	 */
+	unsigned long CachedDeterminizationAlgorithm::getLookupsCount() {
+		return this->m_lookups_count;
+	}
+
+	/**
+	 * Returns the number of lookups that found the DFA in the cache since the construction of the object.
+	 */
+	unsigned long CachedDeterminizationAlgorithm::getHitsCount() {
+		return this->m_hits_count;
+	}
+
+	/**
+	 * Private method.
+	 * Returns the name of the file of the cache entry for the NFA with the given fingerprint.
+	 */
+	std::string CachedDeterminizationAlgorithm::getEntryFileName(AutomatonFingerprint& fingerprint) {
+		return this->m_cache_directory + fingerprint.getFingerprintString() + "_" + this->m_determinization_algorithm->abbr() + FILE_EXTENSION_BINARY;
+	}
+
+	/**
+	 * Private method.
+	 * Reads the DFA of the cache entry, if the entry exists and refers to the same NFA of the fingerprint.
+	 * Returns NULL otherwise, or if the entry cannot be read.
+	 */
+	Automaton* CachedDeterminizationAlgorithm::loadEntry(const std::string& file_name, AutomatonFingerprint& fingerprint) {
+		std::ifstream file_in(file_name, std::ios::binary);
+		if (!file_in) {
+			DEBUG_LOG("No cache entry in the file \"%s\"", file_name.c_str());
+			return NULL;
+		}
+		std::stringstream content;
+		content << file_in.rdbuf();
+		std::string buffer = content.str();
+		BinaryReader reader = BinaryReader(buffer);
+
+		const std::vector<State*>& nfa_states = fingerprint.getCanonicalStates();
+		std::vector<State*> states;
+		try {
+			if (reader.readUInt32() != CACHE_ENTRY_MAGIC_NUMBER || reader.readUInt32() != CACHE_ENTRY_FORMAT_VERSION
+					|| reader.readString() != this->m_determinization_algorithm->abbr()) {
+				DEBUG_LOG_ERROR("The file \"%s\" is not a valid cache entry", file_name.c_str());
+				return NULL;
+			}
+			// The fingerprints of different NFAs can collide, the canonical forms can't
+			if (reader.readString() != fingerprint.getCanonicalForm()) {
+				DEBUG_LOG("The cache entry \"%s\" refers to a different NFA", file_name.c_str());
+				return NULL;
+			}
+
+			uint32_t labels_count = reader.readUInt32();
+			std::vector<std::string> labels;
+			for (uint32_t i = 0; i < labels_count; i++) {
+				labels.push_back(reader.readString());
+			}
+
+			uint32_t states_count = reader.readUInt32();
+			for (uint32_t i = 0; i < states_count; i++) {
+				std::string name;
+				if (reader.readUInt32() == CACHE_NAME_EXTENSION) {
+					// The name is rebuilt from the states of the current NFA, as ConstructedState does
+					uint32_t extension_size = reader.readUInt32();
+					std::vector<std::string> names;
+					for (uint32_t j = 0; j < extension_size; j++) {
+						uint32_t index = reader.readUInt32();
+						if (index >= nfa_states.size()) {
+							throw "Invalid state index in the cache entry";
+						}
+						names.push_back(nfa_states[index]->getName());
+					}
+					std::sort(names.begin(), names.end());
+					name = "{";
+					for (std::string& nfa_name : names) {
+						name += nfa_name + ',';
+					}
+					name.back() = '}';
+				} else {
+					name = reader.readString();
+				}
+				bool final = reader.readUInt32() != 0;
+				states.push_back(new State(name, final));
+			}
+
+			uint32_t initial_index = reader.readUInt32();
+			uint32_t transitions_count = reader.readUInt32();
+			for (uint32_t i = 0; i < transitions_count; i++) {
+				uint32_t from = reader.readUInt32();
+				uint32_t label = reader.readUInt32();
+				uint32_t to = reader.readUInt32();
+				if (from >= states_count || label >= labels_count || to >= states_count) {
+					throw "Invalid transition in the cache entry";
+				}
+				states[from]->connectChild(labels[label], states[to]);
+			}
+			if (initial_index != NO_INITIAL_STATE && initial_index >= states_count) {
+				throw "Invalid initial state in the cache entry";
+			}
+
+			Automaton* dfa = new Automaton();
+			for (State* state : states) {
+				dfa->addState(state);
+			}
+			// The initial state is set at the end, because it computes the distances of all the states
+			if (initial_index != NO_INITIAL_STATE) {
+				dfa->setInitialState(states[initial_index]);
+			}
+			return dfa;
+
+		} catch (const char* message) {
+			DEBUG_LOG_ERROR("Cannot read the cache entry \"%s\": %s", file_name.c_str(), message);
+			for (State* state : states) {
+				delete state;
+			}
+			return NULL;
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Writes the DFA in the cache entry of the NFA.
+	 * The name of each state of the DFA is saved as the canonical indices of the states of the NFA it's made of, when possible,
+	 * so that the names can be rebuilt for an NFA equal to this one but with different names.
+	 * The entry is written on a temporary file and then renamed, so that a reader never finds an incomplete entry.
+	 * Any failure is logged and ignored, since the cache is only an optimization.
+	 */
+	void CachedDeterminizationAlgorithm::storeEntry(const std::string& file_name, AutomatonFingerprint& fingerprint, Automaton* dfa) {
+		if (mkdir(this->m_cache_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+			DEBUG_LOG_ERROR("Cannot create the directory \"%s\" of the cache", this->m_cache_directory.c_str());
+			return;
+		}
+
+		// Names of the NFA states
+		std::map<std::string, uint32_t> nfa_indices;
+		for (State* nfa_state : fingerprint.getCanonicalStates()) {
+			nfa_indices[nfa_state->getName()] = fingerprint.getCanonicalIndex(nfa_state);
+		}
+
+		std::vector<State*> states = dfa->getStatesVector();
+		std::map<State*, uint32_t> state_indices;
+		for (uint32_t i = 0; i < states.size(); i++) {
+			state_indices[states[i]] = i;
+		}
+		std::map<std::string, uint32_t> label_indices;
+		std::vector<std::string> labels;
+		std::vector<uint32_t> transitions;
+		for (State* state : states) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (label_indices.count(pair.first) == 0) {
+					label_indices[pair.first] = labels.size();
+					labels.push_back(pair.first);
+				}
+				for (State* child : pair.second) {
+					transitions.push_back(state_indices[state]);
+					transitions.push_back(label_indices[pair.first]);
+					transitions.push_back(state_indices[child]);
+				}
+			}
+		}
+
+		BinaryWriter writer = BinaryWriter();
+		writer.writeUInt32(CACHE_ENTRY_MAGIC_NUMBER);
+		writer.writeUInt32(CACHE_ENTRY_FORMAT_VERSION);
+		writer.writeString(this->m_determinization_algorithm->abbr());
+		writer.writeBytes(fingerprint.getCanonicalForm());
+
+		writer.writeUInt32(labels.size());
+		for (std::string& label : labels) {
+			writer.writeString(label);
+		}
+
+		writer.writeUInt32(states.size());
+		for (State* state : states) {
+			// A name "{a,b,...}" whose parts are all names of NFA states is saved as the indices of those states;
+			// the encoding is used only if it gives back the same name
+			const std::string& name = state->getName();
+			std::vector<std::string> parts;
+			bool is_extension = name.length() > 2 && name.front() == '{' && name.back() == '}';
+			if (is_extension) {
+				std::stringstream stream(name.substr(1, name.length() - 2));
+				std::string part;
+				while (std::getline(stream, part, ',')) {
+					parts.push_back(part);
+				}
+				std::string rebuilt_name = "{";
+				for (std::string& part : parts) {
+					is_extension = is_extension && nfa_indices.count(part) > 0;
+					rebuilt_name += part + ',';
+				}
+				rebuilt_name.back() = '}';
+				is_extension = is_extension && !parts.empty() && rebuilt_name == name && std::is_sorted(parts.begin(), parts.end());
+			}
+			if (is_extension) {
+				writer.writeUInt32(CACHE_NAME_EXTENSION);
+				writer.writeUInt32(parts.size());
+				for (std::string& part : parts) {
+					writer.writeUInt32(nfa_indices[part]);
+				}
+			} else {
+				writer.writeUInt32(CACHE_NAME_RAW);
+				writer.writeString(name);
+			}
+			writer.writeUInt32(state->isFinal() ? 1 : 0);
+		}
+
+		State* initial_state = dfa->getInitialState();
+		writer.writeUInt32(initial_state != NULL ? state_indices[initial_state] : NO_INITIAL_STATE);
+		writer.writeUInt32(transitions.size() / 3);
+		for (uint32_t value : transitions) {
+			writer.writeUInt32(value);
+		}
+
+		// The temporary file is private to this process and to this object, since the server runs an instance per worker thread
+		std::string temp_file_name = file_name + "." + std::to_string(getpid()) + "." + std::to_string((unsigned long) this) + ".tmp";
+		std::ofstream file_out(temp_file_name, std::ios::binary | std::ios::trunc);
+		if (!file_out) {
+			DEBUG_LOG_ERROR("Cannot open the file \"%s\"", temp_file_name.c_str());
+			return;
+		}
+		file_out.write(writer.getBuffer().data(), writer.getBuffer().length());
+		file_out.close();
+		if (!file_out || std::rename(temp_file_name.c_str(), file_name.c_str()) != 0) {
+			DEBUG_LOG_ERROR("Cannot write the cache entry \"%s\"", file_name.c_str());
+			std::remove(temp_file_name.c_str());
+		}
+	}
+
+	/**
+	 * Returns the DFA equivalent to the NFA, read from the cache if present.
+	 * Otherwise, the DFA is computed by the inner determinization algorithm and saved in the cache.
+	 */
+	Automaton* CachedDeterminizationAlgorithm::run(Automaton* nfa) {
+		Automaton* dfa;		// Declarations
+		std::string file_name;
+		AutomatonFingerprint* fingerprint;
+
+		DEBUG_MARK_PHASE("Cache lookup") {
+			ScopedPhase lookup_phase("Cache lookup");
+			TRACE_SPAN("Cache lookup");
+			fingerprint = new AutomatonFingerprint(nfa);
+			file_name = this->getEntryFileName(*fingerprint);
+			dfa = this->loadEntry(file_name, *fingerprint);
+			this->getRuntimeStatsValuesRef()[CACHE_LOOKUP_TIME] = lookup_phase.stop();
+		}
+		this->m_lookups_count++;
+
+		if (dfa != NULL) {
+			DEBUG_LOG("The DFA has been found in the cache entry \"%s\"", file_name.c_str());
+			this->m_hits_count++;
+			this->getRuntimeStatsValuesRef()[CACHE_HIT_RATE] = 100;
+
+		} else {
+			this->getRuntimeStatsValuesRef()[CACHE_HIT_RATE] = 0;
+
+			DEBUG_MARK_PHASE("Determinization with <%s>", this->m_determinization_algorithm->name().c_str()) {
+				ScopedPhase det_phase("Determinization");
+				TRACE_SPAN("Determinization");
+				dfa = this->m_determinization_algorithm->run(nfa);
+				this->getRuntimeStatsValuesRef()[CACHED_DETERMINIZATION_TIME] = det_phase.stop();
+			}
+
+			DEBUG_MARK_PHASE("Cache store") {
+				ScopedPhase store_phase("Cache store");
+				TRACE_SPAN("Cache store");
+				this->storeEntry(file_name, *fingerprint, dfa);
+				this->getRuntimeStatsValuesRef()[CACHE_STORE_TIME] = store_phase.stop();
+			}
+		}
+
+		delete fingerprint;
+		this->collectOperationCounts();
+		return dfa;
+	}
+
+} /* namespace quicksc */
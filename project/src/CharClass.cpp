@@ -0,0 +1,318 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * CharClass.cpp
+ *
+ *
+ * This source file contains the implementation of the CharClass class.
+ */
+
+#include "CharClass.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <set>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor of the empty class.
+	 */
+	CharClass::CharClass() {}
+
+	/**
+	 * Constructor of the class containing the code points of a (closed) interval.
+	 */
+	CharClass::CharClass(uint32_t first, uint32_t last) {
+		this->add(first, last);
+	}
+
+	/**
+	 * Destructor.
+	 */
+	CharClass::~CharClass() {}
+
+	/**
+	 * Private static method.
+	 * Appends a code point to a label, as a raw character if it's an ASCII letter or digit, or as "\x{HEX}" otherwise.
+	 */
+	void CharClass::appendAtom(std::string& label, uint32_t code_point) {
+		if (code_point < 128 && std::isalnum((int) code_point)) {
+			label += (char) code_point;
+		} else {
+			char buffer[16];
+			snprintf(buffer, sizeof(buffer), "\\x{%X}", code_point);
+			label += buffer;
+		}
+	}
+
+	/**
+	 * Private static method.
+	 * Reads an atom of a label starting from the position, and moves the position after it.
+	 */
+	uint32_t CharClass::parseAtom(const std::string& label, unsigned long& position) {
+		if (label[position] != '\\') {
+			return (unsigned char) label[position++];
+		}
+		unsigned long closing = label.find('}', position);
+		if (label.compare(position, 3, "\\x{") != 0 || closing == std::string::npos || closing == position + 3) {
+			DEBUG_LOG_ERROR("Invalid escape sequence in the class label \"%s\"", label.c_str());
+			throw "Invalid escape sequence in a class label";
+		}
+		uint32_t code_point = 0;
+		for (unsigned long i = position + 3; i < closing; i++) {
+			if (!std::isxdigit((unsigned char) label[i]) || code_point > (CHAR_CLASS_MAX_CODE_POINT >> 4)) {
+				DEBUG_LOG_ERROR("Invalid code point in the class label \"%s\"", label.c_str());
+				throw "Invalid code point in a class label";
+			}
+			char digit = std::tolower((unsigned char) label[i]);
+			code_point = (code_point << 4) | (uint32_t) (std::isdigit((unsigned char) digit) ? (digit - '0') : (digit - 'a' + 10));
+		}
+		if (code_point > CHAR_CLASS_MAX_CODE_POINT) {
+			DEBUG_LOG_ERROR("Invalid code point in the class label \"%s\"", label.c_str());
+			throw "Invalid code point in a class label";
+		}
+		position = closing + 1;
+		return code_point;
+	}
+
+	/**
+	 * Returns true if the label has the form of a class, i.e. it's enclosed in square brackets.
+	 * The content of the brackets is not checked.
+	 */
+	bool CharClass::isClassLabel(const std::string& label) {
+		return label.size() >= 2 && label.front() == CHAR_CLASS_OPEN && label.back() == CHAR_CLASS_CLOSE;
+	}
+
+	/**
+	 * Returns the class written in the label.
+	 * An exception is thrown if the label is not a valid class.
+	 */
+	CharClass CharClass::fromLabel(const std::string& label) {
+		if (!CharClass::isClassLabel(label)) {
+			DEBUG_LOG_ERROR("The label \"%s\" is not a class", label.c_str());
+			throw "The label is not a class";
+		}
+		CharClass result;
+		unsigned long position = 1;
+		const unsigned long end = label.size() - 1;
+		while (position < end) {
+			uint32_t first = CharClass::parseAtom(label, position);
+			uint32_t last = first;
+			if (position + 1 < end && label[position] == '-') {
+				position++;
+				last = CharClass::parseAtom(label, position);
+			}
+			if (position > end || last < first) {
+				DEBUG_LOG_ERROR("Invalid range in the class label \"%s\"", label.c_str());
+				throw "Invalid range in a class label";
+			}
+			result.add(first, last);
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the minterms of the classes passed as parameter, i.e. the coarsest partition of their union such that
+	 * every class is a union of minterms. The decomposition of each class is returned in the second parameter, as the indexes
+	 * of its minterms.
+	 * The minterms are computed with a sweep over the bounds of the intervals: the code points between two consecutive bounds
+	 * belong to the same classes, and the pieces covered by the same classes are gathered into the same minterm.
+	 */
+	std::vector<CharClass> CharClass::computeMinterms(const std::vector<CharClass>& classes, std::vector<std::vector<unsigned long>>& decompositions) {
+		// Events of the sweep: a class enters at the beginning of each of its intervals, and leaves after the end
+		std::vector<std::pair<uint64_t, long>> events;
+		for (unsigned long index = 0; index < classes.size(); index++) {
+			for (auto &interval : classes[index].m_intervals) {
+				events.push_back({ interval.first, (long) index });
+				events.push_back({ (uint64_t) interval.second + 1, -(long) index - 1 });
+			}
+		}
+		std::sort(events.begin(), events.end());
+
+		std::vector<CharClass> minterms;
+		std::map<std::vector<unsigned long>, unsigned long> minterms_indexes;		// Minterm of each set of classes
+		decompositions = std::vector<std::vector<unsigned long>>(classes.size());
+		std::set<unsigned long> active;
+		unsigned long position = 0;
+		while (position < events.size()) {
+			uint64_t bound = events[position].first;
+			for (; position < events.size() && events[position].first == bound; position++) {
+				if (events[position].second >= 0) {
+					active.insert(events[position].second);
+				} else {
+					active.erase(-events[position].second - 1);
+				}
+			}
+			if (active.empty()) {
+				continue;
+			}
+			// The piece between this bound and the next one belongs to the active classes
+			DEBUG_ASSERT_TRUE(position < events.size());
+			std::vector<unsigned long> signature = std::vector<unsigned long>(active.begin(), active.end());
+			auto iterator = minterms_indexes.find(signature);
+			if (iterator == minterms_indexes.end()) {
+				iterator = minterms_indexes.insert({ signature, minterms.size() }).first;
+				minterms.push_back(CharClass());
+				for (unsigned long index : signature) {
+					decompositions[index].push_back(iterator->second);
+				}
+			}
+			minterms[iterator->second].add(bound, events[position].first - 1);
+		}
+		return minterms;
+	}
+
+	/**
+	 * Returns the canonical textual form of the class.
+	 */
+	std::string CharClass::toLabel() const {
+		std::string label = std::string(1, CHAR_CLASS_OPEN);
+		for (auto &interval : this->m_intervals) {
+			CharClass::appendAtom(label, interval.first);
+			if (interval.second > interval.first) {
+				label += '-';
+				CharClass::appendAtom(label, interval.second);
+			}
+		}
+		label += CHAR_CLASS_CLOSE;
+		return label;
+	}
+
+	/**
+	 * Adds the code points of a (closed) interval to the class.
+	 */
+	void CharClass::add(uint32_t first, uint32_t last) {
+		DEBUG_ASSERT_TRUE(first <= last);
+		// The first interval that could touch the new one, i.e. that doesn't end before it
+		auto iterator = std::lower_bound(this->m_intervals.begin(), this->m_intervals.end(), first,
+				[](const std::pair<uint32_t, uint32_t>& interval, uint32_t value) {
+					return (uint64_t) interval.second + 1 < value;
+				});
+		// The touched intervals are merged into the new one
+		auto merged_end = iterator;
+		while (merged_end != this->m_intervals.end() && merged_end->first <= (uint64_t) last + 1) {
+			first = std::min(first, merged_end->first);
+			last = std::max(last, merged_end->second);
+			merged_end++;
+		}
+		iterator = this->m_intervals.erase(iterator, merged_end);
+		this->m_intervals.insert(iterator, { first, last });
+	}
+
+	/**
+	 * Returns the union of the two classes.
+	 */
+	CharClass CharClass::unite(const CharClass& other) const {
+		CharClass result = *this;
+		for (auto &interval : other.m_intervals) {
+			result.add(interval.first, interval.second);
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the intersection of the two classes.
+	 */
+	CharClass CharClass::intersect(const CharClass& other) const {
+		CharClass result;
+		auto first_iterator = this->m_intervals.begin();
+		auto second_iterator = other.m_intervals.begin();
+		while (first_iterator != this->m_intervals.end() && second_iterator != other.m_intervals.end()) {
+			uint32_t first = std::max(first_iterator->first, second_iterator->first);
+			uint32_t last = std::min(first_iterator->second, second_iterator->second);
+			if (first <= last) {
+				// The intervals of the result are already sorted and disjoint
+				result.m_intervals.push_back({ first, last });
+			}
+			if (first_iterator->second < second_iterator->second) {
+				first_iterator++;
+			} else {
+				second_iterator++;
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the code points of this class not contained in the other one.
+	 */
+	CharClass CharClass::subtract(const CharClass& other) const {
+		return this->intersect(other.complement());
+	}
+
+	/**
+	 * Returns the code points not contained in the class, up to the largest code point.
+	 */
+	CharClass CharClass::complement() const {
+		CharClass result;
+		uint64_t next = 0;
+		for (auto &interval : this->m_intervals) {
+			if (interval.first > next) {
+				result.m_intervals.push_back({ (uint32_t) next, interval.first - 1 });
+			}
+			next = (uint64_t) interval.second + 1;
+		}
+		if (next <= CHAR_CLASS_MAX_CODE_POINT) {
+			result.m_intervals.push_back({ (uint32_t) next, CHAR_CLASS_MAX_CODE_POINT });
+		}
+		return result;
+	}
+
+	/**
+	 * Returns true if the class contains no code point.
+	 */
+	bool CharClass::isEmpty() const {
+		return this->m_intervals.empty();
+	}
+
+	/**
+	 * Returns true if the class contains the code point.
+	 */
+	bool CharClass::contains(uint32_t code_point) const {
+		auto iterator = std::lower_bound(this->m_intervals.begin(), this->m_intervals.end(), code_point,
+				[](const std::pair<uint32_t, uint32_t>& interval, uint32_t value) {
+					return interval.second < value;
+				});
+		return iterator != this->m_intervals.end() && iterator->first <= code_point;
+	}
+
+	/**
+	 * Returns the number of code points contained in the class.
+	 */
+	uint64_t CharClass::getCharsCount() const {
+		uint64_t count = 0;
+		for (auto &interval : this->m_intervals) {
+			count += (uint64_t) interval.second - interval.first + 1;
+		}
+		return count;
+	}
+
+	/**
+	 * Returns the intervals of the class, sorted, disjoint and not adjacent.
+	 */
+	const std::vector<std::pair<uint32_t, uint32_t>>& CharClass::getIntervalsRef() const {
+		return this->m_intervals;
+	}
+
+	/**
+	 * Returns true if the two classes contain the same code points.
+	 */
+	bool CharClass::operator==(const CharClass& other) const {
+		return this->m_intervals == other.m_intervals;
+	}
+
+	/**
+	 * Lexicographic order of the intervals, used to store classes in ordered containers.
+	 */
+	bool CharClass::operator<(const CharClass& other) const {
+		return this->m_intervals < other.m_intervals;
+	}
+
+} /* namespace quicksc */
@@ -13,6 +13,7 @@
 #include <fstream>
 #include <regex>
 #include <ctime>
+#include <cmath>
 
 #include "AutomataGenerator.hpp"
 #include "ProblemGenerator.hpp"
@@ -260,12 +261,36 @@ namespace quicksc {
 		load(EpsilonPercentage, 0.2);
 		load(AutomatonMaxDistance, 20);
 		load(AutomatonSafeZoneDistance, 10);
+		load(AlphabetZipfExponent, 0.0);					// The exponent of the Zipf distribution of the labels (0 = uniform distribution)
+		load(AutomatonComponents, 4);						// The number of components (DFAs of a union, phases of a protocol)
+		load(PerturbationCount, 1);							// The number of non-deterministic transitions injected in the DFA of a perturbation problem
+		load(PerturbationDepth, 0);							// The distance from the initial state of the origins of the injected transitions
+		load(StreamingGeneration, false);					// If it's true, the NFAs are generated by the streaming generator (for large sizes)
 
 		// Modules and special properties
 		load(ActiveAutomatonPruning, true); 				// If it's true, the automaton is pruned before the computation
 		load(ActiveRemovingLabel, true); 					// If it's true, a special label is used to refer to the epsilon transitions, that has to be removed in the end
 		load(ActiveDistanceCheckInTranslation, false); 		// If it's true, the translation generates the singularities only if they satisfy a distance constraint [TODO: it's a bugged feature]
 
+		// Scaling-curve mode
+		load(ScalingMode, false);							// If it's true, the session grows a parameter geometrically and fits the complexity exponents
+		load(ScalingParameter, (int) AutomatonSize);		// The parameter to grow, written in the file with its abbreviation
+		load(ScalingFactor, 2.0);							// The growth factor of the parameter, at each step
+		load(ScalingTimeBudget, 1000.0);					// The average time (in ms) after which an algorithm stops being measured
+		load(ScalingMaxPoints, 12);							// The maximum number of steps
+
+		// Baseline comparison
+		load(BaselineThreshold, 0.25);						// The relative increase of a cost statistic (time, memory) that is considered a regression
+		load(BaselineRuns, 3);								// The number of runs of a test case compared with the baseline; a regression must appear in all of them
+
+		// Isolated runs
+		load(IsolationMode, false);							// If it's true, every algorithm run is executed in a forked child process
+		load(IsolationShipSolution, true);					// If it's true, the isolated child sends back the solution, otherwise only its size
+
+		// Background generation
+		load(GenerationThreads, 0);							// The number of threads generating the problems in background (0 = generation in the solver thread)
+		load(GenerationQueueDepth, 2);						// The maximum number of problems generated in advance
+
 		load(PrintStatistics, true);
 		load(LogStatistics, true);
 		load(LogStatisticsMin, false);
@@ -274,6 +299,7 @@ namespace quicksc {
 		load(LogStatisticsDev, true);
 		load(PrintOriginalAutomaton, false);
 		load(PrintSolutionAutomaton, false);
+		load(PrintPhases, false);							// If it's true, the tree of the phases of every algorithm is printed for every problem
 		load(DrawOriginalAutomaton, false);
 		load(DrawSolutionAutomaton, false);
 	}
@@ -358,6 +384,17 @@ namespace quicksc {
 					if (line_setting == setting.m_name || line_setting == setting.m_abbr) {
 						DEBUG_LOG("Identificata impostazione del valore del parametro con ID = %2d: <%s> = %s", setting.m_id, setting.m_name.c_str(), line_value.c_str());
 
+						// The scaling parameter is another setting, given by its abbreviation or name (the IDs change with the enumeration)
+						if (setting.m_id == ScalingParameter) {
+							SettingID parameter = Configurations::idOf(line_value);
+							if (parameter == SETTINGID_END) {
+								DEBUG_LOG_ERROR("The scaling parameter \"%s\" is not a setting", line_value.c_str());
+								throw "Unknown setting as scaling parameter";
+							}
+							load(setting.m_id, (int) parameter);
+							break;
+						}
+
 						// Split the string of values in the corresponding values (with comma as delimiter)
 						auto const reg = std::regex{","};
 						auto const vec = std::vector<string>(
@@ -394,9 +431,25 @@ namespace quicksc {
 			{ AutomatonTransitionsPercentage , "Automaton's transitions percentage", 	"%transitions", true },
 			{ AutomatonMaxDistance , 		"Automaton's max distance", 				"maxdist", true },
 			{ AutomatonSafeZoneDistance , 	"Automaton's safe-zone distance", 			"safezonedist", true },
+			{ AlphabetZipfExponent , 		"Zipf exponent of the labels frequency", 	"zipf", true },
+			{ AutomatonComponents , 		"Automaton's components", 					"#components", true },
+			{ PerturbationCount , 			"Perturbations of the DFA", 				"#perturbations", true },
+			{ PerturbationDepth , 			"Perturbations depth", 						"perturbdepth", true },
+			{ StreamingGeneration , 		"Streaming generation of the automata", 	"?streaming", false },
 			{ ActiveAutomatonPruning , 		"Active \"automaton pruning\"", 			"?autompruning", false },
 			{ ActiveRemovingLabel , 		"Active \"removing label\"", 				"?removlabel", false },
 			{ ActiveDistanceCheckInTranslation , "Active \"distance check in translation\"", "?distcheck",  false },
+			{ ScalingMode , 				"Scaling-curve mode", 						"?scaling", false },
+			{ ScalingParameter , 			"Scaling parameter", 						"scalingparam", false },
+			{ ScalingFactor , 				"Scaling growth factor", 					"scalingfactor", false },
+			{ ScalingTimeBudget , 			"Scaling time budget per algorithm [ms]", 	"scalingbudget", false },
+			{ ScalingMaxPoints , 			"Scaling maximum number of points", 		"#scalingpoints", false },
+			{ BaselineThreshold , 			"Baseline regression threshold", 			"%regthreshold", false },
+			{ BaselineRuns , 				"Baseline comparison runs", 				"#regruns", false },
+			{ IsolationMode , 				"Isolated runs in child processes", 		"?isolation", false },
+			{ IsolationShipSolution , 		"Isolated runs send back the solution", 	"?isolsolution", false },
+			{ GenerationThreads , 			"Background generation threads", 			"#genthreads", false },
+			{ GenerationQueueDepth , 		"Background generation queue depth", 		"#gendepth", false },
 			{ PrintStatistics , 			"Print statistics", 						"?pstats", false },
 			{ LogStatistics , 				"Log statistics in file", 					"?lstats", false },
 			{ LogStatisticsMin , 			"Log in file the minimum value of a stat", 	"?lstatsmin", false},
@@ -405,6 +458,7 @@ namespace quicksc {
 			{ LogStatisticsDev , 			"Log in file the standard deviation value of a stat", 	"?lstatsdev", false},
 			{ PrintOriginalAutomaton , 		"Print original automaton", 				"?porig", false },
 			{ PrintSolutionAutomaton , 		"Print solution solution", 					"?psolu", false },
+			{ PrintPhases , 				"Print the phases of the algorithms", 		"?pphases", false },
 			{ DrawOriginalAutomaton , 		"Draw original automaton", 					"?dorig", false },
 			{ DrawSolutionAutomaton , 		"Draw solution automaton", 					"?dsolu", false },
 	};
@@ -425,6 +479,20 @@ namespace quicksc {
 		return Configurations::getSetting(id).m_abbr;
 	}
 	
+	/**
+	 * Static method.
+	 * Returns the ID of the configuration parameter with the given abbreviation or name, or SETTINGID_END if there's none.
+	 */
+	SettingID Configurations::idOf(const string& name) {
+		for (int sett_id = 0; sett_id < SETTINGID_END; sett_id++) {
+			const Setting& setting = Configurations::settings_list[sett_id];
+			if (name == setting.m_abbr || name == setting.m_name) {
+				return setting.m_id;
+			}
+		}
+		return SETTINGID_END;
+	}
+
 	/** 
 	 * Static method.
 	 * Returns a boolean flag indicating whether the value of the parameter must
@@ -483,6 +551,39 @@ namespace quicksc {
 	}
 
 
+	/**
+	 * Overrides the value of a setting in the current session with a single value.
+	 * The original value is kept aside, and it can be restored with the "restoreValue" method.
+	 * The new value keeps the type of the original one: integer settings are rounded to the nearest integer.
+	 */
+	void Configurations::overrideValue(const SettingID& id, double value) {
+		SettingValue* current_value = this->m_settings_instances[this->m_session_index][id];
+		SettingType type = current_value->getType();
+		if (this->m_overridden_values.count(id) == 0) {
+			this->m_overridden_values[id] = current_value;
+		} else {
+			delete current_value;
+		}
+		if (type == INT) {
+			this->m_settings_instances[this->m_session_index][id] = new AtomicSettingValue((int) std::lround(value));
+		} else {
+			this->m_settings_instances[this->m_session_index][id] = new AtomicSettingValue(value);
+		}
+	}
+
+	/**
+	 * Restores the original value of a setting, previously overridden with the "overrideValue" method.
+	 * If the setting has not been overridden, nothing happens.
+	 */
+	void Configurations::restoreValue(const SettingID& id) {
+		if (this->m_overridden_values.count(id) == 0) {
+			return;
+		}
+		delete this->m_settings_instances[this->m_session_index][id];
+		this->m_settings_instances[this->m_session_index][id] = this->m_overridden_values[id];
+		this->m_overridden_values.erase(id);
+	}
+
 	template <class T> T Configurations::valueOf(const SettingID& id) {
 		if (DEBUG_QUERY) {
 			DEBUG_ASSERT_TRUE(this->m_settings_instances[this->m_session_index].count(id));
@@ -43,6 +43,15 @@ namespace quicksc {
         return this->m_name;
     };
 
+    /**
+     * Returns true if the solutions of the algorithm are labeled with the same symbols of the NFA, so that they can be
+     * compared by language equivalence with the solutions of the other algorithms.
+     * By default, the solutions are comparable.
+     */
+    bool DeterminizationAlgorithm::hasComparableSolutions() {
+        return true;
+    }
+
     /**
      * Resets the runtime statistics.
      * The runtime statistics, by definition, are related to a single execution. They are not maintained from one execution to the next. 
@@ -50,14 +59,16 @@ namespace quicksc {
      */
     void DeterminizationAlgorithm::resetRuntimeStatsValues() {
         this->m_runtime_stats_values = map<RuntimeStat, double>();
+        this->m_operations_start = OperationCounters::read();
     };
 
     /**
      * Returns a vector of runtime statistics calculated by the algorithm.
      * Each subclass must implement (if it uses this functionality) this method so that it returns the statistics used.
+     * The base list contains the counters of the primitive operations, which are common to all the algorithms.
      */
 	vector<RuntimeStat> DeterminizationAlgorithm::getRuntimeStatsList() {
-        return vector<RuntimeStat>();
+        return OperationCounters::getRuntimeStatsList();
     }
     
     /**
@@ -78,4 +89,15 @@ namespace quicksc {
         return this->m_runtime_stats_values;
     };
 
+    /**
+     * Saves in the runtime statistics the number of primitive operations performed by the current thread
+     * since the last reset of the statistics. It must be called at the end of the "run" method.
+     */
+    void DeterminizationAlgorithm::collectOperationCounts() {
+        OperationCounts counts = OperationCounters::since(this->m_operations_start);
+        for (int op = 0; op < OPERATION_END; op++) {
+            this->m_runtime_stats_values[OperationCounters::getRuntimeStat((Operation) op)] = counts.values[op];
+        }
+    }
+
 }
@@ -0,0 +1,614 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationServer.cpp
+ *
+ *
+ * This source file contains the implementation of the classes DeterminizationServer and DeterminizationClient.
+ */
+
+#include "DeterminizationServer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "BDDSubsetConstruction.hpp"
+#include "CachedDeterminizationAlgorithm.hpp"
+#include "DeterminizationWithAlphabetCompressionAlgorithm.hpp"
+#include "DeterminizationWithEpsilonRemovalAlgorithm.hpp"
+#include "DeterminizationWithMintermsAlgorithm.hpp"
+#include "DeterminizationWithReductionAlgorithm.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "EpsilonRemovalAlgorithm.hpp"
+#include "Properties.hpp"
+#include "QuickSubsetConstruction.hpp"
+#include "ReductionAlgorithm.hpp"
+#include "SubsetConstruction.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It requires the configurations (used by the algorithms that depend on them), the path of the socket,
+	 * the abbreviation of the algorithm used by the requests that don't specify one, and the number of worker threads.
+	 * The server is not started until the "start" method is called.
+	 */
+	DeterminizationServer::DeterminizationServer(Configurations* configurations, std::string socket_path, std::string default_algorithm, unsigned int workers) {
+		this->m_config_reference = configurations;
+		this->m_socket_path = socket_path;
+		this->m_default_algorithm = default_algorithm;
+		this->m_listen_fd = -1;
+		this->m_wakeup_fds[0] = -1;
+		this->m_wakeup_fds[1] = -1;
+		this->m_algorithms = std::vector<std::list<std::pair<std::string, DeterminizationAlgorithm*>>>((workers > 0) ? workers : 1);
+		this->m_started = false;
+		this->m_stopped = false;
+		this->m_requests_count = 0;
+	}
+
+	/**
+	 * Destructor.
+	 * It stops the server, if it's still running, and deletes the algorithms kept by the workers.
+	 */
+	DeterminizationServer::~DeterminizationServer() {
+		if (this->m_started) {
+			this->stop();
+			this->wait();
+		}
+		for (auto &algorithms : this->m_algorithms) {
+			for (auto &pair : algorithms) {
+				delete pair.second;
+			}
+		}
+	}
+
+	/**
+	 * Static method.
+	 * Returns a new instance of the determinization algorithm with the given abbreviation.
+	 * The abbreviation is read as a sequence of preprocessing stages separated by "+", ending with a determinization
+	 * algorithm: e.g. "ger+qsc" is the QSC algorithm preceded by the global epsilon removal.
+	 */
+	DeterminizationAlgorithm* DeterminizationServer::createAlgorithm(const std::string& abbr, Configurations* configurations) {
+		size_t separator = abbr.find('+');
+		if (separator == std::string::npos) {
+			if (abbr == SC_ABBR) {
+				return new SubsetConstruction();
+			} else if (abbr == ESC_ABBR) {
+				return new EmbeddedSubsetConstruction(configurations);
+			} else if (abbr == QSC_ABBR) {
+				return new QuickSubsetConstruction(configurations);
+			} else if (abbr == BSC_ABBR) {
+				return new BDDSubsetConstruction();
+			}
+			DEBUG_LOG_ERROR("The determinization algorithm \"%s\" does not exist", abbr.c_str());
+			throw "Unknown determinization algorithm";
+		}
+
+		std::string stage = abbr.substr(0, separator);
+		std::string stage_prefix = abbr.substr(0, separator + 1);
+		DeterminizationAlgorithm* inner = DeterminizationServer::createAlgorithm(abbr.substr(separator + 1), configurations);
+		if (stage == NER_ABBR) {
+			return new DeterminizationWithEpsilonRemovalAlgorithm(new NaiveEpsilonRemovalAlgorithm(), inner);
+		} else if (stage == GER_ABBR) {
+			return new DeterminizationWithEpsilonRemovalAlgorithm(new GlobalEpsilonRemovalAlgorithm(), inner);
+		} else if (stage == FBR_ABBR) {
+			return new DeterminizationWithReductionAlgorithm(new BisimulationReductionAlgorithm(FORWARD_REDUCTION), inner);
+		} else if (stage == BBR_ABBR) {
+			return new DeterminizationWithReductionAlgorithm(new BisimulationReductionAlgorithm(BACKWARD_REDUCTION), inner);
+		} else if (stage == FSR_ABBR) {
+			return new DeterminizationWithReductionAlgorithm(new SimulationReductionAlgorithm(FORWARD_REDUCTION), inner);
+		} else if (stage == BSR_ABBR) {
+			return new DeterminizationWithReductionAlgorithm(new SimulationReductionAlgorithm(BACKWARD_REDUCTION), inner);
+		} else if (stage_prefix == MINTERMS_ABBR_PREFIX) {
+			return new DeterminizationWithMintermsAlgorithm(inner);
+		} else if (stage_prefix == ALPHABET_COMPRESSION_ABBR_PREFIX) {
+			return new DeterminizationWithAlphabetCompressionAlgorithm(inner);
+		} else if (stage_prefix == CACHE_ABBR_PREFIX) {
+			return new CachedDeterminizationAlgorithm(inner);
+		}
+		delete inner;
+		DEBUG_LOG_ERROR("The preprocessing stage \"%s\" does not exist", stage.c_str());
+		throw "Unknown preprocessing stage of a determinization algorithm";
+	}
+
+	/**
+	 * Static method.
+	 * Writes a message on the socket, prefixed by its length.
+	 */
+	void DeterminizationServer::sendMessage(int fd, const std::string& message) {
+		uint32_t length = (uint32_t) message.length();
+		std::string frame = std::string((const char*) &length, sizeof(length)) + message;
+		size_t sent = 0;
+		while (sent < frame.length()) {
+			// The flag avoids the SIGPIPE signal when the other side has closed the connection
+			ssize_t result = send(fd, frame.data() + sent, frame.length() - sent, MSG_NOSIGNAL);
+			if (result < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				DEBUG_LOG_ERROR("Cannot send a message of %lu bytes on the socket %d", message.length(), fd);
+				throw "Cannot send a message on the socket";
+			}
+			sent += result;
+		}
+	}
+
+	/**
+	 * Static method.
+	 * Reads a message from the socket, written by the "sendMessage" method.
+	 * It returns false if the connection has been closed before the beginning of the message.
+	 */
+	bool DeterminizationServer::receiveMessage(int fd, std::string& message) {
+		uint32_t length = 0;
+		size_t received = 0;
+		while (received < sizeof(length)) {
+			ssize_t result = recv(fd, ((char*) &length) + received, sizeof(length) - received, 0);
+			if (result == 0 && received == 0) {
+				return false;
+			} else if (result < 0 && errno == EINTR) {
+				continue;
+			} else if (result <= 0) {
+				DEBUG_LOG_ERROR("Cannot receive the length of a message from the socket %d", fd);
+				throw "Cannot receive a message from the socket";
+			}
+			received += result;
+		}
+		if (length > SERVER_MAX_MESSAGE_SIZE) {
+			DEBUG_LOG_ERROR("The message of %u bytes exceeds the maximum size", length);
+			throw "The message exceeds the maximum size";
+		}
+		message.resize(length);
+		received = 0;
+		while (received < length) {
+			ssize_t result = recv(fd, message.data() + received, length - received, 0);
+			if (result < 0 && errno == EINTR) {
+				continue;
+			} else if (result <= 0) {
+				DEBUG_LOG_ERROR("Cannot receive a message of %u bytes from the socket %d", length, fd);
+				throw "Cannot receive a message from the socket";
+			}
+			received += result;
+		}
+		return true;
+	}
+
+	/**
+	 * Creates the socket and starts the acceptor and the worker threads.
+	 * A file already existing at the path of the socket (e.g. left by a previous server) is removed.
+	 */
+	void DeterminizationServer::start() {
+		struct sockaddr_un address;
+		if (this->m_socket_path.length() >= sizeof(address.sun_path)) {
+			DEBUG_LOG_ERROR("The path \"%s\" is too long for a socket", this->m_socket_path.c_str());
+			throw "The path of the socket is too long";
+		}
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		strcpy(address.sun_path, this->m_socket_path.c_str());
+
+		this->m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (this->m_listen_fd < 0) {
+			DEBUG_LOG_ERROR("Cannot create the socket of the server");
+			throw "Cannot create the socket of the server";
+		}
+		unlink(this->m_socket_path.c_str());
+		if (bind(this->m_listen_fd, (struct sockaddr*) &address, sizeof(address)) != 0 || listen(this->m_listen_fd, SOMAXCONN) != 0) {
+			DEBUG_LOG_ERROR("Cannot listen on the socket \"%s\"", this->m_socket_path.c_str());
+			close(this->m_listen_fd);
+			this->m_listen_fd = -1;
+			throw "Cannot listen on the socket of the server";
+		}
+
+		// The read end is non-blocking, so that the acceptor can empty it without waiting
+		if (pipe(this->m_wakeup_fds) != 0) {
+			DEBUG_LOG_ERROR("Cannot create the wake-up pipe of the server");
+			close(this->m_listen_fd);
+			this->m_listen_fd = -1;
+			throw "Cannot create the wake-up pipe of the server";
+		}
+		fcntl(this->m_wakeup_fds[0], F_SETFL, O_NONBLOCK);
+
+		this->m_started = true;
+		this->m_stopped = false;
+		for (unsigned int worker = 0; worker < this->m_algorithms.size(); worker++) {
+			this->m_workers.push_back(std::thread(&DeterminizationServer::work, this, worker));
+		}
+		this->m_acceptor = std::thread(&DeterminizationServer::accept, this);
+		DEBUG_LOG("The server is listening on \"%s\" with %lu workers", this->m_socket_path.c_str(), this->m_algorithms.size());
+	}
+
+	/**
+	 * Requests the termination of the server.
+	 * No new connections are accepted, and the open connections are closed after their current request.
+	 * It can be called by any thread, including the workers; the termination is completed by the "wait" method.
+	 */
+	void DeterminizationServer::stop() {
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		if (this->m_stopped) {
+			return;
+		}
+		this->m_stopped = true;
+		// Shutting down the sockets unblocks the threads waiting on them
+		shutdown(this->m_listen_fd, SHUT_RDWR);
+		for (int connection_fd : this->m_active_connections) {
+			shutdown(connection_fd, SHUT_RD);
+		}
+		this->m_pending.notify_all();
+		this->wakeUpAcceptor();
+	}
+
+	/**
+	 * Waits for the termination of the server (requested with the "stop" method, or by a client),
+	 * then closes the socket and removes its file.
+	 */
+	void DeterminizationServer::wait() {
+		if (!this->m_started) {
+			return;
+		}
+		this->m_acceptor.join();
+		for (std::thread& thread : this->m_workers) {
+			thread.join();
+		}
+		this->m_workers.clear();
+		for (int connection_fd : this->m_pending_connections) {
+			close(connection_fd);
+		}
+		this->m_pending_connections.clear();
+		for (int connection_fd : this->m_idle_connections) {
+			close(connection_fd);
+		}
+		this->m_idle_connections.clear();
+		close(this->m_wakeup_fds[0]);
+		close(this->m_wakeup_fds[1]);
+		this->m_wakeup_fds[0] = -1;
+		this->m_wakeup_fds[1] = -1;
+		close(this->m_listen_fd);
+		this->m_listen_fd = -1;
+		unlink(this->m_socket_path.c_str());
+		this->m_started = false;
+	}
+
+	/**
+	 * Returns the number of requests served so far.
+	 */
+	unsigned long DeterminizationServer::getRequestsCount() {
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		return this->m_requests_count;
+	}
+
+	/**
+	 * Private method.
+	 * Wakes up the acceptor thread, so that it updates the set of the connections it's watching.
+	 */
+	void DeterminizationServer::wakeUpAcceptor() {
+		char signal = 0;
+		ssize_t result;
+		do {
+			result = write(this->m_wakeup_fds[1], &signal, 1);
+		} while (result < 0 && errno == EINTR);
+	}
+
+	/**
+	 * Private method.
+	 * Body of the acceptor thread: it accepts the new connections and watches the idle ones.
+	 * When an idle connection receives a request (or is closed by the client), it's put in the queue of the workers.
+	 */
+	void DeterminizationServer::accept() {
+		std::vector<struct pollfd> watched;
+		while (true) {
+			watched.clear();
+			watched.push_back({ this->m_listen_fd, POLLIN, 0 });
+			watched.push_back({ this->m_wakeup_fds[0], POLLIN, 0 });
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				if (this->m_stopped) {
+					return;
+				}
+				for (int connection_fd : this->m_idle_connections) {
+					watched.push_back({ connection_fd, POLLIN, 0 });
+				}
+			}
+
+			if (poll(watched.data(), watched.size(), -1) < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				DEBUG_LOG_ERROR("Cannot wait for the connections on the socket \"%s\"", this->m_socket_path.c_str());
+				return;
+			}
+			if (watched[1].revents != 0) {
+				char signals[64];
+				while (read(this->m_wakeup_fds[0], signals, sizeof(signals)) > 0);
+			}
+
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			if (this->m_stopped) {
+				return;
+			}
+			for (unsigned int i = 2; i < watched.size(); i++) {
+				if (watched[i].revents != 0) {
+					this->m_idle_connections.erase(watched[i].fd);
+					this->m_pending_connections.push_back(watched[i].fd);
+					this->m_pending.notify_one();
+				}
+			}
+			if (watched[0].revents != 0) {
+				int connection_fd = ::accept(this->m_listen_fd, NULL, NULL);
+				if (connection_fd < 0) {
+					if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN) {
+						continue;
+					}
+					DEBUG_LOG_ERROR("Cannot accept a connection on the socket \"%s\"", this->m_socket_path.c_str());
+					return;
+				}
+				// A client cannot keep a worker waiting for the rest of a request indefinitely
+				struct timeval timeout = { SERVER_RECEIVE_TIMEOUT_MS / 1000, (SERVER_RECEIVE_TIMEOUT_MS % 1000) * 1000 };
+				setsockopt(connection_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+				// The connection is served when its first request arrives
+				this->m_idle_connections.insert(connection_fd);
+			}
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Body of a worker thread: it serves the requests of the connections in the queue, one at a time, until the server is stopped.
+	 * After a request, the connection is given back to the acceptor, which waits for the next one.
+	 */
+	void DeterminizationServer::work(unsigned int worker) {
+		while (true) {
+			int connection_fd;
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_pending.wait(lock, [this]() { return this->m_stopped || !this->m_pending_connections.empty(); });
+				if (this->m_stopped) {
+					return;
+				}
+				connection_fd = this->m_pending_connections.front();
+				this->m_pending_connections.pop_front();
+				this->m_active_connections.insert(connection_fd);
+			}
+
+			bool open = false;
+			bool shutdown_requested = false;
+			try {
+				open = this->serve(worker, connection_fd, shutdown_requested);
+			} catch (const char* message) {
+				// A broken connection is closed, without affecting the other ones
+				DEBUG_LOG_ERROR("The connection %d has been closed: %s", connection_fd, message);
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_active_connections.erase(connection_fd);
+				if (open && !shutdown_requested && !this->m_stopped) {
+					this->m_idle_connections.insert(connection_fd);
+					this->wakeUpAcceptor();
+					continue;
+				}
+			}
+			close(connection_fd);
+			if (shutdown_requested) {
+				this->stop();
+			}
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Serves the next request of a connection.
+	 * It returns false if the client has closed the connection, and sets "shutdown_requested" to true if the client has
+	 * requested the termination of the server.
+	 */
+	bool DeterminizationServer::serve(unsigned int worker, int connection_fd, bool& shutdown_requested) {
+		std::string request;
+		if (!DeterminizationServer::receiveMessage(connection_fd, request)) {
+			return false;
+		}
+		BinaryReader reader = BinaryReader(request);
+		std::string response;
+		uint32_t type = SERVER_STATUS_ERROR;
+		try {
+			type = reader.readUInt32();
+			if (type == SERVER_REQUEST_DETERMINIZATION) {
+				response = this->determinize(worker, reader);
+			} else if (type != SERVER_REQUEST_SHUTDOWN) {
+				DEBUG_LOG_ERROR("The request type %u does not exist", type);
+				throw "Unknown type of request";
+			}
+		} catch (const char* message) {
+			BinaryWriter writer = BinaryWriter();
+			writer.writeUInt32(SERVER_STATUS_ERROR);
+			writer.writeString(message);
+			response = writer.getBuffer();
+		}
+
+		if (type == SERVER_REQUEST_SHUTDOWN) {
+			BinaryWriter writer = BinaryWriter();
+			writer.writeUInt32(SERVER_STATUS_OK);
+			DeterminizationServer::sendMessage(connection_fd, writer.getBuffer());
+			shutdown_requested = true;
+			return true;
+		}
+		DeterminizationServer::sendMessage(connection_fd, response);
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		this->m_requests_count++;
+		return true;
+	}
+
+	/**
+	 * Private method.
+	 * Determinizes the NFA of a request with the algorithm of the worker, and returns the response.
+	 * The algorithm is created at its first use, then it's kept for the following requests of the same worker.
+	 * The algorithms of a worker are ordered from the most recently used: when the worker already keeps the maximum
+	 * number of algorithms, the least recently used one is deleted before keeping the new one.
+	 */
+	std::string DeterminizationServer::determinize(unsigned int worker, BinaryReader& reader) {
+		TRACE_SPAN("Server request");
+		std::string abbr = reader.readString();
+		if (abbr.empty()) {
+			abbr = this->m_default_algorithm;
+		}
+		std::list<std::pair<std::string, DeterminizationAlgorithm*>>& algorithms = this->m_algorithms[worker];
+		auto iterator = std::find_if(algorithms.begin(), algorithms.end(), [&abbr](auto &pair) { return pair.first == abbr; });
+		if (iterator != algorithms.end()) {
+			algorithms.splice(algorithms.begin(), algorithms, iterator);
+		} else {
+			DeterminizationAlgorithm* created = DeterminizationServer::createAlgorithm(abbr, this->m_config_reference);
+			if (algorithms.size() >= SERVER_MAX_ALGORITHMS) {
+				DEBUG_LOG("The worker %u deletes the algorithm <%s>, the least recently used", worker, algorithms.back().first.c_str());
+				delete algorithms.back().second;
+				algorithms.pop_back();
+			}
+			algorithms.push_front({ abbr, created });
+		}
+		DeterminizationAlgorithm* algorithm = algorithms.front().second;
+
+		Automaton* nfa = AutomataSerializer::readAutomaton(reader);
+		vector<State*> nfa_states = nfa->getStatesVector();
+		if (nfa->getInitialState() == NULL) {
+			delete nfa;
+			for (State* state : nfa_states) {
+				delete state;
+			}
+			DEBUG_LOG_ERROR("The NFA of the request has no initial state");
+			throw "The NFA has no initial state";
+		}
+		algorithm->resetRuntimeStatsValues();
+		auto start = std::chrono::high_resolution_clock::now();
+		Automaton* dfa;
+		try {
+			dfa = algorithm->run(nfa);
+		} catch (const char* message) {
+			delete nfa;
+			for (State* state : nfa_states) {
+				delete state;
+			}
+			throw message;
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		double run_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e6;
+
+		BinaryWriter writer = BinaryWriter();
+		writer.writeUInt32(SERVER_STATUS_OK);
+		AutomataSerializer::writeAutomaton(writer, dfa);
+		vector<RuntimeStat> stats_list = algorithm->getRuntimeStatsList();
+		map<RuntimeStat, double> stats_values = algorithm->getRuntimeStatsValues();
+		writer.writeUInt32((uint32_t) stats_list.size() + 1);
+		for (RuntimeStat stat : stats_list) {
+			writer.writeString(stat);
+			writer.writeDouble(stats_values[stat]);
+		}
+		writer.writeString(SERVER_RUN_TIME);
+		writer.writeDouble(run_time);
+
+		// The automata are deleted together with their states, since the server lives for many requests
+		vector<State*> dfa_states = dfa->getStatesVector();
+		delete nfa;
+		delete dfa;
+		for (State* state : nfa_states) {
+			delete state;
+		}
+		for (State* state : dfa_states) {
+			delete state;
+		}
+		return writer.getBuffer();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// DeterminizationClient
+
+	/**
+	 * Constructor.
+	 * It opens a connection to the server listening on the given socket, kept open for all the requests of the client.
+	 */
+	DeterminizationClient::DeterminizationClient(std::string socket_path) {
+		struct sockaddr_un address;
+		if (socket_path.length() >= sizeof(address.sun_path)) {
+			DEBUG_LOG_ERROR("The path \"%s\" is too long for a socket", socket_path.c_str());
+			throw "The path of the socket is too long";
+		}
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		strcpy(address.sun_path, socket_path.c_str());
+
+		this->m_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (this->m_fd < 0 || connect(this->m_fd, (struct sockaddr*) &address, sizeof(address)) != 0) {
+			DEBUG_LOG_ERROR("Cannot connect to the server on the socket \"%s\"", socket_path.c_str());
+			if (this->m_fd >= 0) {
+				close(this->m_fd);
+			}
+			throw "Cannot connect to the server";
+		}
+	}
+
+	/**
+	 * Destructor.
+	 * It closes the connection.
+	 */
+	DeterminizationClient::~DeterminizationClient() {
+		close(this->m_fd);
+	}
+
+	/**
+	 * Sends the NFA to the server and returns the DFA computed with the given algorithm (or with the default one of the server,
+	 * if the abbreviation is empty). If "stats" is not NULL, it's filled with the runtime statistics of the execution.
+	 * An error of the server is thrown as an exception.
+	 */
+	Automaton* DeterminizationClient::determinize(Automaton* nfa, const std::string& algorithm, map<RuntimeStat, double>* stats) {
+		BinaryWriter writer = BinaryWriter();
+		writer.writeUInt32(SERVER_REQUEST_DETERMINIZATION);
+		writer.writeString(algorithm);
+		AutomataSerializer::writeAutomaton(writer, nfa);
+		DeterminizationServer::sendMessage(this->m_fd, writer.getBuffer());
+
+		std::string response;
+		if (!DeterminizationServer::receiveMessage(this->m_fd, response)) {
+			DEBUG_LOG_ERROR("The server has closed the connection without a response");
+			throw "The server has closed the connection";
+		}
+		BinaryReader reader = BinaryReader(response);
+		if (reader.readUInt32() != SERVER_STATUS_OK) {
+			// The message is kept in a static buffer, since the exceptions of the project are plain strings
+			static thread_local std::string error_message;
+			error_message = "Server error: " + reader.readString();
+			DEBUG_LOG_ERROR("%s", error_message.c_str());
+			throw error_message.c_str();
+		}
+		Automaton* dfa = AutomataSerializer::readAutomaton(reader);
+		uint32_t stats_count = reader.readUInt32();
+		for (uint32_t i = 0; i < stats_count; i++) {
+			RuntimeStat stat = reader.readString();
+			double value = reader.readDouble();
+			if (stats != NULL) {
+				(*stats)[stat] = value;
+			}
+		}
+		return dfa;
+	}
+
+	/**
+	 * Requests the termination of the server, and waits for its confirmation.
+	 */
+	void DeterminizationClient::shutdownServer() {
+		BinaryWriter writer = BinaryWriter();
+		writer.writeUInt32(SERVER_REQUEST_SHUTDOWN);
+		DeterminizationServer::sendMessage(this->m_fd, writer.getBuffer());
+		std::string response;
+		DeterminizationServer::receiveMessage(this->m_fd, response);
+	}
+
+} /* namespace quicksc */
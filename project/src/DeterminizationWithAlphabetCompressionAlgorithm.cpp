@@ -0,0 +1,211 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithAlphabetCompressionAlgorithm.cpp
+ *
+ *
+ * This source file contains the implementation of the DeterminizationWithAlphabetCompressionAlgorithm class.
+ */
+
+#include "DeterminizationWithAlphabetCompressionAlgorithm.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "Alphabet.hpp"
+#include "PhaseProfiler.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * The name and the abbreviation of the algorithm are derived from the ones of the inner determinization algorithm.
+	 * If "expand_classes" is false, the DFA is returned with the representatives of the classes only.
+	 */
+	DeterminizationWithAlphabetCompressionAlgorithm::DeterminizationWithAlphabetCompressionAlgorithm(DeterminizationAlgorithm* determinization_algorithm, bool expand_classes)
+	: DeterminizationAlgorithm(
+		ALPHABET_COMPRESSION_ABBR_PREFIX + determinization_algorithm->abbr(),
+		determinization_algorithm->name() + " with Alphabet Compression"
+		), m_determinization_algorithm(determinization_algorithm), m_expand_classes(expand_classes) {}
+
+	/**
+	 * Destructor.
+	 * ATTENTION: It deletes the inner determinization algorithm.
+	 */
+	DeterminizationWithAlphabetCompressionAlgorithm::~DeterminizationWithAlphabetCompressionAlgorithm() {
+		delete this->m_determinization_algorithm;
+	}
+
+	/**
+	 * Resets the values of the runtime statistics, including the ones of the inner algorithm.
+	 */
+	void DeterminizationWithAlphabetCompressionAlgorithm::resetRuntimeStatsValues() {
+		// Calling parent method
+		DeterminizationAlgorithm::resetRuntimeStatsValues();
+		// Initializing the values
+		map<RuntimeStat, double>& stats = this->getRuntimeStatsValuesRef();
+		for (RuntimeStat stat : this->getRuntimeStatsList()) {
+			stats[stat] = (double) 0;
+		}
+		// Calling method on the inner determinization algorithm
+		this->m_determinization_algorithm->resetRuntimeStatsValues();
+	}
+
+	/**
+	 * Definition of the runtime statistics of the algorithm.
+	 * The statistics of the inner algorithm are included with the prefix "in-".
+	 */
+	vector<RuntimeStat> DeterminizationWithAlphabetCompressionAlgorithm::getRuntimeStatsList() {
+		vector<RuntimeStat> list = DeterminizationAlgorithm::getRuntimeStatsList();
+		for (RuntimeStat stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			list.push_back("in-" + stat);
+		}
+		list.push_back(ALPHABET_SIZE);					// Number of labels of the NFA, epsilon excluded
+		list.push_back(ALPHABET_CLASSES);				// Number of classes of equivalent labels
+		list.push_back(COMPRESSION_TIME);
+		list.push_back(COMPRESSED_DETERMINIZATION_TIME);
+		list.push_back(EXPANSION_TIME);
+		return list;
+	}
+
+	/** @override **/
+	map<RuntimeStat, double> DeterminizationWithAlphabetCompressionAlgorithm::getRuntimeStatsValues() {
+		map<RuntimeStat, double> inner_stats = this->m_determinization_algorithm->getRuntimeStatsValues();
+		for (RuntimeStat inner_stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			this->getRuntimeStatsValuesRef()["in-" + inner_stat] = inner_stats[inner_stat];
+		}
+		return this->getRuntimeStatsValuesRef();
+	}
+
+	/**
+	 * Returns the map from each label of the last determinized NFA to the representative of its class.
+	 */
+	const std::map<std::string, std::string>& DeterminizationWithAlphabetCompressionAlgorithm::getClassMap() {
+		return this->m_class_map;
+	}
+
+	/**
+	 * Private method.
+	 * Partitions the alphabet of the NFA into classes of equivalent labels, and returns a copy of the NFA
+	 * with only the transitions marked by the representatives of the classes (and the epsilon-transitions).
+	 */
+	Automaton* DeterminizationWithAlphabetCompressionAlgorithm::compressAlphabet(Automaton* nfa) {
+		// Numbering of the states
+		map<State*, unsigned long> numbers;
+		for (State* state : nfa->getStatesList()) {
+			unsigned long number = numbers.size();
+			numbers[state] = number;
+		}
+
+		// Relation of each label, as the sequence of the pairs (parent, child) of its transitions
+		// Since the states are visited in the same order for all the labels, equal relations give equal sequences
+		map<string, vector<std::pair<unsigned long, unsigned long>>> relations;
+		for (State* state : nfa->getStatesList()) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (pair.first == EPSILON) {
+					continue;
+				}
+				vector<std::pair<unsigned long, unsigned long>>& relation = relations[pair.first];
+				for (State* child : pair.second) {
+					relation.push_back({ numbers[state], numbers[child] });
+				}
+			}
+		}
+
+		// Classes of the labels with the same relation; the labels are visited in order, so the representative is the smallest
+		this->m_class_map.clear();
+		map<vector<std::pair<unsigned long, unsigned long>>, string> representatives;
+		for (auto &pair : relations) {
+			auto iterator = representatives.find(pair.second);
+			if (iterator == representatives.end()) {
+				iterator = representatives.insert({ pair.second, pair.first }).first;
+			}
+			this->m_class_map[pair.first] = iterator->second;
+		}
+		this->getRuntimeStatsValuesRef()[ALPHABET_SIZE] = relations.size();
+		this->getRuntimeStatsValuesRef()[ALPHABET_CLASSES] = representatives.size();
+		DEBUG_LOG("The %lu labels of the NFA have been partitioned into %lu classes", relations.size(), representatives.size());
+
+		// Copy of the automaton, with only the transitions marked by the representatives
+		Automaton* compressed_nfa = nfa->relabel([this](const string& label) {
+			auto iterator = this->m_class_map.find(label);
+			if (label != EPSILON && (iterator == this->m_class_map.end() || iterator->second != label)) {
+				return vector<string> {};
+			}
+			return vector<string> { label };
+		});
+		return compressed_nfa;
+	}
+
+	/**
+	 * Private method.
+	 * Copies each transition of the DFA for all the other labels of the class of its label.
+	 */
+	void DeterminizationWithAlphabetCompressionAlgorithm::expandClasses(Automaton* dfa) {
+		// Labels of each class, except the representative
+		map<string, vector<string>> classes;
+		for (auto &pair : this->m_class_map) {
+			if (pair.first != pair.second) {
+				classes[pair.second].push_back(pair.first);
+			}
+		}
+		if (classes.empty()) {
+			return;
+		}
+		for (State* state : dfa->getStatesList()) {
+			// The transitions are copied, since the new ones are added to the same map
+			map<string, set<State*>> transitions = state->getExitingTransitions();
+			for (auto &pair : transitions) {
+				auto iterator = classes.find(pair.first);
+				if (iterator == classes.end()) {
+					continue;
+				}
+				for (State* child : pair.second) {
+					for (const string& label : iterator->second) {
+						state->connectChild(label, child);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Returns the DFA obtained by the inner determinization algorithm, run on the NFA with the compressed alphabet.
+	 */
+	Automaton* DeterminizationWithAlphabetCompressionAlgorithm::run(Automaton* nfa) {
+		Automaton* compressed_nfa, *dfa;	// Declarations
+
+		DEBUG_MARK_PHASE("Alphabet compression") {
+			ScopedPhase compression_phase("Alphabet compression");
+			TRACE_SPAN("Alphabet compression");
+			compressed_nfa = this->compressAlphabet(nfa);
+			this->getRuntimeStatsValuesRef()[COMPRESSION_TIME] = compression_phase.stop();
+		}
+
+		DEBUG_MARK_PHASE("Determinization with <%s>", this->m_determinization_algorithm->name().c_str()) {
+			ScopedPhase det_phase("Determinization");
+			TRACE_SPAN("Determinization");
+			dfa = this->m_determinization_algorithm->run(compressed_nfa);
+			this->getRuntimeStatsValuesRef()[COMPRESSED_DETERMINIZATION_TIME] = det_phase.stop();
+		}
+
+		if (this->m_expand_classes) {
+			DEBUG_MARK_PHASE("Classes expansion") {
+				ScopedPhase expansion_phase("Classes expansion");
+				TRACE_SPAN("Classes expansion");
+				this->expandClasses(dfa);
+				this->getRuntimeStatsValuesRef()[EXPANSION_TIME] = expansion_phase.stop();
+			}
+		}
+
+		delete compressed_nfa;		// The compressed NFA is removed
+		this->collectOperationCounts();
+		return dfa;
+	}
+
+} /* namespace quicksc */
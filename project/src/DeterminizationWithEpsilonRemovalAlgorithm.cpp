@@ -17,7 +17,8 @@
 #include <chrono>
 
 #include "AutomataDrawer.hpp"
-#include "Timer.hpp"
+#include "PhaseProfiler.hpp"
+#include "Trace.hpp"
 
 //#define DEBUG_MODE
 #include "Debug.hpp"
@@ -94,10 +95,10 @@ namespace quicksc {
         DEBUG_MARK_PHASE("Epsilon removal with <%s>", this->m_epsilon_removal_algorithm->name().c_str()) {
             // Note: the epsilon removal algorithm is applied to the clone of the NFA
             // This procedure works directly on the NFA, so we need to clone it
-            MEASURE_MILLISECONDS( er_time ) {
-                nfa_without_epsilons = this->m_epsilon_removal_algorithm->run(nfa_clone);
-            }
-            this->getRuntimeStatsValuesRef()[EPSILON_REMOVAL_TIME] = er_time;
+            ScopedPhase er_phase("Epsilon removal");
+            TRACE_SPAN("Epsilon removal");
+            nfa_without_epsilons = this->m_epsilon_removal_algorithm->run(nfa_clone);
+            this->getRuntimeStatsValuesRef()[EPSILON_REMOVAL_TIME] = er_phase.stop();
         }
 
         DEBUG_LOG("NFA without epsilons:");
@@ -105,13 +106,14 @@ namespace quicksc {
         DEBUG_LOG("%s", drawer->asString().c_str());
 
         DEBUG_MARK_PHASE("Determinization with <%s>", this->m_determinization_algorithm->name().c_str()) {
-            MEASURE_MILLISECONDS( det_time ) {
-                dfa = this->m_determinization_algorithm->run(nfa_without_epsilons);
-            }
-            this->getRuntimeStatsValuesRef()[DETERMINIZATION_TIME] = det_time;
+            ScopedPhase det_phase("Determinization");
+            TRACE_SPAN("Determinization");
+            dfa = this->m_determinization_algorithm->run(nfa_without_epsilons);
+            this->getRuntimeStatsValuesRef()[DETERMINIZATION_TIME] = det_phase.stop();
         }
 
         delete nfa_without_epsilons;  // The NFA without epsilon transitions is removed
+        this->collectOperationCounts();
         return dfa;
     }
 
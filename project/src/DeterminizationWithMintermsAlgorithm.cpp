@@ -0,0 +1,197 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithMintermsAlgorithm.cpp
+ *
+ *
+ * This source file contains the implementation of the DeterminizationWithMintermsAlgorithm class.
+ */
+
+#include "DeterminizationWithMintermsAlgorithm.hpp"
+
+#include "CharClass.hpp"
+#include "PhaseProfiler.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * The name and the abbreviation of the algorithm are derived from the ones of the inner determinization algorithm.
+	 */
+	DeterminizationWithMintermsAlgorithm::DeterminizationWithMintermsAlgorithm(DeterminizationAlgorithm* determinization_algorithm)
+	: DeterminizationAlgorithm(
+		MINTERMS_ABBR_PREFIX + determinization_algorithm->abbr(),
+		determinization_algorithm->name() + " with Minterms"
+		), m_determinization_algorithm(determinization_algorithm) {}
+
+	/**
+	 * Destructor.
+	 * ATTENTION: It deletes the inner determinization algorithm.
+	 */
+	DeterminizationWithMintermsAlgorithm::~DeterminizationWithMintermsAlgorithm() {
+		delete this->m_determinization_algorithm;
+	}
+
+	/**
+	 * Resets the values of the runtime statistics, including the ones of the inner algorithm.
+	 */
+	void DeterminizationWithMintermsAlgorithm::resetRuntimeStatsValues() {
+		// Calling parent method
+		DeterminizationAlgorithm::resetRuntimeStatsValues();
+		// Initializing the values
+		map<RuntimeStat, double>& stats = this->getRuntimeStatsValuesRef();
+		for (RuntimeStat stat : this->getRuntimeStatsList()) {
+			stats[stat] = (double) 0;
+		}
+		// Calling method on the inner determinization algorithm
+		this->m_determinization_algorithm->resetRuntimeStatsValues();
+	}
+
+	/**
+	 * Definition of the runtime statistics of the algorithm.
+	 * The statistics of the inner algorithm are included with the prefix "in-".
+	 */
+	vector<RuntimeStat> DeterminizationWithMintermsAlgorithm::getRuntimeStatsList() {
+		vector<RuntimeStat> list = DeterminizationAlgorithm::getRuntimeStatsList();
+		for (RuntimeStat stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			list.push_back("in-" + stat);
+		}
+		list.push_back(CLASS_LABELS);					// Number of distinct classes labeling the NFA
+		list.push_back(MINTERMS);						// Number of minterms of the classes
+		list.push_back(REFINEMENT_TIME);
+		list.push_back(MINTERMS_DETERMINIZATION_TIME);
+		list.push_back(MERGING_TIME);
+		return list;
+	}
+
+	/**
+	 * Returns false: the DFA is labeled with unions of minterms, while the other algorithms label their DFAs
+	 * with the classes of the NFA, so the two DFAs can accept the same words with different labels.
+	 */
+	bool DeterminizationWithMintermsAlgorithm::hasComparableSolutions() {
+		return false;
+	}
+
+	/** @override **/
+	map<RuntimeStat, double> DeterminizationWithMintermsAlgorithm::getRuntimeStatsValues() {
+		map<RuntimeStat, double> inner_stats = this->m_determinization_algorithm->getRuntimeStatsValues();
+		for (RuntimeStat inner_stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			this->getRuntimeStatsValuesRef()["in-" + inner_stat] = inner_stats[inner_stat];
+		}
+		return this->getRuntimeStatsValuesRef();
+	}
+
+	/**
+	 * Private method.
+	 * Returns a copy of the NFA where each transition labeled with a class is replaced by the transitions labeled
+	 * with the minterms contained in the class.
+	 * The copy is built from scratch (instead of disconnecting the transitions of a clone), since a disconnected
+	 * label would remain among the exiting transitions of the state, with no children.
+	 */
+	Automaton* DeterminizationWithMintermsAlgorithm::refineLabels(Automaton* nfa) {
+		// Collection of the distinct classes
+		vector<CharClass> classes;
+		map<string, unsigned long> classes_indexes;
+		for (string label : nfa->getAlphabet()) {
+			if (CharClass::isClassLabel(label)) {
+				classes_indexes[label] = classes.size();
+				classes.push_back(CharClass::fromLabel(label));
+			}
+		}
+		vector<vector<unsigned long>> decompositions;
+		vector<CharClass> minterms = CharClass::computeMinterms(classes, decompositions);
+		vector<string> minterms_labels;
+		for (const CharClass& minterm : minterms) {
+			minterms_labels.push_back(minterm.toLabel());
+		}
+		this->getRuntimeStatsValuesRef()[CLASS_LABELS] = classes.size();
+		this->getRuntimeStatsValuesRef()[MINTERMS] = minterms.size();
+		DEBUG_LOG("The %lu classes of the NFA have %lu minterms", classes.size(), minterms.size());
+
+		// Copy of the automaton, with the classes refined into minterms
+		Automaton* refined_nfa = nfa->relabel([&classes_indexes, &decompositions, &minterms_labels](const string& label) {
+			auto iterator = classes_indexes.find(label);
+			if (iterator == classes_indexes.end()) {
+				return vector<string> { label };
+			}
+			vector<string> labels;
+			for (unsigned long minterm_index : decompositions[iterator->second]) {
+				labels.push_back(minterms_labels[minterm_index]);
+			}
+			return labels;
+		});
+		return refined_nfa;
+	}
+
+	/**
+	 * Private method.
+	 * Merges the transitions labeled with classes that exit from the same state and enter the same state,
+	 * into a single transition labeled with the union of the classes.
+	 * The entries of the merged labels are removed from the maps of the transitions, so that the DFA has no empty label.
+	 */
+	void DeterminizationWithMintermsAlgorithm::mergeLabels(Automaton* dfa) {
+		for (State* state : dfa->getStatesList()) {
+			map<State*, vector<string>> labels_by_child;
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (CharClass::isClassLabel(pair.first)) {
+					for (State* child : pair.second) {
+						labels_by_child[child].push_back(pair.first);
+					}
+				}
+			}
+			for (auto &pair : labels_by_child) {
+				if (pair.second.size() < 2) {
+					continue;
+				}
+				CharClass merged;
+				for (string label : pair.second) {
+					merged = merged.unite(CharClass::fromLabel(label));
+				}
+				// Since the automaton is a DFA, each label reaches only this child: its entries are erased altogether
+				for (string label : pair.second) {
+					state->disconnectChildren(label);
+				}
+				state->connectChild(merged.toLabel(), pair.first);
+			}
+		}
+	}
+
+	/**
+	 * Returns the DFA obtained by the inner determinization algorithm, run on the NFA with the classes refined into minterms.
+	 * The transitions of the DFA exiting the same state are labeled with disjoint classes.
+	 */
+	Automaton* DeterminizationWithMintermsAlgorithm::run(Automaton* nfa) {
+		Automaton* refined_nfa, *dfa;	// Declarations
+
+		DEBUG_MARK_PHASE("Minterms refinement") {
+			ScopedPhase refinement_phase("Minterms refinement");
+			TRACE_SPAN("Minterms refinement");
+			refined_nfa = this->refineLabels(nfa);
+			this->getRuntimeStatsValuesRef()[REFINEMENT_TIME] = refinement_phase.stop();
+		}
+
+		DEBUG_MARK_PHASE("Determinization with <%s>", this->m_determinization_algorithm->name().c_str()) {
+			ScopedPhase det_phase("Determinization");
+			TRACE_SPAN("Determinization");
+			dfa = this->m_determinization_algorithm->run(refined_nfa);
+			this->getRuntimeStatsValuesRef()[MINTERMS_DETERMINIZATION_TIME] = det_phase.stop();
+		}
+
+		DEBUG_MARK_PHASE("Minterms merging") {
+			ScopedPhase merging_phase("Minterms merging");
+			TRACE_SPAN("Minterms merging");
+			this->mergeLabels(dfa);
+			this->getRuntimeStatsValuesRef()[MERGING_TIME] = merging_phase.stop();
+		}
+
+		delete refined_nfa;		// The refined NFA is removed
+		this->collectOperationCounts();
+		return dfa;
+	}
+
+} /* namespace quicksc */
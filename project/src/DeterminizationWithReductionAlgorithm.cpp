@@ -0,0 +1,108 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * DeterminizationWithReductionAlgorithm.cpp
+ *
+ *
+ * This source file contains the implementation of the DeterminizationWithReductionAlgorithm class.
+ */
+
+#include "DeterminizationWithReductionAlgorithm.hpp"
+
+#include "PhaseProfiler.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * The name and the abbreviation of the algorithm are the concatenation of the ones of the two algorithms used.
+	 */
+	DeterminizationWithReductionAlgorithm::DeterminizationWithReductionAlgorithm(ReductionAlgorithm* reduction_algorithm, DeterminizationAlgorithm* determinization_algorithm)
+	: DeterminizationAlgorithm(
+		reduction_algorithm->abbr() + "+" + determinization_algorithm->abbr(),
+		determinization_algorithm->name() + " with " + reduction_algorithm->name()
+		), m_reduction_algorithm(reduction_algorithm), m_determinization_algorithm(determinization_algorithm) {}
+
+	/**
+	 * Destructor.
+	 * ATTENTION: It deletes the two algorithms used.
+	 */
+	DeterminizationWithReductionAlgorithm::~DeterminizationWithReductionAlgorithm() {
+		delete this->m_reduction_algorithm;
+		delete this->m_determinization_algorithm;
+	}
+
+	/**
+	 * Resets the values of the runtime statistics, including the ones of the inner algorithm.
+	 */
+	void DeterminizationWithReductionAlgorithm::resetRuntimeStatsValues() {
+		// Calling parent method
+		DeterminizationAlgorithm::resetRuntimeStatsValues();
+		// Initializing the values
+		map<RuntimeStat, double>& stats = this->getRuntimeStatsValuesRef();
+		for (RuntimeStat stat : this->getRuntimeStatsList()) {
+			stats[stat] = (double) 0;
+		}
+		// Calling method on the inner determinization algorithm
+		this->m_determinization_algorithm->resetRuntimeStatsValues();
+	}
+
+	/**
+	 * Definition of the runtime statistics of the algorithm.
+	 * The statistics of the inner algorithm are included with the prefix "in-".
+	 */
+	vector<RuntimeStat> DeterminizationWithReductionAlgorithm::getRuntimeStatsList() {
+		vector<RuntimeStat> list = DeterminizationAlgorithm::getRuntimeStatsList();
+		for (RuntimeStat stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			list.push_back("in-" + stat);
+		}
+		list.push_back(REDUCTION_RATIO);				// Percentage of the states of the NFA removed by the reduction
+		list.push_back(REDUCTION_TIME);
+		list.push_back(REDUCED_DETERMINIZATION_TIME);
+		return list;
+	}
+
+	/** @override **/
+	map<RuntimeStat, double> DeterminizationWithReductionAlgorithm::getRuntimeStatsValues() {
+		map<RuntimeStat, double> inner_stats = this->m_determinization_algorithm->getRuntimeStatsValues();
+		for (RuntimeStat inner_stat : this->m_determinization_algorithm->getRuntimeStatsList()) {
+			this->getRuntimeStatsValuesRef()["in-" + inner_stat] = inner_stats[inner_stat];
+		}
+		return this->getRuntimeStatsValuesRef();
+	}
+
+	/**
+	 * Returns the DFA obtained by the inner determinization algorithm, run on the reduced NFA.
+	 * The NFA passed as parameter is not modified.
+	 */
+	Automaton* DeterminizationWithReductionAlgorithm::run(Automaton* nfa) {
+		Automaton* reduced_nfa, *dfa;	// Declarations
+
+		DEBUG_MARK_PHASE("Reduction with <%s>", this->m_reduction_algorithm->name().c_str()) {
+			ScopedPhase reduction_phase("Reduction");
+			TRACE_SPAN("Reduction");
+			reduced_nfa = this->m_reduction_algorithm->run(nfa);
+			this->getRuntimeStatsValuesRef()[REDUCTION_TIME] = reduction_phase.stop();
+			this->getRuntimeStatsValuesRef()[REDUCTION_RATIO] = (nfa->size() == 0) ? 0
+					: 100.0 * (nfa->size() - reduced_nfa->size()) / nfa->size();
+			TRACE_COUNTER("Reduced NFA states", reduced_nfa->size());
+		}
+
+		DEBUG_MARK_PHASE("Determinization with <%s>", this->m_determinization_algorithm->name().c_str()) {
+			ScopedPhase det_phase("Determinization");
+			TRACE_SPAN("Determinization");
+			dfa = this->m_determinization_algorithm->run(reduced_nfa);
+			this->getRuntimeStatsValuesRef()[REDUCED_DETERMINIZATION_TIME] = det_phase.stop();
+		}
+
+		delete reduced_nfa;		// The reduced NFA is removed
+		this->collectOperationCounts();
+		return dfa;
+	}
+
+} /* namespace quicksc */
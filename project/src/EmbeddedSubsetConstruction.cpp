@@ -21,6 +21,7 @@
 //#define DEBUG_MODE
 #include "Debug.hpp"
 #include "Properties.hpp"
+#include "Trace.hpp"
 
 #define REMOVING_LABEL "~"
 
@@ -67,10 +68,8 @@ namespace quicksc {
 		if (this->m_singularities != NULL) {
 			delete this->m_singularities;
 		}
-		if (this->m_nfa) {
-			delete this->m_nfa;
-		}
-		// Nota: non cancello il risultato DFA poiché potrebbe essere ancora utilizzato da metodi esterni
+		// Nota: non cancello l'NFA della precedente esecuzione, che appartiene al chiamante (come per gli altri algoritmi),
+		// né il risultato DFA poiché potrebbe essere ancora utilizzato da metodi esterni
 
 		this->m_singularities = NULL;
 		this->m_nfa = NULL;
@@ -82,8 +81,16 @@ namespace quicksc {
 	 * Restituisce l'automa determinizzato.
 	 */
 	Automaton* EmbeddedSubsetConstruction::run(Automaton* nfa) {
-		this->runAutomatonCheckup(nfa);
-		this->runSingularityProcessing();
+		TRACE_SPAN("ESC");
+		{
+			TRACE_SPAN("ESC checkup");
+			this->runAutomatonCheckup(nfa);
+		}
+		{
+			TRACE_SPAN("ESC singularity processing");
+			this->runSingularityProcessing();
+		}
+		this->collectOperationCounts();
 		return this->m_dfa;
 	}
 
@@ -20,6 +20,7 @@
 
 #include "Properties.hpp"
 #include "State.hpp"
+#include "Trace.hpp"
 #include <deque>
 #include <algorithm>
 
@@ -72,6 +73,7 @@ namespace quicksc {
      * If you want to preserve the original automaton, you should clone it before calling this method.
      */
     Automaton* NaiveEpsilonRemovalAlgorithm::run(Automaton* e_nfa) {
+        TRACE_SPAN("NER");
         IF_DEBUG_ACTIVE( int e_nfa_size = e_nfa->size(); )
 
         // For each state of the e-NFA
@@ -139,6 +141,7 @@ namespace quicksc {
      * This algorithm can delete multiple epsilon transitions at once.
      */
     Automaton* GlobalEpsilonRemovalAlgorithm::run(Automaton* e_nfa) {
+        TRACE_SPAN("GER");
         IF_DEBUG_ACTIVE( int e_nfa_size = e_nfa->size(); )
         DEBUG_LOG("Epsilon removal algorithm started. The automaton has %d states.", e_nfa_size);
 
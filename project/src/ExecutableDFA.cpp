@@ -0,0 +1,251 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ExecutableDFA.cpp
+ *
+ *
+ * This source file contains the implementation of the ExecutableDFA class.
+ */
+
+#include "ExecutableDFA.hpp"
+
+#include <deque>
+#include <set>
+
+#include "Alphabet.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It compiles the DFA passed as parameter into a dense table. Only the states reachable from the initial state are kept.
+	 * The DFA must be deterministic: no epsilon-transitions and at most one child for each label.
+	 */
+	ExecutableDFA::ExecutableDFA(Automaton* dfa) {
+		this->compile(dfa);
+	}
+
+	/**
+	 * Constructor with a class map, associating each label to the representative of its class
+	 * (see DeterminizationWithAlphabetCompressionAlgorithm).
+	 * The DFA is labeled with the representatives only; every other label of a class is encoded with the ID of
+	 * its representative, so the table has a single column for each class.
+	 */
+	ExecutableDFA::ExecutableDFA(Automaton* dfa, const std::map<std::string, std::string>& class_map) {
+		this->compile(dfa);
+		for (auto &pair : class_map) {
+			auto iterator = this->m_symbols_ids.find(pair.second);
+			if (iterator != this->m_symbols_ids.end()) {
+				this->m_symbols_ids[pair.first] = iterator->second;
+			}
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Compiles the DFA into the dense table.
+	 */
+	void ExecutableDFA::compile(Automaton* dfa) {
+		State* initial_state = dfa->getInitialState();
+		if (initial_state == NULL) {
+			DEBUG_LOG_ERROR("Cannot compile a DFA without an initial state");
+			throw "The DFA must have an initial state";
+		}
+
+		// Renumbering of the states in breadth-first order, and collection of the labels
+		std::map<State*, uint32_t> numbers;
+		std::vector<State*> states = { NULL };	// The dead state has no original state
+		std::set<std::string> labels;
+		std::deque<State*> queue = { initial_state };
+		numbers[initial_state] = EXECUTABLE_INITIAL_STATE;
+		states.push_back(initial_state);
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			for (auto &pair : current->getExitingTransitionsRef()) {
+				if (pair.second.empty()) {
+					continue;
+				}
+				if (pair.first == EPSILON || pair.second.size() > 1) {
+					DEBUG_LOG_ERROR("The state %s is not deterministic", current->getName().c_str());
+					throw "Cannot compile a non-deterministic automaton";
+				}
+				labels.insert(pair.first);
+				State* child = *(pair.second.begin());
+				if (numbers.count(child) == 0) {
+					numbers[child] = states.size();
+					states.push_back(child);
+					queue.push_back(child);
+				}
+			}
+		}
+
+		// Symbols, in lexicographic order
+		this->m_symbols = std::vector<std::string>(labels.begin(), labels.end());
+		for (uint32_t id = 0; id < this->m_symbols.size(); id++) {
+			this->m_symbols_ids[this->m_symbols[id]] = id;
+		}
+
+		this->m_states_count = states.size();
+		this->m_columns = this->m_symbols.size() + 1;
+		if ((uint64_t) this->m_states_count * this->m_columns > UINT32_MAX) {
+			DEBUG_LOG_ERROR("The table of %u states and %u columns is too large", this->m_states_count, this->m_columns);
+			throw "The DFA is too large to be compiled";
+		}
+
+		// Table of the transitions: all the missing transitions (and the whole dead row) go to the dead state
+		this->m_table = std::vector<uint32_t>(this->m_states_count * this->m_columns, EXECUTABLE_DEAD_STATE);
+		this->m_accepting = std::vector<uint64_t>((this->m_states_count + 63) / 64, 0);
+		this->m_states_names = std::vector<std::string>(this->m_states_count);
+		for (uint32_t number = EXECUTABLE_INITIAL_STATE; number < this->m_states_count; number++) {
+			State* state = states[number];
+			this->m_states_names[number] = state->getName();
+			if (state->isFinal()) {
+				this->m_accepting[number / 64] |= (1ULL << (number % 64));
+			}
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (!pair.second.empty()) {
+					uint32_t child = numbers[*(pair.second.begin())];
+					this->m_table[number * this->m_columns + this->m_symbols_ids[pair.first]] = child * this->m_columns;
+				}
+			}
+		}
+		DEBUG_LOG("Compiled a DFA with %u states and %lu symbols", this->m_states_count, this->m_symbols.size());
+	}
+
+	/**
+	 * Destructor.
+	 */
+	ExecutableDFA::~ExecutableDFA() {}
+
+	/**
+	 * Returns the number of states, including the dead state.
+	 */
+	uint32_t ExecutableDFA::getStatesCount() {
+		return this->m_states_count;
+	}
+
+	/**
+	 * Returns the number of symbols of the alphabet of the DFA.
+	 */
+	uint32_t ExecutableDFA::getSymbolsCount() {
+		return this->m_symbols.size();
+	}
+
+	/**
+	 * Returns the ID of a symbol.
+	 * The labels not belonging to the alphabet of the DFA are mapped to an ID that leads to the dead state.
+	 */
+	uint32_t ExecutableDFA::getSymbolId(const std::string& label) {
+		auto iterator = this->m_symbols_ids.find(label);
+		if (iterator == this->m_symbols_ids.end()) {
+			return this->m_symbols.size();
+		}
+		return iterator->second;
+	}
+
+	/**
+	 * Returns the name of the original state corresponding to a state of the table.
+	 * The dead state has no original state, so its name is empty.
+	 */
+	std::string ExecutableDFA::getStateName(uint32_t state) {
+		DEBUG_ASSERT_TRUE(state < this->m_states_count);
+		return this->m_states_names[state];
+	}
+
+	/**
+	 * Encodes a word, i.e. a sequence of labels, as a sequence of IDs.
+	 */
+	std::vector<uint32_t> ExecutableDFA::encode(const std::vector<std::string>& word) {
+		std::vector<uint32_t> input;
+		input.reserve(word.size());
+		for (const std::string& label : word) {
+			input.push_back(this->getSymbolId(label));
+		}
+		return input;
+	}
+
+	/**
+	 * Returns the state reached from a state by reading a symbol.
+	 */
+	uint32_t ExecutableDFA::step(uint32_t state, uint32_t symbol) {
+		DEBUG_ASSERT_TRUE(state < this->m_states_count);
+		DEBUG_ASSERT_TRUE(symbol < this->m_columns);
+		return this->m_table[state * this->m_columns + symbol] / this->m_columns;
+	}
+
+	/**
+	 * Returns true if the state is final.
+	 */
+	bool ExecutableDFA::isAccepting(uint32_t state) {
+		return (this->m_accepting[state / 64] >> (state % 64)) & 1ULL;
+	}
+
+	/**
+	 * Private method.
+	 * Reads the input starting from the row at the given offset, and returns the offset of the reached row.
+	 * The symbols are not checked: they must be valid IDs, as returned by the "encode" method.
+	 */
+	uint32_t ExecutableDFA::runFromOffset(uint32_t offset, const uint32_t* input, size_t length) {
+		const uint32_t* table = this->m_table.data();
+		for (size_t i = 0; i < length; i++) {
+			offset = table[offset + input[i]];
+		}
+		return offset;
+	}
+
+	/**
+	 * Reads the input from the initial state, and returns the reached state.
+	 * The input is always read completely: the dead state is closed under all the symbols,
+	 * so the loop doesn't need to check it at every step.
+	 */
+	uint32_t ExecutableDFA::run(const uint32_t* input, size_t length) {
+		return this->runFromOffset(EXECUTABLE_INITIAL_STATE * this->m_columns, input, length) / this->m_columns;
+	}
+
+	/**
+	 * Returns true if the DFA accepts the input, encoded as a sequence of IDs.
+	 */
+	bool ExecutableDFA::accepts(const uint32_t* input, size_t length) {
+		return this->isAccepting(this->run(input, length));
+	}
+
+	/**
+	 * Returns true if the DFA accepts the word, given as a sequence of labels.
+	 */
+	bool ExecutableDFA::accepts(const std::vector<std::string>& word) {
+		std::vector<uint32_t> input = this->encode(word);
+		return this->accepts(input.data(), input.size());
+	}
+
+	/**
+	 * Matches EXECUTABLE_STREAMS inputs at the same time, writing in the "results" array whether each one is accepted.
+	 * The common prefix of the inputs is read in lockstep, with a step of every input at each iteration;
+	 * the remaining symbols of each input are read alone.
+	 */
+	void ExecutableDFA::acceptsInterleaved(const uint32_t* const* inputs, const size_t* lengths, bool* results) {
+		const uint32_t* table = this->m_table.data();
+		uint32_t offsets[EXECUTABLE_STREAMS];
+		size_t common_length = lengths[0];
+		for (unsigned int s = 0; s < EXECUTABLE_STREAMS; s++) {
+			offsets[s] = EXECUTABLE_INITIAL_STATE * this->m_columns;
+			common_length = (lengths[s] < common_length) ? lengths[s] : common_length;
+		}
+
+		for (size_t i = 0; i < common_length; i++) {
+			for (unsigned int s = 0; s < EXECUTABLE_STREAMS; s++) {
+				offsets[s] = table[offsets[s] + inputs[s][i]];
+			}
+		}
+
+		for (unsigned int s = 0; s < EXECUTABLE_STREAMS; s++) {
+			uint32_t offset = this->runFromOffset(offsets[s], inputs[s] + common_length, lengths[s] - common_length);
+			results[s] = this->isAccepting(offset / this->m_columns);
+		}
+	}
+
+} /* namespace quicksc */
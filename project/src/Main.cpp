@@ -14,18 +14,33 @@
  *
  */
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <tuple>
 
 #include "Automaton.hpp"
+#include "AlphabetGenerator.hpp"
 #include "AutomataDrawer.hpp"
+#include "BaselineStore.hpp"
+#include "BDDSubsetConstruction.hpp"
+#include "CachedDeterminizationAlgorithm.hpp"
 #include "DeterminizationAlgorithm.hpp"
+#include "DeterminizationServer.hpp"
+#include "DeterminizationWithAlphabetCompressionAlgorithm.hpp"
 #include "DeterminizationWithEpsilonRemovalAlgorithm.hpp"
+#include "DeterminizationWithMintermsAlgorithm.hpp"
+#include "DeterminizationWithReductionAlgorithm.hpp"
 #include "EmbeddedSubsetConstruction.hpp"
 #include "ProblemSolver.hpp"
 #include "Properties.hpp"
 #include "QuickSubsetConstruction.hpp"
+#include "ScalingAnalyzer.hpp"
+#include "SessionScheduler.hpp"
+#include "StreamingNFAGenerator.hpp"
 #include "SubsetConstruction.hpp"
+#include "Trace.hpp"
 
 #include "Debug.hpp"
 
@@ -35,41 +50,165 @@ using namespace quicksc;
 
 int main(int argc, char **argv) {
 
+	// Options for the baselines: "--save-baseline <name>" saves the aggregated statistics of the run,
+	// "--compare-baseline <name>" compares them with a previously saved baseline.
+	char* save_baseline_name = NULL;
+	char* compare_baseline_name = NULL;
+	BaselineStore* save_baseline = NULL;
+	BaselineStore* compare_baseline = NULL;
+	// Option "--generate <file>": generates a single NFA with the streaming generator and saves it in binary form.
+	char* generate_file_name = NULL;
+	// Option "--jobs <n>": runs the test cases in parallel, in "n" worker processes.
+	unsigned int jobs = 1;
+	// Option "--serve <socket>": runs as a server, determinizing the NFAs received on the UNIX socket with "n" worker threads (as in "--jobs").
+	// Option "--algorithm <abbr>": the algorithm used by the server for the requests that don't specify one.
+	char* serve_socket_path = NULL;
+	char* serve_algorithm = (char*) QSC_ABBR;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--save-baseline") == 0 && i + 1 < argc) {
+			save_baseline_name = argv[++i];
+		} else if (strcmp(argv[i], "--compare-baseline") == 0 && i + 1 < argc) {
+			compare_baseline_name = argv[++i];
+		} else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+			generate_file_name = argv[++i];
+		} else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			jobs = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+			serve_socket_path = argv[++i];
+		} else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+			serve_algorithm = argv[++i];
+		} else {
+			std::cerr << "Unknown option: " << argv[i] << std::endl;
+			std::cerr << "Usage: " << argv[0] << " [--save-baseline <name>] [--compare-baseline <name>] [--generate <file>] [--jobs <n>] [--serve <socket> [--algorithm <abbr>]]" << std::endl;
+			return 2;
+		}
+	}
+	if (jobs > 1 && (save_baseline_name != NULL || compare_baseline_name != NULL)) {
+		// The baselines are read and written by a single process
+		std::cerr << "The option --jobs cannot be used together with the baselines" << std::endl;
+		return 2;
+	}
+	if (save_baseline_name != NULL) {
+		save_baseline = new BaselineStore(save_baseline_name);
+		save_baseline->clear();
+	}
+	if (compare_baseline_name != NULL) {
+		compare_baseline = new BaselineStore(compare_baseline_name);
+	}
+	int exit_code = 0;
+
 	DEBUG_MARK_PHASE( "Quick Subset Construction - Main" ) {
 
 		Configurations* config;
 		DEBUG_MARK_PHASE("Configurations loading") {
 			config = new Configurations();
-			config->load(CONFIG_FILENAME);
+			try {
+				config->load(CONFIG_FILENAME);
+			} catch (const char* message) {
+				std::cerr << "Cannot load the configurations: " << message << std::endl;
+				return 2;
+			}
+		}
+
+		if (generate_file_name != NULL) {
+			// The NFA is generated with the values of the first test case of the configurations
+			if (!StreamingNFAGenerator::supportsStructure((AutomatonType) config->valueOf<int>(AutomatonStructure))) {
+				std::cerr << "Cannot generate the NFA: the streaming generator supports only the structures from 0 to 5" << std::endl;
+				return 2;
+			}
+			RandomnessManager random = RandomnessManager(config);
+			AlphabetGenerator alphabet_generator = AlphabetGenerator();
+			alphabet_generator.setCardinality(config->valueOf<unsigned int>(AlphabetCardinality));
+			StreamingNFAGenerator generator = StreamingNFAGenerator(alphabet_generator.generate(), config);
+			BinaryFileSink sink = BinaryFileSink(generate_file_name, generator.getNamePrefix());
+
+			auto start = std::chrono::high_resolution_clock::now();
+			generator.generate(sink);
+			auto end = std::chrono::high_resolution_clock::now();
+
+			std::cout << "Generated a NFA with " << generator.getSize() << " states and " << sink.getTransitionsCount() << " transitions in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, saved in \"" << generate_file_name << "\"" << std::endl;
+			return 0;
+		}
+
+		if (serve_socket_path != NULL) {
+			// The server runs until a client requests its termination
+			try {
+				// The default algorithm is checked before starting, so that a wrong abbreviation is reported immediately
+				delete DeterminizationServer::createAlgorithm(serve_algorithm, config);
+				DeterminizationServer server = DeterminizationServer(config, serve_socket_path, serve_algorithm, jobs);
+				server.start();
+				std::cout << "Serving with <" << serve_algorithm << "> and " << jobs << " worker(s) on \"" << serve_socket_path << "\"" << std::endl;
+				server.wait();
+				std::cout << "Served " << server.getRequestsCount() << " request(s)" << std::endl;
+			} catch (const char* message) {
+				std::cerr << "Cannot run the server: " << message << std::endl;
+				return 2;
+			}
+			return 0;
 		}
 
 		vector<DeterminizationAlgorithm*> algorithms;
 		DEBUG_MARK_PHASE("Algorithms loading") {
+			// The commented algorithms are not built: to enable one, uncomment it here and in the list below
+
 			// Algorithms for the epsilon removal
 			EpsilonRemovalAlgorithm* ner = new NaiveEpsilonRemovalAlgorithm();
 			EpsilonRemovalAlgorithm* ger = new GlobalEpsilonRemovalAlgorithm();
 
+			// Algorithms for the reduction
+//			ReductionAlgorithm* fbr = new BisimulationReductionAlgorithm(FORWARD_REDUCTION);
+//			ReductionAlgorithm* fsr = new SimulationReductionAlgorithm(FORWARD_REDUCTION);
+
 			// Algorithms for the determinization
 			DeterminizationAlgorithm* sc = new SubsetConstruction();
 //			DeterminizationAlgorithm* esc = new EmbeddedSubsetConstruction(config);
 			DeterminizationAlgorithm* qsc = new QuickSubsetConstruction(config);
+//			DeterminizationAlgorithm* bsc = new BDDSubsetConstruction();
 			DeterminizationAlgorithm* sc_with_ner = new DeterminizationWithEpsilonRemovalAlgorithm(ner, sc);
 			DeterminizationAlgorithm* sc_with_ger = new DeterminizationWithEpsilonRemovalAlgorithm(ger, sc);
 			DeterminizationAlgorithm* qsc_with_ner = new DeterminizationWithEpsilonRemovalAlgorithm(ner, qsc);
 			DeterminizationAlgorithm* qsc_with_ger = new DeterminizationWithEpsilonRemovalAlgorithm(ger, qsc);
+//			DeterminizationAlgorithm* sc_with_minterms = new DeterminizationWithMintermsAlgorithm(sc);
+//			DeterminizationAlgorithm* qsc_with_minterms = new DeterminizationWithMintermsAlgorithm(qsc);
+//			DeterminizationAlgorithm* sc_with_ac = new DeterminizationWithAlphabetCompressionAlgorithm(sc);
+//			DeterminizationAlgorithm* qsc_with_ac = new DeterminizationWithAlphabetCompressionAlgorithm(qsc);
+//			DeterminizationAlgorithm* sc_with_fbr = new DeterminizationWithReductionAlgorithm(fbr, sc);
+//			DeterminizationAlgorithm* qsc_with_fsr = new DeterminizationWithReductionAlgorithm(fsr, qsc);
+//			DeterminizationAlgorithm* sc_with_cache = new CachedDeterminizationAlgorithm(sc);
+//			DeterminizationAlgorithm* qsc_with_cache = new CachedDeterminizationAlgorithm(qsc);
 
 			algorithms.push_back(sc);
 //			algorithms.push_back(esc);
 			algorithms.push_back(qsc);
+//			algorithms.push_back(bsc);
 //			algorithms.push_back(sc_with_ner);
 //			algorithms.push_back(sc_with_ger);
 //			algorithms.push_back(qsc_with_ner);
 //			algorithms.push_back(qsc_with_ger);
+//			algorithms.push_back(sc_with_minterms);
+//			algorithms.push_back(qsc_with_minterms);
+//			algorithms.push_back(sc_with_ac);
+//			algorithms.push_back(qsc_with_ac);
+//			algorithms.push_back(sc_with_fbr);
+//			algorithms.push_back(qsc_with_fsr);
+//			algorithms.push_back(sc_with_cache);
+//			algorithms.push_back(qsc_with_cache);
 		}
 
-		do {
+		// Execution of the test case on which the configurations are positioned
+		auto run_test_case = [&]() -> int {
 			std::cout << std::endl << "_______________________________________________________________________|" << std::endl << std::endl << std::endl;
 
+			if (config->valueOf<bool>(ScalingMode)) {
+				// Growing the scaling parameter until the time budget is exceeded, then fitting the complexity exponents
+				ScalingAnalyzer analyzer = ScalingAnalyzer(config, algorithms);
+				analyzer.run();
+				analyzer.presentResults();
+				std::cout << std::endl;
+				return 0;
+			}
+
 			// Creating the problem solver instance
 			ProblemSolver solver = ProblemSolver(config, algorithms);
 
@@ -79,7 +218,41 @@ int main(int argc, char **argv) {
 			// Presenting the results and the statistics
 			solver.getResultCollector()->presentResults();
 			std::cout << std::endl;
-		} while (config->nextTestCase());
+
+			if (save_baseline != NULL || compare_baseline != NULL) {
+				// The test case is run again (on the same problems), since a single run is too noisy for the baselines
+				vector<vector<AggregatedStat>> runs = { solver.getResultCollector()->getAggregatedStats() };
+				for (unsigned int run = 1; run < config->valueOf<unsigned int>(BaselineRuns); run++) {
+					ProblemSolver run_solver = ProblemSolver(config, algorithms);
+					run_solver.solveSeries(config->valueOf<int>(Testcases));
+					runs.push_back(run_solver.getResultCollector()->getAggregatedStats());
+				}
+				if (save_baseline != NULL) {
+					save_baseline->save(config, runs);
+				}
+				if (compare_baseline != NULL) {
+					compare_baseline->compare(config, runs);
+				}
+				std::cout << std::endl;
+			}
+			return 0;
+		};
+
+		if (jobs > 1) {
+			// All the test cases are executed as independent jobs, in parallel
+			SessionScheduler scheduler = SessionScheduler(config, jobs);
+			exit_code = scheduler.run(run_test_case);
+		} else {
+			do {
+				// A test case that cannot be executed (e.g. whose problems cannot be generated) is reported, as done for the jobs
+				try {
+					run_test_case();
+				} catch (const char* message) {
+					std::cerr << "Test case failed: " << message << std::endl;
+					exit_code = 1;
+				}
+			} while (config->nextTestCase());
+		}
 		
 
 		/*
@@ -130,5 +303,19 @@ int main(int argc, char **argv) {
 		// */
 	}
 
-	return 0;
+	// In a tracing build, the events of the main process are exported
+	TRACE_EXPORT(SessionScheduler::getTraceFileName());
+
+	if (save_baseline != NULL) {
+		delete save_baseline;
+	}
+	if (compare_baseline != NULL) {
+		if (compare_baseline->getRegressionsCount() > 0) {
+			std::cout << "Found " << compare_baseline->getRegressionsCount() << " regression(s) with respect to the baseline" << std::endl;
+			exit_code = 1;
+		}
+		delete compare_baseline;
+	}
+
+	return exit_code;
 }
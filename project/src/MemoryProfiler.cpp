@@ -0,0 +1,181 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * MemoryProfiler.cpp
+ *
+ *
+ * This source file contains the replacement of the global allocation operators and the implementation of the MemoryProfiler class.
+ *
+ * The size of a block is obtained from the allocator itself (with "malloc_usable_size" on Linux, "_msize" on Windows),
+ * both when it's allocated and when it's freed; this way, the counters remain balanced without storing any header in the block.
+ * On other systems the freed memory is not tracked, so the peak of the heap is the total amount of allocated memory.
+ *
+ * NOTE: a block allocated by a thread and freed by another one is subtracted from the counters of the second thread.
+ */
+
+#include "MemoryProfiler.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+	#include <malloc.h>
+	#define BLOCK_SIZE( ptr )			malloc_usable_size( ptr )
+#elif defined(_WIN32)
+	#include <malloc.h>
+	#define BLOCK_SIZE( ptr )			_msize( ptr )
+#else
+	#define BLOCK_SIZE( ptr )			0
+#endif
+
+#define PROC_STATUS_FILE		"/proc/self/status"
+#define PROC_CLEAR_REFS_FILE	"/proc/self/clear_refs"
+#define PEAK_RSS_ENTRY			"VmHWM:"
+
+/** Thread-local counters, updated by the global allocation operators. */
+static thread_local unsigned long long allocations_counter = 0;
+static thread_local unsigned long long allocated_bytes_counter = 0;
+static thread_local long long current_heap_bytes = 0;
+static thread_local long long peak_heap_bytes = 0;
+
+/** Value of the heap counter at the start of the current measure. */
+static thread_local long long measure_start_heap_bytes = 0;
+static thread_local unsigned long long measure_start_allocations = 0;
+static thread_local unsigned long long measure_start_allocated_bytes = 0;
+
+/**
+ * Replacement of the global allocation operator.
+ * It updates the thread-local counters, then it delegates to "malloc".
+ */
+void* operator new(std::size_t size) {
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == NULL) {
+		throw std::bad_alloc();
+	}
+	long long block_size = BLOCK_SIZE(ptr);
+	if (block_size == 0) {
+		block_size = size;
+	}
+	allocations_counter++;
+	allocated_bytes_counter += block_size;
+	current_heap_bytes += block_size;
+	if (current_heap_bytes > peak_heap_bytes) {
+		peak_heap_bytes = current_heap_bytes;
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+/**
+ * Replacement of the global deallocation operator.
+ * It updates the thread-local counters, then it delegates to "free".
+ */
+void operator delete(void* ptr) noexcept {
+	if (ptr == NULL) {
+		return;
+	}
+	current_heap_bytes -= BLOCK_SIZE(ptr);
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	::operator delete(ptr);
+}
+
+/**
+ * Sized versions of the deallocation operator.
+ * The requested size is ignored, since the counters are updated with the size of the block given by the allocator.
+ */
+void operator delete(void* ptr, std::size_t) noexcept {
+	::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	::operator delete(ptr);
+}
+
+namespace quicksc {
+
+	/**
+	 * Starts a new measure on the current thread.
+	 * The peak of the heap is reset to the current usage, and the peak of the RSS is reset (where possible).
+	 */
+	void MemoryProfiler::start() {
+		MemoryProfiler::resetPeakRSS();
+		measure_start_heap_bytes = current_heap_bytes;
+		measure_start_allocations = allocations_counter;
+		measure_start_allocated_bytes = allocated_bytes_counter;
+		peak_heap_bytes = current_heap_bytes;
+	}
+
+	/**
+	 * Ends the current measure, returning the memory usage since the call of the "start" method.
+	 */
+	MemoryUsage MemoryProfiler::stop() {
+		MemoryUsage usage;
+		long long peak_delta = peak_heap_bytes - measure_start_heap_bytes;
+		usage.peak_heap_bytes = (peak_delta > 0) ? peak_delta : 0;
+		usage.allocations = allocations_counter - measure_start_allocations;
+		usage.allocated_bytes = allocated_bytes_counter - measure_start_allocated_bytes;
+		usage.peak_rss_kb = MemoryProfiler::readPeakRSS();
+		return usage;
+	}
+
+	/**
+	 * Returns the number of allocations performed by the current thread, since its start.
+	 */
+	unsigned long long MemoryProfiler::getAllocationsCount() {
+		return allocations_counter;
+	}
+
+	/**
+	 * Returns the amount of memory allocated by the current thread, since its start.
+	 */
+	unsigned long long MemoryProfiler::getAllocatedBytes() {
+		return allocated_bytes_counter;
+	}
+
+	/**
+	 * Returns the amount of heap memory currently in use by the current thread.
+	 */
+	long long MemoryProfiler::getCurrentHeapBytes() {
+		return current_heap_bytes;
+	}
+
+	/**
+	 * Resets the peak of the resident set size of the process to the current value.
+	 * It requires the Linux interface "/proc/self/clear_refs"; if it's not available, FALSE is returned
+	 * and the peak refers to the whole life of the process.
+	 */
+	bool MemoryProfiler::resetPeakRSS() {
+		std::ofstream clear_refs(PROC_CLEAR_REFS_FILE);
+		if (!clear_refs.is_open()) {
+			return false;
+		}
+		clear_refs << "5";
+		clear_refs.close();
+		return !clear_refs.fail();
+	}
+
+	/**
+	 * Returns the peak of the resident set size of the process, in kB, as reported in the "/proc/self/status" file.
+	 * If the file is not available, 0 is returned.
+	 */
+	unsigned long long MemoryProfiler::readPeakRSS() {
+		std::ifstream status(PROC_STATUS_FILE);
+		std::string line;
+		while (std::getline(status, line)) {
+			if (line.rfind(PEAK_RSS_ENTRY, 0) == 0) {
+				return std::stoull(line.substr(std::string(PEAK_RSS_ENTRY).length()));
+			}
+		}
+		return 0;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,322 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * NFASimulator.cpp
+ *
+ *
+ * This source file contains the implementation of the NFASimulator class.
+ */
+
+#include "NFASimulator.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+
+#include "Alphabet.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It renumbers the states reachable from the initial one, computes their epsilon-closures, and builds the tables
+	 * of the representation chosen for the size of the NFA.
+	 */
+	NFASimulator::NFASimulator(Automaton* nfa) {
+		State* initial_state = nfa->getInitialState();
+		if (initial_state == NULL) {
+			DEBUG_LOG_ERROR("Cannot simulate an NFA without an initial state");
+			throw "The NFA must have an initial state";
+		}
+
+		// Renumbering of the states in breadth-first order, and collection of the labels
+		std::map<State*, uint32_t> numbers;
+		std::vector<State*> states = { initial_state };
+		std::set<std::string> labels;
+		std::deque<State*> queue = { initial_state };
+		numbers[initial_state] = 0;
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			for (auto &pair : current->getExitingTransitionsRef()) {
+				if (pair.first != EPSILON && !pair.second.empty()) {
+					labels.insert(pair.first);
+				}
+				for (State* child : pair.second) {
+					if (numbers.count(child) == 0) {
+						numbers[child] = states.size();
+						states.push_back(child);
+						queue.push_back(child);
+					}
+				}
+			}
+		}
+
+		this->m_symbols = std::vector<std::string>(labels.begin(), labels.end());
+		for (uint32_t id = 0; id < this->m_symbols.size(); id++) {
+			this->m_symbols_ids[this->m_symbols[id]] = id;
+		}
+		this->m_states_count = states.size();
+		this->m_words = (this->m_states_count + SIMULATOR_WORD_BITS - 1) / SIMULATOR_WORD_BITS;
+		this->m_bit_parallel = (this->m_states_count <= SIMULATOR_MAX_BIT_PARALLEL);
+		const uint32_t n = this->m_states_count;
+		const uint32_t w = this->m_words;
+		// The last symbol (one past the alphabet) is used for the unknown labels, and it has no transitions
+		const uint32_t k = this->m_symbols.size() + 1;
+
+		// Epsilon-closures of the states, as bitsets
+		std::vector<uint64_t> closures = std::vector<uint64_t>(n * w, 0);
+		for (uint32_t s = 0; s < n; s++) {
+			uint64_t* closure = &closures[s * w];
+			std::deque<uint32_t> epsilon_queue = { s };
+			closure[s / SIMULATOR_WORD_BITS] |= (1ULL << (s % SIMULATOR_WORD_BITS));
+			while (!epsilon_queue.empty()) {
+				State* current = states[epsilon_queue.front()];
+				epsilon_queue.pop_front();
+				auto iterator = current->getExitingTransitionsRef().find(EPSILON);
+				if (iterator == current->getExitingTransitionsRef().end()) {
+					continue;
+				}
+				for (State* child : iterator->second) {
+					uint32_t c = numbers[child];
+					if (!(closure[c / SIMULATOR_WORD_BITS] & (1ULL << (c % SIMULATOR_WORD_BITS)))) {
+						closure[c / SIMULATOR_WORD_BITS] |= (1ULL << (c % SIMULATOR_WORD_BITS));
+						epsilon_queue.push_back(c);
+					}
+				}
+			}
+		}
+
+		// Epsilon-closed children of each state, for each symbol, as rows of bitsets
+		this->m_rows_indexes = std::vector<uint32_t>(k * n, SIMULATOR_NO_ROW);
+		std::vector<int> entering_symbol = std::vector<int>(n, -1);	// Symbol entering each state (-1 if none)
+		this->m_homogeneous = true;
+		for (uint32_t s = 0; s < n; s++) {
+			for (auto &pair : states[s]->getExitingTransitionsRef()) {
+				if (pair.first == EPSILON || pair.second.empty()) {
+					continue;
+				}
+				uint32_t symbol = this->m_symbols_ids[pair.first];
+				uint32_t row_index = this->m_rows.size() / w;
+				this->m_rows.resize(this->m_rows.size() + w, 0);
+				uint64_t* row = &this->m_rows[row_index * w];
+				for (State* child : pair.second) {
+					const uint64_t* closure = &closures[numbers[child] * w];
+					for (uint32_t i = 0; i < w; i++) {
+						row[i] |= closure[i];
+					}
+				}
+				this->m_rows_indexes[symbol * n + s] = row_index;
+				for (uint32_t i = 0; i < w; i++) {
+					for (uint64_t bits = row[i]; bits != 0; bits &= bits - 1) {
+						uint32_t t = i * SIMULATOR_WORD_BITS + __builtin_ctzll(bits);
+						if (entering_symbol[t] == -1) {
+							entering_symbol[t] = symbol;
+						} else if (entering_symbol[t] != (int) symbol) {
+							this->m_homogeneous = false;
+						}
+					}
+				}
+			}
+		}
+
+		// Initial and final sets
+		this->m_initial_set = std::vector<uint64_t>(closures.begin(), closures.begin() + w);
+		this->m_final_set = std::vector<uint64_t>(w, 0);
+		for (uint32_t s = 0; s < n; s++) {
+			if (states[s]->isFinal()) {
+				this->m_final_set[s / SIMULATOR_WORD_BITS] |= (1ULL << (s % SIMULATOR_WORD_BITS));
+			}
+		}
+
+		if (!this->m_bit_parallel) {
+			DEBUG_LOG("Generic simulator with %u states and %u words per set", n, w);
+			return;
+		}
+
+		// Bit-parallel tables: for each byte of the active set, the union of the children of its states
+		this->m_initial_word = this->m_initial_set[0];
+		this->m_final_word = this->m_final_set[0];
+		this->m_chunks = (n + 7) / 8;
+		uint32_t tables_count = this->m_homogeneous ? 1 : k;
+		this->m_byte_tables = std::vector<uint64_t>(tables_count * this->m_chunks * 256, 0);
+		for (uint32_t table = 0; table < tables_count; table++) {
+			for (uint32_t chunk = 0; chunk < this->m_chunks; chunk++) {
+				uint64_t* bytes_table = &this->m_byte_tables[(table * this->m_chunks + chunk) * 256];
+				for (uint32_t byte = 1; byte < 256; byte++) {
+					// The table of a byte is the table of the byte without its lowest bit, plus the children of that state
+					uint32_t lowest = __builtin_ctz(byte);
+					uint32_t s = chunk * 8 + lowest;
+					uint64_t children = 0;
+					if (s < n) {
+						for (uint32_t symbol = 0; symbol < k; symbol++) {
+							if (!this->m_homogeneous && symbol != table) {
+								continue;
+							}
+							uint32_t row_index = this->m_rows_indexes[symbol * n + s];
+							if (row_index != SIMULATOR_NO_ROW) {
+								children |= this->m_rows[row_index];
+							}
+						}
+					}
+					bytes_table[byte] = bytes_table[byte & (byte - 1)] | children;
+				}
+			}
+		}
+		if (this->m_homogeneous) {
+			this->m_symbols_masks = std::vector<uint64_t>(k, 0);
+			for (uint32_t t = 0; t < n; t++) {
+				if (entering_symbol[t] >= 0) {
+					this->m_symbols_masks[entering_symbol[t]] |= (1ULL << t);
+				}
+			}
+		}
+		DEBUG_LOG("Bit-parallel simulator with %u states (homogeneous: %s)", n, this->m_homogeneous ? "true" : "false");
+	}
+
+	/**
+	 * Destructor.
+	 */
+	NFASimulator::~NFASimulator() {}
+
+	/**
+	 * Returns the number of states reachable from the initial state.
+	 */
+	uint32_t NFASimulator::getStatesCount() {
+		return this->m_states_count;
+	}
+
+	/**
+	 * Returns the number of symbols of the alphabet of the NFA.
+	 */
+	uint32_t NFASimulator::getSymbolsCount() {
+		return this->m_symbols.size();
+	}
+
+	/**
+	 * Returns true if the simulator uses the bit-parallel representation.
+	 */
+	bool NFASimulator::isBitParallel() {
+		return this->m_bit_parallel;
+	}
+
+	/**
+	 * Returns true if all the transitions entering a state have the same label.
+	 */
+	bool NFASimulator::isHomogeneous() {
+		return this->m_homogeneous;
+	}
+
+	/**
+	 * Returns the ID of a symbol.
+	 * The labels not belonging to the alphabet of the NFA are mapped to an ID with no transitions.
+	 */
+	uint32_t NFASimulator::getSymbolId(const std::string& label) {
+		auto iterator = this->m_symbols_ids.find(label);
+		if (iterator == this->m_symbols_ids.end()) {
+			return this->m_symbols.size();
+		}
+		return iterator->second;
+	}
+
+	/**
+	 * Encodes a word, i.e. a sequence of labels, as a sequence of IDs.
+	 */
+	std::vector<uint32_t> NFASimulator::encode(const std::vector<std::string>& word) {
+		std::vector<uint32_t> input;
+		input.reserve(word.size());
+		for (const std::string& label : word) {
+			input.push_back(this->getSymbolId(label));
+		}
+		return input;
+	}
+
+	/**
+	 * Private method.
+	 * Simulates the NFA with the bit-parallel representation.
+	 * The simulation stops as soon as the active set becomes empty.
+	 */
+	bool NFASimulator::acceptsBitParallel(const uint32_t* input, size_t length) {
+		const uint64_t* tables = this->m_byte_tables.data();
+		const uint32_t chunks = this->m_chunks;
+		uint64_t active = this->m_initial_word;
+		for (size_t i = 0; i < length && active != 0; i++) {
+			const uint64_t* symbol_tables = this->m_homogeneous ? tables : (tables + input[i] * chunks * 256);
+			uint64_t next = 0;
+			for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+				next |= symbol_tables[chunk * 256 + ((active >> (8 * chunk)) & 0xFF)];
+			}
+			active = this->m_homogeneous ? (next & this->m_symbols_masks[input[i]]) : next;
+		}
+		return (active & this->m_final_word) != 0;
+	}
+
+	/**
+	 * Private method.
+	 * Simulates the NFA with the generic representation.
+	 * The simulation stops as soon as the active set becomes empty.
+	 */
+	bool NFASimulator::acceptsGeneric(const uint32_t* input, size_t length) {
+		const uint32_t n = this->m_states_count;
+		const uint32_t w = this->m_words;
+		std::vector<uint64_t> active = this->m_initial_set;
+		std::vector<uint64_t> next = std::vector<uint64_t>(w);
+		bool alive = true;
+		for (size_t i = 0; i < length && alive; i++) {
+			const uint32_t* rows_indexes = &this->m_rows_indexes[input[i] * n];
+			std::fill(next.begin(), next.end(), 0);
+			alive = false;
+			for (uint32_t word = 0; word < w; word++) {
+				uint64_t bits = active[word];
+				while (bits != 0) {
+					uint32_t s = word * SIMULATOR_WORD_BITS + __builtin_ctzll(bits);
+					bits &= bits - 1;
+					uint32_t row_index = rows_indexes[s];
+					if (row_index == SIMULATOR_NO_ROW) {
+						continue;
+					}
+					const uint64_t* row = &this->m_rows[row_index * w];
+					for (uint32_t j = 0; j < w; j++) {
+						next[j] |= row[j];
+					}
+					alive = true;
+				}
+			}
+			active.swap(next);
+		}
+		if (!alive) {
+			return false;
+		}
+		for (uint32_t word = 0; word < w; word++) {
+			if (active[word] & this->m_final_set[word]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Returns true if the NFA accepts the input, encoded as a sequence of IDs.
+	 * The symbols are not checked: they must be valid IDs, as returned by the "encode" method.
+	 */
+	bool NFASimulator::accepts(const uint32_t* input, size_t length) {
+		if (this->m_bit_parallel) {
+			return this->acceptsBitParallel(input, length);
+		} else {
+			return this->acceptsGeneric(input, length);
+		}
+	}
+
+	/**
+	 * Returns true if the NFA accepts the word, given as a sequence of labels.
+	 */
+	bool NFASimulator::accepts(const std::vector<std::string>& word) {
+		std::vector<uint32_t> input = this->encode(word);
+		return this->accepts(input.data(), input.size());
+	}
+
+} /* namespace quicksc */
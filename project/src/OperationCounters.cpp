@@ -0,0 +1,74 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * OperationCounters.cpp
+ *
+ *
+ * This source file contains the definition of the thread-local counters of the primitive operations
+ * and the implementation of the OperationCounters class.
+ */
+
+#include "OperationCounters.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	thread_local constinit unsigned long long operation_counters[OPERATION_END] = {};
+
+	/**
+	 * Returns the current values of the counters of the current thread.
+	 */
+	OperationCounts OperationCounters::read() {
+		OperationCounts counts;
+		for (int op = 0; op < OPERATION_END; op++) {
+			counts.values[op] = operation_counters[op];
+		}
+		return counts;
+	}
+
+	/**
+	 * Returns the number of operations performed by the current thread since the reading passed as parameter.
+	 */
+	OperationCounts OperationCounters::since(const OperationCounts& start) {
+		OperationCounts counts;
+		for (int op = 0; op < OPERATION_END; op++) {
+			counts.values[op] = operation_counters[op] - start.values[op];
+		}
+		return counts;
+	}
+
+	/**
+	 * Returns the name of the runtime statistic corresponding to an operation.
+	 */
+	RuntimeStat OperationCounters::getRuntimeStat(Operation operation) {
+		switch (operation) {
+		case OP_CONNECT_CHILD :				return OPERATIONS_CONNECT;
+		case OP_DISCONNECT_CHILD :			return OPERATIONS_DISCONNECT;
+		case OP_EPSILON_CLOSURE :			return OPERATIONS_EPSILON_CLOSURE;
+		case OP_EPSILON_VISIT :				return OPERATIONS_EPSILON_VISIT;
+		case OP_EXTENSION_INSERT :			return OPERATIONS_EXTENSION_INSERT;
+		case OP_NAME_CONSTRUCTION :			return OPERATIONS_NAME_CONSTRUCTION;
+		case OP_STATE_LOOKUP :				return OPERATIONS_STATE_LOOKUP;
+		case OP_SINGULARITY_INSERT :		return OPERATIONS_SINGULARITY_INSERT;
+		case OP_SINGULARITY_DUPLICATE :		return OPERATIONS_SINGULARITY_DUPLICATE;
+		default :
+			DEBUG_LOG_ERROR("Cannot parse the value %d as instance of the enumeration Operation", operation);
+			throw "Unknown value for the Operation enumeration";
+		}
+	}
+
+	/**
+	 * Returns the runtime statistics of all the operations, in the order of the enumeration.
+	 */
+	std::vector<RuntimeStat> OperationCounters::getRuntimeStatsList() {
+		std::vector<RuntimeStat> list;
+		for (int op = 0; op < OPERATION_END; op++) {
+			list.push_back(OperationCounters::getRuntimeStat((Operation) op));
+		}
+		return list;
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,164 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * PhaseProfiler.cpp
+ *
+ *
+ * This source file contains the implementation of the classes PhaseProfiler and ScopedPhase.
+ * Every thread has its own tree of phases, whose root is created at the first phase of the thread.
+ */
+
+#include "PhaseProfiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+#define PHASE_ROOT_NAME			"(root)"
+#define PHASE_NAME_WIDTH		32
+
+namespace quicksc {
+
+	/** Tree of the phases of the current thread, and the node of the running phase */
+	static thread_local PhaseNode* phases_root = NULL;
+	static thread_local PhaseNode* phases_current = NULL;
+
+	/**
+	 * Returns the current instant of the monotonic clock, in nanoseconds.
+	 */
+	unsigned long long PhaseProfiler::now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * Opens a phase as a child of the running one, and returns its node.
+	 * If the running phase already has a child with the same name, its node is reused.
+	 */
+	PhaseNode* PhaseProfiler::enter(const char* name) {
+		if (phases_root == NULL) {
+			phases_root = new PhaseNode { PHASE_ROOT_NAME, 0, 0, NULL, {} };
+			phases_current = phases_root;
+		}
+		for (PhaseNode* child : phases_current->children) {
+			if (child->name == name || strcmp(child->name, name) == 0) {
+				phases_current = child;
+				return child;
+			}
+		}
+		PhaseNode* child = new PhaseNode { name, 0, 0, phases_current, {} };
+		phases_current->children.push_back(child);
+		phases_current = child;
+		return child;
+	}
+
+	/**
+	 * Closes a phase, adding its elapsed time to the node.
+	 * The running phase returns to be the parent of the node.
+	 */
+	void PhaseProfiler::exit(PhaseNode* node, unsigned long long elapsed_ns) {
+		DEBUG_ASSERT_TRUE(node == phases_current);
+		node->total_ns += elapsed_ns;
+		node->calls++;
+		phases_current = node->parent;
+	}
+
+	/**
+	 * Private static method.
+	 * Deletes a node and all its descendants.
+	 */
+	void PhaseProfiler::deleteNode(PhaseNode* node) {
+		for (PhaseNode* child : node->children) {
+			PhaseProfiler::deleteNode(child);
+		}
+		delete node;
+	}
+
+	/**
+	 * Deletes the tree of the phases of the current thread.
+	 * It must be called when no phase is running, usually before the execution of an algorithm.
+	 */
+	void PhaseProfiler::reset() {
+		if (phases_root != NULL) {
+			DEBUG_ASSERT_TRUE(phases_current == phases_root);
+			PhaseProfiler::deleteNode(phases_root);
+		}
+		phases_root = NULL;
+		phases_current = NULL;
+	}
+
+	/**
+	 * Returns the root of the tree of the phases of the current thread, or NULL if no phase has been executed.
+	 * The root is not a phase itself: its children are the outermost phases.
+	 */
+	const PhaseNode* PhaseProfiler::getRoot() {
+		return phases_root;
+	}
+
+	/**
+	 * Private static method.
+	 * Appends to the output a line for the node, then the lines of its children, indented.
+	 */
+	void PhaseProfiler::printNode(const PhaseNode* node, unsigned int depth, std::string& output) {
+		char line[128];
+		std::string label = std::string(2 * depth, ' ') + node->name;
+		snprintf(line, sizeof(line), "%-*s %14.6f ms %8lu call(s)\n",
+				PHASE_NAME_WIDTH, label.c_str(), node->total_ns / NANOSECONDS_PER_MILLISECOND, node->calls);
+		output += line;
+		for (const PhaseNode* child : node->children) {
+			PhaseProfiler::printNode(child, depth + 1, output);
+		}
+	}
+
+	/**
+	 * Returns a textual representation of the tree of the phases of the current thread,
+	 * with a line for each phase, reporting the total time and the number of executions.
+	 */
+	std::string PhaseProfiler::toString() {
+		std::string output = std::string();
+		if (phases_root == NULL) {
+			return output;
+		}
+		for (const PhaseNode* child : phases_root->children) {
+			PhaseProfiler::printNode(child, 0, output);
+		}
+		return output;
+	}
+
+	/**
+	 * Constructor.
+	 * It opens the phase in the tree of the current thread and starts measuring.
+	 */
+	ScopedPhase::ScopedPhase(const char* name) {
+		this->m_node = PhaseProfiler::enter(name);
+		this->m_elapsed_ms = 0;
+		this->m_running = true;
+		this->m_start = PhaseProfiler::now();
+	}
+
+	/**
+	 * Destructor.
+	 * It closes the phase, if the "stop" method has not been called yet.
+	 */
+	ScopedPhase::~ScopedPhase() {
+		this->stop();
+	}
+
+	/**
+	 * Closes the phase and returns its duration in milliseconds.
+	 * Further calls return the same value without measuring again.
+	 */
+	double ScopedPhase::stop() {
+		if (this->m_running) {
+			unsigned long long elapsed_ns = PhaseProfiler::now() - this->m_start;
+			PhaseProfiler::exit(this->m_node, elapsed_ns);
+			this->m_elapsed_ms = elapsed_ns / NANOSECONDS_PER_MILLISECOND;
+			this->m_running = false;
+		}
+		return this->m_elapsed_ms;
+	}
+
+} /* namespace quicksc */
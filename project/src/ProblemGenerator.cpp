@@ -18,19 +18,36 @@
 
 #include "AlphabetGenerator.hpp"
 #include "Configurations.hpp"
+#include "StreamingNFAGenerator.hpp"
+#include "Trace.hpp"
 #include "Debug.hpp"
 
+#define MAX_INJECTION_ATTEMPTS 1000
+#define MAX_PERTURBED_DFA_ATTEMPTS 10
+
 namespace quicksc {
 	
 	/**
 	 * Constructor of the DeterminizationProblem structure.
-	 * It requires a NFA to be determinized.
+	 * It requires a NFA to be determinized and, optionally, an upper bound of the size of the DFA, used for validation.
 	*/
-	DeterminizationProblem::DeterminizationProblem(Automaton* nfa)
+	DeterminizationProblem::DeterminizationProblem(Automaton* nfa, unsigned long int dfa_size_bound)
 	: Problem(DETERMINIZATION_PROBLEM) {
 
 		DEBUG_ASSERT_NOT_NULL(nfa);
 		this->m_nfa = nfa;
+		this->m_dfa_size_bound = dfa_size_bound;
+	}
+
+	/**
+	 * Protected constructor, used by the subclasses to specify their own problem type.
+	 */
+	DeterminizationProblem::DeterminizationProblem(ProblemType type, Automaton* nfa, unsigned long int dfa_size_bound)
+	: Problem(type) {
+
+		DEBUG_ASSERT_NOT_NULL(nfa);
+		this->m_nfa = nfa;
+		this->m_dfa_size_bound = dfa_size_bound;
 	}
 
 	/**
@@ -48,17 +65,57 @@ namespace quicksc {
 		return this->m_nfa;
 	}
 
+	/**
+	 * Returns the upper bound of the size of the DFA, or DFA_SIZE_UNKNOWN if the generator did not provide one.
+	 */
+	unsigned long int DeterminizationProblem::getDFASizeBound() {
+		return this->m_dfa_size_bound;
+	}
+
+	/**
+	 * Constructor of the DFAPerturbationProblem structure.
+	 * It requires the perturbed DFA, the number of injected transitions and the distance of their origins from the initial state.
+	 */
+	DFAPerturbationProblem::DFAPerturbationProblem(Automaton* nfa, unsigned int perturbations, unsigned int depth)
+	: DeterminizationProblem(DFA_PERTURBATION_PROBLEM, nfa, DFA_SIZE_UNKNOWN) {
+		this->m_perturbations = perturbations;
+		this->m_depth = depth;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	DFAPerturbationProblem::~DFAPerturbationProblem() {}
+
+	/**
+	 * Returns the number of non-deterministic transitions injected in the DFA.
+	 */
+	unsigned int DFAPerturbationProblem::getPerturbations() {
+		return this->m_perturbations;
+	}
+
+	/**
+	 * Returns the distance from the initial state of the origins of the injected transitions.
+	 */
+	unsigned int DFAPerturbationProblem::getDepth() {
+		return this->m_depth;
+	}
+
 	/**
 	 * Constructor of a problem generator.
 	 * It is responsible for instantiating the delegated generators.
 	 * In addition, it sets some parameters for the randomness of the program.
+	 * The seed is not set if "init_randomness" is false, e.g. for the additional generators of a ProblemPipeline,
+	 * which continue the random sequence started by the first generator.
 	 */
-	ProblemGenerator::ProblemGenerator(Configurations* configurations) {
-		// Instantiating the random manager
-		RandomnessManager* random = new RandomnessManager(configurations);
-		random->printSeed();
-		// Once the random manager ended its job, it can be deleted
-		delete random;
+	ProblemGenerator::ProblemGenerator(Configurations* configurations, bool init_randomness) {
+		if (init_randomness) {
+			// Instantiating the random manager
+			RandomnessManager* random = new RandomnessManager(configurations);
+			random->printSeed();
+			// Once the random manager ended its job, it can be deleted
+			delete random;
+		}
 
 		// Setting the common alphabet
 		AlphabetGenerator* alphabet_generator = new AlphabetGenerator();
@@ -72,8 +129,22 @@ namespace quicksc {
 		switch (this->m_problem_type) {
 
 		case Problem::DETERMINIZATION_PROBLEM :
-			//this->m_dfa_generator = NULL;
-			this->m_nfa_generator = new NFAGenerator(this->m_alphabet, configurations);
+			if (configurations->valueOf<bool>(StreamingGeneration)) {
+				if (!StreamingNFAGenerator::supportsStructure((AutomatonType) configurations->valueOf<int>(AutomatonStructure))) {
+					DEBUG_LOG_ERROR("The streaming generator does not support the structure %d", configurations->valueOf<int>(AutomatonStructure));
+					throw "The streaming generation (\"?streaming = 1\") supports only the structures from 0 to 5";
+				}
+				this->m_nfa_generator = new StreamingNFAGenerator(this->m_alphabet, configurations);
+			} else {
+				this->m_nfa_generator = new NFAGenerator(this->m_alphabet, configurations);
+			}
+			break;
+
+		case Problem::DFA_PERTURBATION_PROBLEM :
+			this->m_dfa_generator = new DFAGenerator(this->m_alphabet, configurations);
+			this->m_perturbations = configurations->valueOf<unsigned int>(PerturbationCount);
+			this->m_perturbation_depth = configurations->valueOf<unsigned int>(PerturbationDepth);
+			this->m_epsilon_probability = configurations->valueOf<double>(EpsilonPercentage);
 			break;
 
 		default :
@@ -88,8 +159,8 @@ namespace quicksc {
 	 * Destructor.
 	 */
 	ProblemGenerator::~ProblemGenerator() {
-		DEBUG_MARK_PHASE("Deleting the nfa generator") {
-			//if (this->m_dfa_generator != NULL) delete this->m_dfa_generator;
+		DEBUG_MARK_PHASE("Deleting the generators") {
+			if (this->m_dfa_generator != NULL) delete this->m_dfa_generator;
 			if (this->m_nfa_generator != NULL) delete this->m_nfa_generator;
 		}
 	}
@@ -98,11 +169,15 @@ namespace quicksc {
 	 * Generates a new problem of the specific type requested, calling the appropriate method.
 	 */
 	Problem* ProblemGenerator::generate() {
+		TRACE_SPAN("Generation");
 		switch (this->m_problem_type) {
 
 		case Problem::DETERMINIZATION_PROBLEM :
 			return this->generateDeterminizationProblem();
 
+		case Problem::DFA_PERTURBATION_PROBLEM :
+			return this->generateDFAPerturbationProblem();
+
 		default :
 			DEBUG_LOG_ERROR("Cannot parse the value %d as instance of the enumeration ProblemType", this->m_problem_type);
 			return NULL;
@@ -116,7 +191,102 @@ namespace quicksc {
 		DEBUG_LOG("NFA Generation");
 		Automaton* automaton = this->m_nfa_generator->generateAutomaton();
 
-		return new DeterminizationProblem(automaton);
+		return new DeterminizationProblem(automaton, this->m_nfa_generator->getDFASizeBound());
+	}
+
+	/**
+	 * Private method.
+	 * Injects a single non-deterministic transition in the DFA, with origin in one of the states of the "origins" vector:
+	 * - with the epsilon probability of the configurations, an epsilon transition towards another state;
+	 * - otherwise, a transition with a label already exiting from the origin, towards a state that is not its child yet.
+	 * If the origin has no exiting transitions, an epsilon transition is injected.
+	 * Returns false if the chosen origin cannot receive a new transition.
+	 */
+	bool ProblemGenerator::injectPerturbation(Automaton* dfa, vector<State*>& origins, vector<State*>& states) {
+		State* origin = origins[rand() % origins.size()];
+		State* destination = states[rand() % states.size()];
+
+		string label = EPSILON;
+		const map<string, set<State*>>& exiting_transitions = origin->getExitingTransitionsRef();
+		bool epsilon = ((double) rand() / RAND_MAX) <= this->m_epsilon_probability;
+		if (!epsilon && !exiting_transitions.empty()) {
+			auto it = exiting_transitions.begin();
+			std::advance(it, rand() % exiting_transitions.size());
+			label = it->first;
+		}
+
+		if ((label == EPSILON && destination == origin) || origin->hasExitingTransition(label, destination)) {
+			return false;
+		}
+		return dfa->connectStates(origin, destination, label);
+	}
+
+	/**
+	 * Generates a "DFA perturbation" problem.
+	 * The DFA is generated by the DFAGenerator, with the structure of the configurations; then, exactly "#perturbations"
+	 * non-deterministic (or epsilon) transitions are injected. Their origins are the states at distance "perturbdepth"
+	 * from the initial state or, if the DFA is not so deep, the deepest states.
+	 * The distances are those of the DFA, before the injections.
+	 * If a DFA cannot receive all the perturbations (e.g. because it has too few origins), it's discarded and a new one
+	 * is generated; after MAX_PERTURBED_DFA_ATTEMPTS failures the generation fails.
+	 */
+	DFAPerturbationProblem* ProblemGenerator::generateDFAPerturbationProblem() {
+		for (unsigned int attempt = 0; attempt < MAX_PERTURBED_DFA_ATTEMPTS; attempt++) {
+			DEBUG_LOG("DFA Generation");
+			Automaton* automaton = this->m_dfa_generator->generateAutomaton();
+			if (automaton == NULL) {
+				DEBUG_LOG_ERROR("Cannot generate the DFA to be perturbed");
+				throw "Cannot generate the DFA to be perturbed";
+			}
+			automaton->recomputeAllDistances();
+
+			// Selection of the origins: the reachable states at the requested distance, or at the maximum distance
+			vector<State*> states = automaton->getStatesVector();
+			vector<State*> origins;
+			unsigned int depth = 0;
+			for (State* s : states) {
+				if (s->getDistance() == DEFAULT_VOID_DISTANCE || s->getDistance() > this->m_perturbation_depth) {
+					continue;
+				}
+				if (s->getDistance() > depth) {
+					depth = s->getDistance();
+					origins.clear();
+				}
+				if (s->getDistance() == depth) {
+					origins.push_back(s);
+				}
+			}
+			if (depth < this->m_perturbation_depth) {
+				DEBUG_LOG("The DFA has no states at distance %u, the perturbations are injected at distance %u", this->m_perturbation_depth, depth);
+			}
+
+			// Injection of the perturbations
+			unsigned int injected = 0;
+			unsigned int failures = 0;
+			while (injected < this->m_perturbations && failures < MAX_INJECTION_ATTEMPTS) {
+				if (this->injectPerturbation(automaton, origins, states)) {
+					injected++;
+					failures = 0;
+				} else {
+					failures++;
+				}
+			}
+
+			if (injected == this->m_perturbations) {
+				automaton->recomputeAllDistances();
+				return new DFAPerturbationProblem(automaton, injected, depth);
+			}
+
+			// The DFA is discarded, with its states
+			DEBUG_LOG("Only %u perturbations over %u have been injected at distance %u, a new DFA is generated", injected, this->m_perturbations, depth);
+			delete automaton;
+			for (State* s : states) {
+				delete s;
+			}
+		}
+
+		DEBUG_LOG_ERROR("Cannot inject %u perturbations in %u generated DFAs", this->m_perturbations, MAX_PERTURBED_DFA_ATTEMPTS);
+		throw "Cannot inject the requested number of perturbations in the generated DFAs";
 	}
 
 	/* Class RandomnessManager */
@@ -0,0 +1,151 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ProblemPipeline.cpp
+ *
+ *
+ * This source file contains the implementation of the class ProblemPipeline.
+ */
+
+#include "ProblemPipeline.hpp"
+
+#include "PhaseProfiler.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It creates a generator for each thread; the threads are started by the "start" method.
+	 * The generators do not reset the random seed, which is set by the generator of the ProblemSolver.
+	 */
+	ProblemPipeline::ProblemPipeline(Configurations* configurations, unsigned int threads, unsigned int depth) {
+		if (threads == 0 || depth == 0) {
+			DEBUG_LOG_ERROR("Cannot create a pipeline with %u threads and depth %u", threads, depth);
+			throw "The pipeline requires at least one thread and a queue of positive depth";
+		}
+		for (unsigned int t = 0; t < threads; t++) {
+			this->m_generators.push_back(new ProblemGenerator(configurations, false));
+		}
+		this->m_depth = depth;
+		this->m_to_produce = 0;
+		this->m_to_consume = 0;
+		this->m_stopped = false;
+		this->m_error = "";
+	}
+
+	/**
+	 * Destructor.
+	 * It stops the threads and deletes the problems that have not been extracted.
+	 */
+	ProblemPipeline::~ProblemPipeline() {
+		this->stop();
+		for (PreparedProblem& prepared : this->m_queue) {
+			delete prepared.problem;
+		}
+		this->m_queue.clear();
+		for (ProblemGenerator* generator : this->m_generators) {
+			delete generator;
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Body of a generator thread: while there are problems to produce, it generates a problem and
+	 * puts it in the queue, waiting if the queue is full.
+	 */
+	void ProblemPipeline::produce(ProblemGenerator* generator) {
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				if (this->m_stopped || this->m_to_produce == 0) {
+					return;
+				}
+				this->m_to_produce--;
+			}
+
+			Problem* problem = NULL;
+			ScopedPhase generation_phase("Generation");
+			try {
+				problem = generator->generate();
+			} catch (const char* message) {
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_error = message;
+				this->m_stopped = true;
+				this->m_not_empty.notify_all();
+				this->m_not_full.notify_all();
+				return;
+			}
+			double generation_time = generation_phase.stop();
+
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_not_full.wait(lock, [this]() { return this->m_stopped || this->m_queue.size() < this->m_depth; });
+			if (this->m_stopped) {
+				delete problem;
+				return;
+			}
+			this->m_queue.push_back({ problem, generation_time });
+			this->m_not_empty.notify_one();
+		}
+	}
+
+	/**
+	 * Starts the threads, which will generate "count" problems in total.
+	 */
+	void ProblemPipeline::start(unsigned long count) {
+		this->m_to_produce = count;
+		this->m_to_consume = count;
+		this->m_stopped = false;
+		for (ProblemGenerator* generator : this->m_generators) {
+			this->m_threads.push_back(std::thread(&ProblemPipeline::produce, this, generator));
+		}
+	}
+
+	/**
+	 * Extracts the next problem from the queue, waiting until one is available.
+	 * If a generator has thrown an exception, an exception is thrown to the caller.
+	 */
+	PreparedProblem ProblemPipeline::next() {
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		if (this->m_to_consume == 0) {
+			DEBUG_LOG_ERROR("All the problems of the pipeline have already been extracted");
+			throw "No more problems in the pipeline";
+		}
+		this->m_not_empty.wait(lock, [this]() { return this->m_stopped || !this->m_queue.empty(); });
+		if (!this->m_error.empty()) {
+			DEBUG_LOG_ERROR("A generator of the pipeline failed: %s", this->m_error.c_str());
+			throw "A generator of the pipeline failed";
+		}
+		if (this->m_queue.empty()) {
+			throw "The pipeline has been stopped";
+		}
+		PreparedProblem prepared = this->m_queue.front();
+		this->m_queue.pop_front();
+		this->m_to_consume--;
+		this->m_not_full.notify_one();
+		return prepared;
+	}
+
+	/**
+	 * Stops the threads and waits for their termination.
+	 * The problems that are being generated are discarded.
+	 */
+	void ProblemPipeline::stop() {
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_stopped = true;
+			this->m_not_full.notify_all();
+			this->m_not_empty.notify_all();
+		}
+		for (std::thread& thread : this->m_threads) {
+			if (thread.joinable()) {
+				thread.join();
+			}
+		}
+		this->m_threads.clear();
+	}
+
+} /* namespace quicksc */
@@ -14,8 +14,14 @@
 
 #include <cstdio>
 #include <list>
+#include <sys/wait.h>
+#include <unistd.h>
 
-#include "Timer.hpp"
+#include "AutomataSerializer.hpp"
+#include "MemoryProfiler.hpp"
+#include "PhaseProfiler.hpp"
+#include "ProblemPipeline.hpp"
+#include "Trace.hpp"
 #include "Debug.hpp"
 #include "Properties.hpp"
 
@@ -23,12 +29,6 @@ using namespace std;
 
 namespace quicksc {
 
-	/**
-	 * Macro function that concatenates two tokens.
-	 */
-	#define CONCAT( x, y ) _CONCAT( x, y )
-	#define _CONCAT( x, y ) x ## y
-
 	/**
 	 * Constructor.
 	 * It requires the program configurations, the list of algorithms to be used to solve the problems.
@@ -37,12 +37,28 @@ namespace quicksc {
 	ProblemSolver::ProblemSolver(Configurations* configurations, const vector<DeterminizationAlgorithm*>& algorithms)
 			: algorithms(algorithms) {
 
+		// A fork while a generator thread holds a lock (e.g. of the allocator or of the tracer) would copy it locked
+		if (configurations->valueOf<bool>(IsolationMode) && configurations->valueOf<unsigned int>(GenerationThreads) > 0) {
+			DEBUG_LOG_ERROR("Cannot run the algorithms in isolation with %u generation threads", configurations->valueOf<unsigned int>(GenerationThreads));
+			throw "The isolation mode (\"?isolation = 1\") requires the sequential generation (\"#genthreads = 0\")";
+		}
+
 		// Creating the generator and the results collector
+		// The generator sets the random seed, so it's created before any generator of the pipeline
+		this->configurations = configurations;
 		this->generator = new ProblemGenerator(configurations);
 		this->collector = new ResultCollector(configurations, this->algorithms);
 
 		// By default, the first algorithm is used for comparisons (the first algorithm is the "Benchmark" algorithm)
 		this->benchmark_algorithm_pointer = this->algorithms.front();
+
+		this->isolation_mode = configurations->valueOf<bool>(IsolationMode);
+		this->isolation_ship_solution = configurations->valueOf<bool>(IsolationShipSolution);
+
+		this->generation_threads = configurations->valueOf<unsigned int>(GenerationThreads);
+		this->generation_depth = configurations->valueOf<unsigned int>(GenerationQueueDepth);
+		this->current_generation_time = 0;
+		this->current_generation_wait = 0;
 	}
 
 	/**
@@ -64,30 +80,198 @@ namespace quicksc {
 		return this->collector;
 	}
 
+	/**
+	 * Private method.
+	 * Runs an algorithm on a problem in the current process, saving the solution and the measures in the result.
+	 */
+	void ProblemSolver::runInProcess(DeterminizationAlgorithm* algo, DeterminizationProblem* problem, Result* result) {
+		algo->resetRuntimeStatsValues();
+		PhaseProfiler::reset();
+
+		DEBUG_MARK_PHASE("Esecuzione dell'algoritmo") {
+			// Construction phase
+			MemoryProfiler::start();
+			ScopedPhase run_phase(algo->abbr().c_str());
+			result->solutions[algo] = algo->run(problem->getNFA()); // Algorithm execution
+			// Statistics
+			result->times[algo] = run_phase.stop();
+			result->memory[algo] = MemoryProfiler::stop();
+		}
+		result->phases[algo] = PhaseProfiler::toString();
+		result->runtime_stats[algo] = algo->getRuntimeStatsValues();
+		result->solution_sizes[algo] = result->solutions[algo]->size();
+		result->solution_transitions[algo] = result->solutions[algo]->getTransitionsCount();
+	}
+
+	/**
+	 * Private method.
+	 * Runs an algorithm on a problem in a forked child process.
+	 * The child writes on a pipe the time, the memory usage, the runtime statistics and the size of the solution;
+	 * if required by the configurations, it writes also the solution in binary form. Otherwise, the solution saved in
+	 * the result is NULL.
+	 */
+	void ProblemSolver::runIsolated(DeterminizationAlgorithm* algo, DeterminizationProblem* problem, Result* result) {
+		int pipe_fds[2];
+		if (pipe(pipe_fds) != 0) {
+			DEBUG_LOG_ERROR("Cannot create the pipe for the isolated run of %s", algo->name().c_str());
+			throw "Cannot create the pipe for an isolated run";
+		}
+		// The buffers are flushed, otherwise their content would be printed by both the processes
+		std::cout.flush();
+		fflush(stdout);
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			DEBUG_LOG_ERROR("Cannot fork the process for the isolated run of %s", algo->name().c_str());
+			close(pipe_fds[0]);
+			close(pipe_fds[1]);
+			throw "Cannot fork the process for an isolated run";
+		}
+
+		if (pid == 0) {
+			// Child process
+			// The child never returns from this branch, not even for an exception of the algorithm
+			try {
+				close(pipe_fds[0]);
+				// The events inherited from the parent are discarded; the ones of the run are sent back with the measures
+				TRACE_RESET();
+				algo->resetRuntimeStatsValues();
+				PhaseProfiler::reset();
+				MemoryProfiler::start();
+				ScopedPhase run_phase(algo->abbr().c_str());
+				Automaton* solution = algo->run(problem->getNFA());
+				double time = run_phase.stop();
+				MemoryUsage usage = MemoryProfiler::stop();
+
+				BinaryWriter writer = BinaryWriter();
+				writer.writeDouble(time);
+				writer.writeUInt64(usage.peak_heap_bytes);
+				writer.writeUInt64(usage.allocations);
+				writer.writeUInt64(usage.allocated_bytes);
+				writer.writeUInt64(usage.peak_rss_kb);
+				map<RuntimeStat, double> runtime_stats = algo->getRuntimeStatsValues();
+				writer.writeUInt32(runtime_stats.size());
+				for (auto &pair : runtime_stats) {
+					writer.writeString(pair.first);
+					writer.writeDouble(pair.second);
+				}
+				writer.writeString(PhaseProfiler::toString());
+				writer.writeUInt32(solution->size());
+				writer.writeUInt32(solution->getTransitionsCount());
+				writer.writeUInt32(this->isolation_ship_solution ? 1 : 0);
+				if (this->isolation_ship_solution) {
+					writer.writeBytes(AutomataSerializer::toBinary(solution));
+				}
+				vector<TraceEvent> events = Tracer::getEvents();
+				writer.writeUInt32(events.size());
+				for (TraceEvent& event : events) {
+					writer.writeString(event.name);
+					writer.writeUInt32(event.phase);
+					writer.writeUInt64(event.timestamp);
+					writer.writeUInt64(event.duration);
+					writer.writeDouble(event.value);
+				}
+
+				const string& message = writer.getBuffer();
+				size_t written = 0;
+				while (written < message.length()) {
+					ssize_t count = write(pipe_fds[1], message.data() + written, message.length() - written);
+					if (count <= 0) {
+						_exit(1);
+					}
+					written += count;
+				}
+				close(pipe_fds[1]);
+				// The child terminates without calling the destructors and without flushing the buffers inherited from the parent
+				_exit(0);
+			} catch (...) {
+				_exit(1);
+			}
+		}
+
+		// Parent process: the whole message is read before waiting, so that the child is never blocked on a full pipe
+		close(pipe_fds[1]);
+		string message = string();
+		char buffer[4096];
+		ssize_t count;
+		while ((count = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+			message.append(buffer, count);
+		}
+		close(pipe_fds[0]);
+
+		int status;
+		waitpid(pid, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			DEBUG_LOG_ERROR("The isolated run of %s terminated abnormally (status = %d)", algo->name().c_str(), status);
+			throw "The isolated run of an algorithm terminated abnormally";
+		}
+
+		BinaryReader reader = BinaryReader(message);
+		result->times[algo] = reader.readDouble();
+		MemoryUsage usage;
+		usage.peak_heap_bytes = reader.readUInt64();
+		usage.allocations = reader.readUInt64();
+		usage.allocated_bytes = reader.readUInt64();
+		usage.peak_rss_kb = reader.readUInt64();
+		result->memory[algo] = usage;
+		uint32_t stats_count = reader.readUInt32();
+		for (uint32_t i = 0; i < stats_count; i++) {
+			RuntimeStat stat = reader.readString();
+			result->runtime_stats[algo][stat] = reader.readDouble();
+		}
+		result->phases[algo] = reader.readString();
+		result->solution_sizes[algo] = reader.readUInt32();
+		result->solution_transitions[algo] = reader.readUInt32();
+		if (reader.readUInt32() != 0) {
+			result->solutions[algo] = AutomataSerializer::fromBinary(reader.readString());
+		} else {
+			result->solutions[algo] = NULL;
+		}
+
+		// The events of the child are merged with the ones of this process
+		uint32_t events_count = reader.readUInt32();
+		vector<string> event_names;
+		vector<TraceEvent> events;
+		for (uint32_t i = 0; i < events_count; i++) {
+			event_names.push_back(reader.readString());
+			TraceEvent event;
+			event.phase = (char) reader.readUInt32();
+			event.timestamp = reader.readUInt64();
+			event.duration = reader.readUInt64();
+			event.value = reader.readDouble();
+			events.push_back(event);
+		}
+		for (uint32_t i = 0; i < events_count; i++) {
+			events[i].name = event_names[i].c_str();
+		}
+		Tracer::importEvents(events);
+	}
+
 	/**
 	 * Solves a single determinization problem with all the algorithms.
 	 * For now, the algorithms are:
 	 * - Subset Construction, i.e. the "Benchmark" algorithm
 	 * - Quick Subset Construction
+	 * In isolation mode, each algorithm is executed in a separate child process.
 	 */
 	void ProblemSolver::solve(DeterminizationProblem* problem) {
+		TRACE_SPAN("Solving");
 		DEBUG_ASSERT_NOT_NULL(problem);
 		Result* result = new Result();
 		result->original_problem = problem;
 		result->benchmark_algorithm = this->benchmark_algorithm_pointer;
+		// The generation measures refer to the last generated problem, and they're consumed by this result
+		result->generation_time = this->current_generation_time;
+		result->generation_wait = this->current_generation_wait;
+		this->current_generation_time = 0;
+		this->current_generation_wait = 0;
 
 		for (DeterminizationAlgorithm* algo : this->algorithms) {
-			algo->resetRuntimeStatsValues();
-
-			DEBUG_MARK_PHASE("Esecuzione dell'algoritmo") {
-				// Construction phase
-				MEASURE_NANOSECONDS( time ) {
-					result->solutions[algo] = algo->run(problem->getNFA()); // Algorithm execution
-				}
-				// Statistics
-				result->times[algo] = time;
+			if (this->isolation_mode) {
+				this->runIsolated(algo, problem, result);
+			} else {
+				this->runInProcess(algo, problem, result);
 			}
-			result->runtime_stats[algo] = algo->getRuntimeStatsValues();
 		}
 
 		this->collector->addResult(result);
@@ -97,14 +281,15 @@ namespace quicksc {
 	 * Solves a single instance of a generic problem, depending on the type of the problem.
 	 * In practice, it delegates the solving to the specific methods for the problem type.
 	 *
-	 * NOTE: at the moment, only one type of problems is supported: determinization problems.
+	 * NOTE: at the moment, only determinization problems are supported (the DFA perturbation problems are a kind of them).
 	 * The previous translation problems, which were applied to the ESC algorithm, have been removed.
 	 */
 	void ProblemSolver::solve(Problem* problem) {
 		DEBUG_ASSERT_NOT_NULL(problem);
 		switch (problem->getType()) {
 
-		case Problem::DETERMINIZATION_PROBLEM :							// Currently, only determinization problems are supported
+		case Problem::DETERMINIZATION_PROBLEM :
+		case Problem::DFA_PERTURBATION_PROBLEM :						// A perturbation problem is solved as a determinization problem
 			return this->solve((DeterminizationProblem*) problem);
 
 		default :
@@ -115,10 +300,14 @@ namespace quicksc {
 
 	/**
 	 * Solves a single problem generated randomly by the generator passed as argument to the constructor.
+	 * The generation happens in the current thread, so the time spent waiting for the problem is zero.
 	 */
 	void ProblemSolver::solve() {
+		ScopedPhase generation_phase("Generation");
 		Problem* problem = this->generator->generate();
 		DEBUG_ASSERT_NOT_NULL(problem);
+		this->current_generation_time = generation_phase.stop();
+		this->current_generation_wait = 0;
 		this->solve(problem);
 	}
 
@@ -141,15 +330,36 @@ namespace quicksc {
 
 	/**
 	 * Solves a number of problems generated randomly by the generator passed as argument to the constructor.
+	 * If the background generation is enabled, the problems are generated by the threads of a pipeline,
+	 * overlapped with the solving of the previous ones.
 	 */
 	void ProblemSolver::solveSeries(unsigned int number) {
 		DEBUG_MARK_PHASE("Risoluzione di una serie di problemi") {
 		std::cout << "Solving " << std::to_string(number) << " problems...\n";
 		printProgressBar(0);
-		for (int i = 0; i < number; i++) {
-			this->solve();
-			printProgressBar(float(i+1) / number);
-			DEBUG_LOG_SUCCESS("Risolto il problema (%d)!", (i+1));
+		if (this->generation_threads == 0) {
+			for (unsigned int i = 0; i < number; i++) {
+				this->solve();
+				printProgressBar(float(i+1) / number);
+				DEBUG_LOG_SUCCESS("Risolto il problema (%u)!", (i+1));
+			}
+		} else {
+			ProblemPipeline pipeline = ProblemPipeline(this->configurations, this->generation_threads, this->generation_depth);
+			pipeline.start(number);
+			for (unsigned int i = 0; i < number; i++) {
+				ScopedPhase wait_phase("Generation wait");
+				PreparedProblem prepared;
+				{
+					TRACE_SPAN("Generation wait");
+					prepared = pipeline.next();
+				}
+				DEBUG_ASSERT_NOT_NULL(prepared.problem);
+				this->current_generation_time = prepared.generation_time;
+				this->current_generation_wait = wait_phase.stop();
+				this->solve(prepared.problem);
+				printProgressBar(float(i+1) / number);
+				DEBUG_LOG_SUCCESS("Risolto il problema (%d)!", (i+1));
+			}
 		}
 		std::cout << std::endl;
 		}
@@ -0,0 +1,310 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ProductAutomaton.cpp
+ *
+ *
+ * This source file contains the implementation of the ProductAutomaton class.
+ */
+
+#include "ProductAutomaton.hpp"
+
+#include <deque>
+
+#include "Alphabet.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * It doesn't build any state: the initial state is created at the first request.
+	 */
+	ProductAutomaton::ProductAutomaton(Automaton* left, Automaton* right, ProductOperation operation) {
+		if (left == NULL || right == NULL || left->getInitialState() == NULL || right->getInitialState() == NULL) {
+			DEBUG_LOG_ERROR("Cannot build the product of automata without an initial state");
+			throw "The operands of a product must have an initial state";
+		}
+		this->m_left = left;
+		this->m_right = right;
+		this->m_operation = operation;
+		this->m_product = new Automaton();
+	}
+
+	/**
+	 * Destructor.
+	 * It deletes the states of the product built so far. The operands are not deleted.
+	 */
+	ProductAutomaton::~ProductAutomaton() {
+		vector<State*> states = this->m_product->getStatesVector();
+		delete this->m_product;
+		for (State* state : states) {
+			delete state;
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Returns the state of the product corresponding to a pair of states of the operands, creating it if it doesn't exist.
+	 * The state is final if both the components are final (intersection) or if at least one of them is final (union).
+	 */
+	State* ProductAutomaton::getPairState(State* left, State* right) {
+		std::pair<State*, State*> components = std::pair<State*, State*>(left, right);
+		auto iterator = this->m_pairs.find(components);
+		if (iterator != this->m_pairs.end()) {
+			return iterator->second;
+		}
+
+		bool left_final = (left != NULL && left->isFinal());
+		bool right_final = (right != NULL && right->isFinal());
+		bool final = (this->m_operation == PRODUCT_INTERSECTION) ? (left_final && right_final) : (left_final || right_final);
+		string name = "(" + ProductAutomaton::getComponentName(left) + "," + ProductAutomaton::getComponentName(right) + ")";
+
+		State* state = new State(name, final);
+		this->m_product->addState(state);
+		this->m_pairs[components] = state;
+		this->m_components[state] = components;
+		return state;
+	}
+
+	/**
+	 * Private static method.
+	 * Returns the name of a component in the name of a pair: the name of the state, escaped so that it cannot be confused
+	 * with the separators of the pair or with the dead component (NULL), whose name is returned unescaped.
+	 */
+	string ProductAutomaton::getComponentName(State* component) {
+		if (component == NULL) {
+			return PRODUCT_DEAD_COMPONENT_NAME;
+		}
+		string name = component->getName();
+		if (name == PRODUCT_DEAD_COMPONENT_NAME) {
+			return "\\" + name;
+		}
+		string escaped;
+		for (char c : name) {
+			if (c == '\\' || c == '(' || c == ')' || c == ',') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	/**
+	 * Returns the initial state of the product, i.e. the pair of the initial states of the operands.
+	 */
+	State* ProductAutomaton::getInitialState() {
+		State* initial = this->getPairState(this->m_left->getInitialState(), this->m_right->getInitialState());
+		if (this->m_product->getInitialState() == NULL) {
+			this->m_product->setInitialState(initial);
+		}
+		return initial;
+	}
+
+	/**
+	 * Creates the exiting transitions of a state of the product, and the states they reach.
+	 * A state is expanded only once; further calls have no effect.
+	 */
+	void ProductAutomaton::expand(State* product_state) {
+		if (!this->m_expanded.insert(product_state).second) {
+			return;
+		}
+		DEBUG_ASSERT_TRUE(this->m_components.count(product_state) > 0);
+		State* left = this->m_components[product_state].first;
+		State* right = this->m_components[product_state].second;
+		const set<State*> no_children = set<State*>();
+
+		// Transitions of the operands, grouped by label
+		map<string, const set<State*>*> left_transitions, right_transitions;
+		set<string> labels;
+		if (left != NULL) {
+			for (auto &pair : left->getExitingTransitionsRef()) {
+				if (!pair.second.empty()) {
+					left_transitions[pair.first] = &pair.second;
+					labels.insert(pair.first);
+				}
+			}
+		}
+		if (right != NULL) {
+			for (auto &pair : right->getExitingTransitionsRef()) {
+				if (!pair.second.empty()) {
+					right_transitions[pair.first] = &pair.second;
+					labels.insert(pair.first);
+				}
+			}
+		}
+
+		for (string label : labels) {
+			const set<State*>& left_children = left_transitions.count(label) ? *left_transitions[label] : no_children;
+			const set<State*>& right_children = right_transitions.count(label) ? *right_transitions[label] : no_children;
+
+			if (label == EPSILON) {
+				// Asynchronous moves: each operand moves alone
+				for (State* left_child : left_children) {
+					product_state->connectChild(EPSILON, this->getPairState(left_child, right));
+				}
+				for (State* right_child : right_children) {
+					product_state->connectChild(EPSILON, this->getPairState(left, right_child));
+				}
+				continue;
+			}
+
+			if (this->m_operation == PRODUCT_INTERSECTION) {
+				// Synchronous moves, only if both the operands can move
+				for (State* left_child : left_children) {
+					for (State* right_child : right_children) {
+						product_state->connectChild(label, this->getPairState(left_child, right_child));
+					}
+				}
+			} else {
+				// Synchronous moves, where an operand that cannot move goes to the dead component
+				vector<State*> left_targets = left_children.empty() ? vector<State*>{ NULL } : vector<State*>(left_children.begin(), left_children.end());
+				vector<State*> right_targets = right_children.empty() ? vector<State*>{ NULL } : vector<State*>(right_children.begin(), right_children.end());
+				for (State* left_child : left_targets) {
+					for (State* right_child : right_targets) {
+						if (left_child != NULL || right_child != NULL) {
+							product_state->connectChild(label, this->getPairState(left_child, right_child));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Returns the number of states of the product built so far.
+	 */
+	unsigned int ProductAutomaton::getBuiltStatesCount() {
+		return this->m_product->size();
+	}
+
+	/**
+	 * Computes the epsilon closure of a set of states of the product, expanding the states it reaches.
+	 */
+	Extension ProductAutomaton::computeEpsilonClosure(const Extension& extension) {
+		Extension result = Extension(extension);
+		std::deque<State*> queue = std::deque<State*>(extension.begin(), extension.end());
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			this->expand(current);
+			auto iterator = current->getExitingTransitionsRef().find(EPSILON);
+			if (iterator == current->getExitingTransitionsRef().end()) {
+				continue;
+			}
+			for (State* epsilon_child : iterator->second) {
+				if (result.insert(epsilon_child).second) {
+					queue.push_back(epsilon_child);
+				}
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Computes the l-closure of a set of states of the product, i.e. the epsilon closure of the states reached
+	 * with the label, expanding the states it reaches.
+	 */
+	Extension ProductAutomaton::computeLClosure(const Extension& extension, string label) {
+		Extension l_children;
+		for (State* state : extension) {
+			this->expand(state);
+			auto iterator = state->getExitingTransitionsRef().find(label);
+			if (iterator != state->getExitingTransitionsRef().end()) {
+				l_children.insert(iterator->second.begin(), iterator->second.end());
+			}
+		}
+		return this->computeEpsilonClosure(l_children);
+	}
+
+	/**
+	 * Checks whether the language of the product is empty, i.e. whether no final pair is reachable.
+	 * The visit is breadth-first on the number of symbols read (the epsilon-transitions have no length), and it stops
+	 * at the first final pair, so only the states closer than it are built.
+	 * If the language is not empty and a vector is passed as parameter, it's filled with the labels of an accepted word
+	 * of minimum length (the epsilon-transitions are omitted).
+	 */
+	bool ProductAutomaton::isEmpty(vector<string>* witness) {
+		State* initial = this->getInitialState();
+		map<State*, std::pair<State*, string>> parents;		// Parent of each reached state, with the label of the transition
+		map<State*, unsigned long> lengths;					// Length of the shortest word reaching each state, found so far
+		set<State*> visited;
+		std::deque<State*> queue;
+		parents[initial] = std::pair<State*, string>(NULL, EPSILON);
+		lengths[initial] = 0;
+		queue.push_back(initial);
+
+		// The states reached with an epsilon-transition are visited before the others, since the word doesn't grow
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			if (!visited.insert(current).second) {
+				continue;
+			}
+
+			if (current->isFinal()) {
+				if (witness != NULL) {
+					witness->clear();
+					for (State* s = current; parents[s].first != NULL; s = parents[s].first) {
+						if (parents[s].second != EPSILON) {
+							witness->insert(witness->begin(), parents[s].second);
+						}
+					}
+				}
+				return false;
+			}
+
+			this->expand(current);
+			for (auto &pair : current->getExitingTransitionsRef()) {
+				bool is_epsilon = (pair.first == EPSILON);
+				unsigned long length = lengths[current] + (is_epsilon ? 0 : 1);
+				for (State* child : pair.second) {
+					auto iterator = lengths.find(child);
+					if (iterator == lengths.end() || length < iterator->second) {
+						lengths[child] = length;
+						parents[child] = std::pair<State*, string>(current, pair.first);
+						if (is_epsilon) {
+							queue.push_front(child);
+						} else {
+							queue.push_back(child);
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Builds the whole reachable part of the product and returns it as a new automaton.
+	 * The returned automaton is a copy, owned by the caller; the product remains usable.
+	 */
+	Automaton* ProductAutomaton::materialize() {
+		std::deque<State*> queue;
+		set<State*> visited;
+		State* initial = this->getInitialState();
+		queue.push_back(initial);
+		visited.insert(initial);
+		while (!queue.empty()) {
+			State* current = queue.front();
+			queue.pop_front();
+			this->expand(current);
+			for (auto &pair : current->getExitingTransitionsRef()) {
+				for (State* child : pair.second) {
+					if (visited.insert(child).second) {
+						queue.push_back(child);
+					}
+				}
+			}
+		}
+
+		// The states built by previous queries are all reachable, since they're built only when reached
+		Automaton* result = this->m_product->clone();
+		result->recomputeAllDistances();
+		return result;
+	}
+
+} /* namespace quicksc */
@@ -15,7 +15,8 @@
 
 #include "AutomataDrawer.hpp"
 #include "Properties.hpp"
-#include "Timer.hpp"
+#include "PhaseProfiler.hpp"
+#include "Trace.hpp"
 
 //#define DEBUG_MODE
 #include "Debug.hpp"
@@ -30,6 +31,8 @@ namespace quicksc {
 	QuickSubsetConstruction::QuickSubsetConstruction(Configurations* configurations)
 	: DeterminizationAlgorithm(QSC_ABBR, QSC_NAME) {
 		this->m_singularities = NULL;
+		this->m_versioned_automaton = NULL;
+		this->m_publication_period = 1;
 	}
 
 	/**
@@ -87,10 +90,21 @@ namespace quicksc {
 		return list;
     }
 
+	/**
+	 * Sets the VersionedAutomaton where the DFA is published while it's restructured, so that other threads can query it.
+	 * The DFA is attached after the cloning, published every "publication_period" singularities, and detached at the end.
+	 * A NULL value disables the publication.
+	 */
+	void QuickSubsetConstruction::setVersionedAutomaton(VersionedAutomaton* versioned_automaton, unsigned long publication_period) {
+		this->m_versioned_automaton = versioned_automaton;
+		this->m_publication_period = (publication_period > 0) ? publication_period : 1;
+	}
+
 	/**
 	 * Executes the algorithm on the given inputs.
 	 */
 	Automaton* QuickSubsetConstruction::run(Automaton* nfa) {
+		TRACE_SPAN("QSC");
 		this->cleanInternalStatus();
 
 		// Input acquisition
@@ -119,7 +133,9 @@ namespace quicksc {
 
 		 **************************/
 
-		MEASURE_MILLISECONDS( cloning_time ) {
+		ScopedPhase cloning_phase("Cloning");
+		{
+			TRACE_SPAN("QSC cloning");
 
 			// Iterating on all the states of the input automaton to create the corresponding states
 			for (State* nfa_state : nfa->getStatesVector()) {
@@ -212,11 +228,12 @@ namespace quicksc {
 			dfa->setInitialState(states_map[nfa->getInitialState()]);
 
 		} // End measuring cloning time
-		this->getRuntimeStatsValuesRef()[CLONING_TIME] = cloning_time;
+		this->getRuntimeStatsValuesRef()[CLONING_TIME] = cloning_phase.stop();
 
 		// Saving the number of singularities at the beginning of the algorithm, and their average level
 		this->getRuntimeStatsValuesRef()[NUMBER_SINGULARITIES_CHECKUP] = this->m_singularities->size();
 		this->getRuntimeStatsValuesRef()[LEVEL_SINGULARITIES_CHECKUP] = this->m_singularities->getAverageLevel();
+		TRACE_COUNTER("QSC singularities", this->m_singularities->size());
 
 
 		/**************************
@@ -226,8 +243,14 @@ namespace quicksc {
 		 **************************/
 
 		double singularities_level_sum = 0;	// Auxiliary variable used to compute the average level of the singularities
+		unsigned long processed_singularities = 0;
+
+		// From now on, the modifications of the DFA are observed and published (until the end of the method, even for an exception)
+		ScopedAttachment attachment = ScopedAttachment(this->m_versioned_automaton, dfa);
 
-		MEASURE_MILLISECONDS(restructuring_time) {
+		ScopedPhase restructuring_phase("Restructuring");
+		{
+			TRACE_SPAN("QSC restructuring");
 
 			/***** SCENARIO S_0 (ZERO) *****/
 
@@ -355,6 +378,11 @@ namespace quicksc {
 			// Until there are singularities to process
 			while (!this->m_singularities->empty()) {
 
+				// Publishing the DFA obtained after the previous singularities; between two singularities, its structure is consistent
+				if (this->m_versioned_automaton != NULL && processed_singularities++ % this->m_publication_period == 0) {
+					this->m_versioned_automaton->publish();
+				}
+
 				DEBUG_MARK_PHASE( "Nuova iterazione per una nuova singolarità" ) {
 
 				DEBUG_LOG("Printing the current situation of the automaton");
@@ -624,7 +652,10 @@ namespace quicksc {
 			} // End Singularity cycle
 
 		} // End measuring restructuring time
-		this->getRuntimeStatsValuesRef()[RESTRUCTURING_TIME] = restructuring_time;
+		this->getRuntimeStatsValuesRef()[RESTRUCTURING_TIME] = restructuring_phase.stop();
+
+		// The final DFA is published as the last version
+		attachment.detach();
 
 		this->getRuntimeStatsValuesRef()[NUMBER_SINGULARITIES_TOTAL] =
 				this->getRuntimeStatsValuesRef()[NUMBER_SINGULARITIES_SCENARIO_0] +
@@ -646,6 +677,8 @@ namespace quicksc {
 				1.0 - exp_impact :
 				1.0 / exp_impact - 1.0;
 
+		this->collectOperationCounts();
+
 		// Returns the DFA
 		return dfa;
 	}
@@ -658,7 +691,9 @@ namespace quicksc {
 	 * in a "width-first" way.
 	 */
 	void QuickSubsetConstruction::runDistanceRelocation(list<pair<State*, int>> relocation_sequence) {
-		MEASURE_MILLISECONDS( dist_reloc_time ) {
+		ScopedPhase dist_reloc_phase("Distance relocation");
+		{
+			TRACE_SPAN("QSC distance relocation");
 			while (!relocation_sequence.empty()) {
 				auto current = relocation_sequence.front();
 				relocation_sequence.pop_front();
@@ -679,7 +714,7 @@ namespace quicksc {
 				}
 			}
 		}
-		this->getRuntimeStatsValuesRef()[DISTANCE_RELOCATION_TIME] += dist_reloc_time;
+		this->getRuntimeStatsValuesRef()[DISTANCE_RELOCATION_TIME] += dist_reloc_phase.stop();
 	}
 
 	/**
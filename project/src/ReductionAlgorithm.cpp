@@ -0,0 +1,295 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ReductionAlgorithm.cpp
+ *
+ *
+ * This source file contains the implementation of the class ReductionAlgorithm and of its subclasses:
+ *
+ *  - BisimulationReductionAlgorithm: the quotient by the coarsest bisimulation, computed by partition refinement.
+ *  - SimulationReductionAlgorithm: the quotient by the simulation equivalence, computed by refinement of the largest simulation.
+ */
+
+#include "ReductionAlgorithm.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "Alphabet.hpp"
+#include "Properties.hpp"
+#include "State.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	/**
+	 * Base constructor.
+	 * It instantiates the name and abbreviation of the algorithm, and the direction of the computed relation.
+	 */
+	ReductionAlgorithm::ReductionAlgorithm(string abbr, string name, ReductionDirection direction) {
+		this->m_abbr = abbr;
+		this->m_name = name;
+		this->m_direction = direction;
+	}
+
+	/**
+	 * Empty destructor.
+	 */
+	ReductionAlgorithm::~ReductionAlgorithm() {}
+
+	/**
+	 * Returns the abbreviation of the algorithm.
+	 */
+	const string& ReductionAlgorithm::abbr() {
+		return this->m_abbr;
+	}
+
+	/**
+	 * Returns the name of the algorithm.
+	 */
+	const string& ReductionAlgorithm::name() {
+		return this->m_name;
+	}
+
+	/**
+	 * Numbers the states and the labels of the NFA, and builds the adjacency lists used by the algorithms,
+	 * oriented according to the direction: the "post" lists follow the exiting transitions in the forward direction,
+	 * and the incoming transitions in the backward one.
+	 */
+	void ReductionAlgorithm::indexAutomaton(Automaton* nfa) {
+		this->m_states = nfa->getStatesVector();
+		map<State*, unsigned long> numbers;
+		for (unsigned long i = 0; i < this->m_states.size(); i++) {
+			numbers[this->m_states[i]] = i;
+		}
+		map<string, unsigned long> labels;
+		this->m_accepting = vector<bool>(this->m_states.size(), false);
+		this->m_post = vector<map<unsigned long, vector<unsigned long>>>(this->m_states.size());
+		this->m_pre = vector<map<unsigned long, vector<unsigned long>>>(this->m_states.size());
+		for (unsigned long i = 0; i < this->m_states.size(); i++) {
+			State* state = this->m_states[i];
+			this->m_accepting[i] = (this->m_direction == FORWARD_REDUCTION) ? state->isFinal() : (state == nfa->getInitialState());
+			// The incoming transitions are read from the maps that each state keeps, without inverting the exiting ones
+			const map<string, set<State*>>& transitions = (this->m_direction == FORWARD_REDUCTION)
+					? state->getExitingTransitionsRef()
+					: state->getIncomingTransitionsRef();
+			for (auto &pair : transitions) {
+				if (pair.second.empty()) {
+					continue;
+				}
+				unsigned long label = labels.insert({ pair.first, labels.size() }).first->second;
+				for (State* target : pair.second) {
+					unsigned long j = numbers[target];
+					this->m_post[i][label].push_back(j);
+					this->m_pre[j][label].push_back(i);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Returns the quotient of the NFA, given the block of each state in the indexing order.
+	 * Each block becomes a state, named as its first state; a block is final if it contains a final state,
+	 * and the transitions between the blocks are the transitions between their states (see Automaton::quotient).
+	 */
+	Automaton* ReductionAlgorithm::buildQuotient(Automaton* nfa, const vector<unsigned long>& blocks, unsigned long blocks_count) {
+		map<State*, unsigned long> state_blocks;
+		for (unsigned long i = 0; i < this->m_states.size(); i++) {
+			state_blocks[this->m_states[i]] = blocks[i];
+		}
+		Automaton* quotient = nfa->quotient(state_blocks, blocks_count, [](const string& label) {
+			return vector<string> { label };
+		});
+		DEBUG_LOG("The NFA has been reduced from %lu to %lu states", this->m_states.size(), blocks_count);
+		return quotient;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// BisimulationReductionAlgorithm
+
+	/**
+	 * Constructor.
+	 */
+	BisimulationReductionAlgorithm::BisimulationReductionAlgorithm(ReductionDirection direction)
+	: ReductionAlgorithm(
+		(direction == FORWARD_REDUCTION) ? FBR_ABBR : BBR_ABBR,
+		(direction == FORWARD_REDUCTION) ? FBR_NAME : BBR_NAME,
+		direction) {}
+
+	/**
+	 * Destructor.
+	 */
+	BisimulationReductionAlgorithm::~BisimulationReductionAlgorithm() {}
+
+	/**
+	 * Returns the quotient of the NFA by the coarsest bisimulation.
+	 * The NFA passed as parameter is not modified.
+	 */
+	Automaton* BisimulationReductionAlgorithm::run(Automaton* nfa) {
+		TRACE_SPAN("Bisimulation reduction");
+		this->indexAutomaton(nfa);
+		const unsigned long n = this->m_states.size();
+
+		// Initial partition: accepting and non-accepting states
+		vector<unsigned long> blocks = vector<unsigned long>(n);
+		unsigned long blocks_count = 0;
+		{
+			map<bool, unsigned long> initial_blocks;
+			for (unsigned long i = 0; i < n; i++) {
+				blocks[i] = initial_blocks.insert({ this->m_accepting[i], initial_blocks.size() }).first->second;
+			}
+			blocks_count = initial_blocks.size();
+		}
+
+		// Refinement: each state gets the block of its signature, until the number of blocks is stable
+		// Since the signature includes the current block, the blocks are only split, never merged
+		while (true) {
+			map<pair<unsigned long, vector<pair<unsigned long, unsigned long>>>, unsigned long> signatures;
+			vector<unsigned long> new_blocks = vector<unsigned long>(n);
+			for (unsigned long i = 0; i < n; i++) {
+				vector<pair<unsigned long, unsigned long>> signature;
+				for (auto &pair : this->m_post[i]) {
+					for (unsigned long j : pair.second) {
+						signature.push_back({ pair.first, blocks[j] });
+					}
+				}
+				std::sort(signature.begin(), signature.end());
+				signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+				new_blocks[i] = signatures.insert({ { blocks[i], signature }, signatures.size() }).first->second;
+			}
+			blocks.swap(new_blocks);
+			if (signatures.size() == blocks_count) {
+				break;
+			}
+			blocks_count = signatures.size();
+		}
+
+		return this->buildQuotient(nfa, blocks, blocks_count);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// SimulationReductionAlgorithm
+
+	/**
+	 * Constructor.
+	 */
+	SimulationReductionAlgorithm::SimulationReductionAlgorithm(ReductionDirection direction)
+	: ReductionAlgorithm(
+		(direction == FORWARD_REDUCTION) ? FSR_ABBR : BSR_ABBR,
+		(direction == FORWARD_REDUCTION) ? FSR_NAME : BSR_NAME,
+		direction) {}
+
+	/**
+	 * Destructor.
+	 */
+	SimulationReductionAlgorithm::~SimulationReductionAlgorithm() {}
+
+	/**
+	 * Private method.
+	 * Checks whether the state p can simulate the state q, given the current relation (as a matrix of bits):
+	 * for every transition q --a--> q', there must be a transition p --a--> p' with p' simulating q'.
+	 */
+	bool SimulationReductionAlgorithm::checkPair(const vector<uint64_t>& relation, unsigned long words, unsigned long q, unsigned long p) {
+		for (auto &pair : this->m_post[q]) {
+			auto iterator = this->m_post[p].find(pair.first);
+			if (iterator == this->m_post[p].end()) {
+				return false;
+			}
+			for (unsigned long q_child : pair.second) {
+				bool simulated = false;
+				for (unsigned long p_child : iterator->second) {
+					if ((relation[q_child * words + p_child / 64] >> (p_child % 64)) & 1ULL) {
+						simulated = true;
+						break;
+					}
+				}
+				if (!simulated) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Returns the quotient of the NFA by the simulation equivalence.
+	 * The NFA passed as parameter is not modified.
+	 */
+	Automaton* SimulationReductionAlgorithm::run(Automaton* nfa) {
+		TRACE_SPAN("Simulation reduction");
+		this->indexAutomaton(nfa);
+		const unsigned long n = this->m_states.size();
+		const unsigned long words = (n + 63) / 64;
+
+		// The relation starts from the pairs (q, p) where p is accepting if q is, and p has all the labels of q
+		// The bit (q, p) means "p simulates q"
+		vector<uint64_t> relation = vector<uint64_t>(n * words, 0);
+		for (unsigned long q = 0; q < n; q++) {
+			for (unsigned long p = 0; p < n; p++) {
+				if (this->m_accepting[q] && !this->m_accepting[p]) {
+					continue;
+				}
+				bool has_labels = std::all_of(this->m_post[q].begin(), this->m_post[q].end(), [this, p](auto &pair) {
+					return this->m_post[p].count(pair.first) > 0;
+				});
+				if (has_labels) {
+					relation[q * words + p / 64] |= (1ULL << (p % 64));
+				}
+			}
+		}
+
+		// First pass over all the pairs; then, only the parents of the removed pairs are checked again
+		std::deque<pair<unsigned long, unsigned long>> removed;
+		for (unsigned long q = 0; q < n; q++) {
+			for (unsigned long p = 0; p < n; p++) {
+				if (((relation[q * words + p / 64] >> (p % 64)) & 1ULL) && !this->checkPair(relation, words, q, p)) {
+					relation[q * words + p / 64] &= ~(1ULL << (p % 64));
+					removed.push_back({ q, p });
+				}
+			}
+		}
+		while (!removed.empty()) {
+			unsigned long q_child = removed.front().first;
+			unsigned long p_child = removed.front().second;
+			removed.pop_front();
+			for (auto &pair : this->m_pre[q_child]) {
+				auto iterator = this->m_pre[p_child].find(pair.first);
+				if (iterator == this->m_pre[p_child].end()) {
+					continue;
+				}
+				for (unsigned long q : pair.second) {
+					for (unsigned long p : iterator->second) {
+						if (((relation[q * words + p / 64] >> (p % 64)) & 1ULL) && !this->checkPair(relation, words, q, p)) {
+							relation[q * words + p / 64] &= ~(1ULL << (p % 64));
+							removed.push_back({ q, p });
+						}
+					}
+				}
+			}
+		}
+
+		// Classes of the states simulating each other
+		vector<unsigned long> blocks = vector<unsigned long>(n, n);
+		unsigned long blocks_count = 0;
+		for (unsigned long q = 0; q < n; q++) {
+			if (blocks[q] != n) {
+				continue;
+			}
+			blocks[q] = blocks_count;
+			for (unsigned long p = q + 1; p < n; p++) {
+				if (((relation[q * words + p / 64] >> (p % 64)) & 1ULL) && ((relation[p * words + q / 64] >> (q % 64)) & 1ULL)) {
+					blocks[p] = blocks_count;
+				}
+			}
+			blocks_count++;
+		}
+
+		return this->buildQuotient(nfa, blocks, blocks_count);
+	}
+
+} /* namespace quicksc */
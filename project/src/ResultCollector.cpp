@@ -13,9 +13,12 @@
 #include <fstream>
 #include <math.h>
 
+#include "AntichainChecker.hpp"
 #include "AutomataDrawer.hpp"
 #include "Properties.hpp"
 #include "QuickSubsetConstruction.hpp"
+#include "SessionScheduler.hpp"
+#include "Trace.hpp"
 
 //#define DEBUG_MODE
 #include "Debug.hpp"
@@ -23,6 +26,7 @@
 using namespace std;
 
 #define COMPUTE_CORRECTNESS false
+#define NO_SUCCESS_PERCENTAGE -1.0
 #define DEFAULT_MAX_CONVENIENCE 9999.9999
 #define DEFAULT_MAX_SCALE_FACTOR 9999.9999
 
@@ -33,6 +37,10 @@ namespace quicksc {
 		"SOL_SIZE       [#] ",
 		"SOL_GROWTH     [%] ",
         "SOL_TR_COUNT   [#] ",
+		"SOL_BOUND      [%] ",
+		"GEN_TIME       [ms]",
+		"GEN_WAIT       [ms]",
+		"PERTURBATIONS  [#] ",
 	};
 
 	// Strings for the statistics visualization
@@ -45,6 +53,9 @@ namespace quicksc {
 		"UNIT_COUNT     [#] ",
 		"VELOCITY       [#/ms]",
 		"SCALE_FACTOR   [.]",
+		"PEAK_HEAP      [KiB]",
+		"ALLOCATIONS    [#]",
+		"PEAK_RSS       [KiB]",
 		/* Skip
 		"UNIT_TIME      [ms]",
 		"CONVENIENCE    [.] ",
@@ -82,7 +93,7 @@ namespace quicksc {
 		case SOL_SIZE :
 			getter = [](Result* result) {
 				DeterminizationAlgorithm* benchmark = result->benchmark_algorithm;
-				return (double) (result->solutions[benchmark]->size());
+				return (double) (result->solution_sizes[benchmark]);
 			};
 			break;
 
@@ -90,14 +101,46 @@ namespace quicksc {
 			aux_size = this->m_config_reference->valueOf<unsigned int>(AutomatonSize);
 			getter = [aux_size](Result* result) {
 				DeterminizationAlgorithm* benchmark = result->benchmark_algorithm;
-				return ((double) (result->solutions[benchmark]->size()) / aux_size) * 100;
+				return ((double) (result->solution_sizes[benchmark]) / aux_size) * 100;
 			};
 			break;
 
 		case SOL_TR_COUNT :
 			getter = [](Result* result) {
 				DeterminizationAlgorithm* benchmark = result->benchmark_algorithm;
-				return (double) (result->solutions[benchmark]->getTransitionsCount());
+				return (double) (result->solution_transitions[benchmark]);
+			};
+			break;
+
+		case SOL_BOUND :
+			getter = [](Result* result) {
+				DeterminizationAlgorithm* benchmark = result->benchmark_algorithm;
+				unsigned long int bound = ((DeterminizationProblem*) result->original_problem)->getDFASizeBound();
+				if (bound == DFA_SIZE_UNKNOWN) {
+					return 0.0;
+				}
+				return ((double) (result->solution_sizes[benchmark]) / bound) * 100;
+			};
+			break;
+
+		case GEN_TIME :
+			getter = [](Result* result) {
+				return result->generation_time;
+			};
+			break;
+
+		case GEN_WAIT :
+			getter = [](Result* result) {
+				return result->generation_wait;
+			};
+			break;
+
+		case PERTURBATIONS :
+			getter = [](Result* result) {
+				if (result->original_problem->getType() != Problem::DFA_PERTURBATION_PROBLEM) {
+					return 0.0;
+				}
+				return (double) ((DFAPerturbationProblem*) result->original_problem)->getPerturbations();
 			};
 			break;
 
@@ -152,8 +195,8 @@ namespace quicksc {
 			getter = [algorithm](Result* result) {
 				DeterminizationAlgorithm* benchmark = result->benchmark_algorithm;
 
-				signed long int benchmark_time = (signed long int) (result->times[benchmark]);
-				signed long int algorithm_time = (signed long int) (result->times[algorithm]);
+				double benchmark_time = result->times[benchmark];
+				double algorithm_time = result->times[algorithm];
 
 				if (benchmark_time == algorithm_time) {
 					return 0.0;
@@ -187,10 +230,9 @@ namespace quicksc {
 				}
 				else {
 					DEBUG_LOG("The algorithm has no singularities, so we take the transitions count");
-					DEBUG_ASSERT_NOT_NULL(result->solutions[algorithm]);
 					// Otherwise, we return the number of transitions of the solution
-					DEBUG_LOG("Number of transitions = %d", result->solutions[algorithm]->getTransitionsCount());
-					return (double) (result->solutions[algorithm]->getTransitionsCount());
+					DEBUG_LOG("Number of transitions = %u", result->solution_transitions[algorithm]);
+					return (double) (result->solution_transitions[algorithm]);
 				}
 			};
 			break;
@@ -228,6 +270,24 @@ namespace quicksc {
 			};
 			break;
 
+		case PEAK_HEAP :
+			getter = [algorithm](Result* result) {
+				return (double) (result->memory[algorithm].peak_heap_bytes) / 1024;
+			};
+			break;
+
+		case ALLOCATIONS :
+			getter = [algorithm](Result* result) {
+				return (double) (result->memory[algorithm].allocations);
+			};
+			break;
+
+		case PEAK_RSS :
+			getter = [algorithm](Result* result) {
+				return (double) (result->memory[algorithm].peak_rss_kb);
+			};
+			break;
+
 		/*
 		case UNIT_PROCESSING_TIME :
 			getter = [this, algorithm](Result* result) {
@@ -383,17 +443,67 @@ namespace quicksc {
 		return this->computeStat(getter);
 	}
 
+	/**
+	 * Utility function that removes the trailing spaces of a headline.
+	 */
+	string trimHeadline(string headline) {
+		return headline.substr(0, headline.find_last_not_of(" ") + 1);
+	}
+
+	/**
+	 * Returns all the statistics of the collector, aggregated over all the testcases currently contained in the list.
+	 * The statistics are listed in the same order of the CSV log: first the statistics of the results, then the
+	 * statistics of each algorithm (general and runtime ones).
+	 */
+	vector<AggregatedStat> ResultCollector::getAggregatedStats() {
+		vector<AggregatedStat> aggregated_stats;
+		unsigned int samples = this->getTestCaseNumber();
+
+		for (int int_stat = 0; int_stat < RESULTSTAT_END; int_stat++) {
+			ResultStat stat = static_cast<ResultStat>(int_stat);
+			aggregated_stats.push_back({ trimHeadline(result_stat_headlines[stat]), this->getStat(stat), samples, false });
+		}
+
+		for (DeterminizationAlgorithm* algo : this->m_algorithms) {
+			for (int int_stat = 0; int_stat < ALGORITHMSTAT_END; int_stat++) {
+				AlgorithmStat stat = static_cast<AlgorithmStat>(int_stat);
+				bool is_cost = (stat == EXECUTION_TIME || stat == PEAK_HEAP || stat == ALLOCATIONS || stat == PEAK_RSS);
+				aggregated_stats.push_back({ algo->abbr() + " " + trimHeadline(algorithm_stat_headlines[stat]), this->getStat(stat, algo), samples, is_cost });
+			}
+			for (RuntimeStat stat : algo->getRuntimeStatsList()) {
+				// The runtime statistics measuring a time are costs
+				bool is_cost = (stat.find("[ms]") != string::npos || stat.find("[ns]") != string::npos);
+				aggregated_stats.push_back({ algo->abbr() + " " + trimHeadline(stat), this->getStat(stat, algo), samples, is_cost });
+			}
+		}
+		return aggregated_stats;
+	}
+
 	/**
 	 * Returns the success percentage of the algorithm passed as a reference,
 	 * compared to the sample of all available testcases.
 	 * The correctness test is done in relation to the solution provided by the benchmark algorithm, which is
 	 * assumed to be correct.
 	 * If the benchmark algorithm is passed as input, the maximum correctness will be obtained (100%).
+	 * The solutions are compared by language equivalence, since the wrappers (e.g. the reductions) name the states differently.
+	 * The testcases whose solutions have not been sent back by an isolated run are not considered, nor the solutions
+	 * of the algorithms whose labels are not comparable (see DeterminizationAlgorithm::hasComparableSolutions);
+	 * if no testcase can be compared (e.g. with "?isolsolution = 0"), the negative value NO_SUCCESS_PERCENTAGE is returned.
 	 */
 	double ResultCollector::getSuccessPercentage(DeterminizationAlgorithm* algorithm) {
+		TRACE_SPAN("Validation");
 		int correct_result_counter = 0;
+		int compared_result_counter = 0;
 		for (Result* result : this->m_results) {
-			if (*(result->solutions[result->benchmark_algorithm]) == *(result->solutions[algorithm])) {
+			if (result->solutions[result->benchmark_algorithm] == NULL || result->solutions[algorithm] == NULL) {
+				continue;
+			}
+			if (!result->benchmark_algorithm->hasComparableSolutions() || !algorithm->hasComparableSolutions()) {
+				continue;
+			}
+			compared_result_counter++;
+			AntichainChecker checker = AntichainChecker();
+			if (checker.isEquivalent(result->solutions[result->benchmark_algorithm], result->solutions[algorithm])) {
 				correct_result_counter++;
 			}
 			// If debug is active, the wrong automaton is printed
@@ -416,7 +526,10 @@ namespace quicksc {
 				}
 			)
 		}
-		return ((double)(correct_result_counter)) / this->m_results.size();
+		if (compared_result_counter == 0) {
+			return NO_SUCCESS_PERCENTAGE;
+		}
+		return ((double)(correct_result_counter)) / compared_result_counter;
 	}
 
 	/**
@@ -459,7 +572,10 @@ namespace quicksc {
 			Automaton* solution = pair.second;
 
 			DEBUG_ASSERT_NOT_NULL(algorithm);
-			DEBUG_ASSERT_NOT_NULL(solution);
+			if (solution == NULL) {
+				// The solution has been computed in an isolated process and has not been sent back
+				continue;
+			}
 
 			DEBUG_MARK_PHASE("Presenting the solution automaton of the algorithm %s", algorithm->name().c_str()) {
 
@@ -479,6 +595,13 @@ namespace quicksc {
 				}
 			}
 		}
+
+		if (this->m_config_reference->valueOf<bool>(PrintPhases)) {
+			for (auto &pair : result->phases) {
+				printf(COLOR_PURPLE("\nPhases of %s:\n"), pair.first->name().c_str());
+				std::cout << pair.second;
+			}
+		}
 	}
 
 	/**
@@ -599,8 +722,7 @@ namespace quicksc {
 
 			ofstream file_out;
 			if (do_log) {
-				string stat_file_name = DIR_RESULTS;
-				stat_file_name += string(FILE_NAME_STATS_LOG) + string(FILE_EXTENSION_CSV);
+				string stat_file_name = SessionScheduler::getLogFileName(FILE_NAME_STATS_LOG);
 				this->printLogHeader(stat_file_name);
 				file_out = ofstream(stat_file_name, ios::app);
 
@@ -634,7 +756,14 @@ namespace quicksc {
 
 				if (do_print) {
 					printf("\n" COLOR_PURPLE("%s") "\n", algo->name().c_str());
-					//printf("Success percentage = %f %%\n", (100 * this->getSuccessPercentage(algo)));
+					if (COMPUTE_CORRECTNESS) {
+						double success_percentage = this->getSuccessPercentage(algo);
+						if (success_percentage == NO_SUCCESS_PERCENTAGE) {
+							printf("Success percentage = N/A\n");
+						} else {
+							printf("Success percentage = %f %%\n", (100 * success_percentage));
+						}
+					}
 				}
 
 				// Iteration over all the statistics depending on the algorithm and the automaton
@@ -0,0 +1,253 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * ScalingAnalyzer.cpp
+ *
+ *
+ * This source file contains the implementation of the class ScalingAnalyzer.
+ * Each point of the curve is solved by a new ProblemSolver, with the parameter overridden in the configurations;
+ * the results of each point are presented (and logged) as a normal test case.
+ */
+
+#include "ScalingAnalyzer.hpp"
+
+#include <cmath>
+#include <fstream>
+
+#include "ProblemSolver.hpp"
+#include "Properties.hpp"
+#include "SessionScheduler.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+using namespace std;
+
+namespace quicksc {
+
+	/**
+	 * Constructor.
+	 * The parameter to grow is read from the configurations ("ScalingParameter" setting).
+	 */
+	ScalingAnalyzer::ScalingAnalyzer(Configurations* configurations, const vector<DeterminizationAlgorithm*>& algorithms)
+			: m_algorithms(algorithms) {
+		this->m_config_reference = configurations;
+		this->m_parameter = (SettingID) configurations->valueOf<int>(ScalingParameter);
+		this->m_points = vector<ScalingPoint>();
+	}
+
+	/**
+	 * Destructor.
+	 */
+	ScalingAnalyzer::~ScalingAnalyzer() {}
+
+	/**
+	 * Private method.
+	 * Returns the list of the statistics measured at each point of the curve.
+	 */
+	vector<string> ScalingAnalyzer::getScalingStatsList() {
+		return vector<string> {
+			SCALING_TIME,
+			SCALING_DFA_SIZE,
+			SCALING_PEAK_HEAP,
+		};
+	}
+
+	/**
+	 * Private method.
+	 * Extracts the average values of the statistics from the results of a single point of the curve.
+	 */
+	ScalingPoint ScalingAnalyzer::measurePoint(ResultCollector* collector, const vector<DeterminizationAlgorithm*>& active_algorithms, double parameter_value) {
+		ScalingPoint point;
+		point.parameter_value = parameter_value;
+		// The size of the DFA is the size of the benchmark solution, which is the same for all the (correct) algorithms
+		double dfa_size = std::get<1>(collector->getStat(SOL_SIZE));
+		for (DeterminizationAlgorithm* algo : active_algorithms) {
+			// The execution time is collected in milliseconds
+			point.values[algo][SCALING_TIME] = std::get<1>(collector->getStat(EXECUTION_TIME, algo));
+			point.values[algo][SCALING_DFA_SIZE] = dfa_size;
+			point.values[algo][SCALING_PEAK_HEAP] = std::get<1>(collector->getStat(PEAK_HEAP, algo));
+		}
+		return point;
+	}
+
+	/**
+	 * Executes the scaling curve.
+	 * The starting value of the parameter is its current value in the configurations; at each step, the value is
+	 * multiplied by the "ScalingFactor" setting. An algorithm is excluded from the following steps as soon as its
+	 * average execution time exceeds the "ScalingTimeBudget" setting.
+	 * The curve ends when all the algorithms are excluded, or when the maximum number of points is reached.
+	 */
+	void ScalingAnalyzer::run() {
+		double factor = this->m_config_reference->valueOf<double>(ScalingFactor);
+		double budget_ms = this->m_config_reference->valueOf<double>(ScalingTimeBudget);
+		unsigned int max_points = this->m_config_reference->valueOf<unsigned int>(ScalingMaxPoints);
+		unsigned int testcases = this->m_config_reference->valueOf<unsigned int>(Testcases);
+
+		if (factor <= 1) {
+			DEBUG_LOG_ERROR("The scaling factor must be greater than 1, but it is %f", factor);
+			throw "Invalid scaling factor";
+		}
+
+		double parameter_value = this->m_config_reference->valueOf<double>(this->m_parameter);
+		vector<DeterminizationAlgorithm*> active_algorithms = vector<DeterminizationAlgorithm*>(this->m_algorithms);
+
+		for (unsigned int point_index = 0; point_index < max_points && !active_algorithms.empty(); point_index++) {
+			this->m_config_reference->overrideValue(this->m_parameter, parameter_value);
+			// The effective value may be different from the computed one, because of the rounding of integer settings
+			double effective_value = this->m_config_reference->valueOf<double>(this->m_parameter);
+
+			std::cout << "Scaling point " << (point_index + 1) << ": " << Configurations::nameOf(this->m_parameter) << " = " << effective_value << std::endl;
+
+			vector<DeterminizationAlgorithm*> next_algorithms;
+			{
+				ProblemSolver solver = ProblemSolver(this->m_config_reference, active_algorithms);
+				solver.solveSeries(testcases);
+				solver.getResultCollector()->presentResults();
+				std::cout << std::endl;
+
+				ScalingPoint point = this->measurePoint(solver.getResultCollector(), active_algorithms, effective_value);
+				this->m_points.push_back(point);
+
+				for (DeterminizationAlgorithm* algo : active_algorithms) {
+					if (point.values[algo][SCALING_TIME] <= budget_ms) {
+						next_algorithms.push_back(algo);
+					} else {
+						std::cout << "The algorithm " << algo->name() << " exceeded the time budget of " << budget_ms << " ms" << std::endl;
+					}
+				}
+			}
+			active_algorithms = next_algorithms;
+			parameter_value *= factor;
+		}
+
+		this->m_config_reference->restoreValue(this->m_parameter);
+	}
+
+	/**
+	 * Static method.
+	 * Computes the linear regression of the samples (x, y) in the log-log space, with the least squares method.
+	 * The samples with non-positive values are ignored, since their logarithm is not defined.
+	 */
+	ScalingFit ScalingAnalyzer::fitLogLog(const vector<pair<double, double>>& samples) {
+		double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0, sum_yy = 0;
+		unsigned int n = 0;
+		for (auto& sample : samples) {
+			if (sample.first <= 0 || sample.second <= 0) {
+				continue;
+			}
+			double x = log(sample.first);
+			double y = log(sample.second);
+			sum_x += x;
+			sum_y += y;
+			sum_xx += x * x;
+			sum_xy += x * y;
+			sum_yy += y * y;
+			n++;
+		}
+
+		ScalingFit fit = {NAN, NAN, NAN, n};
+		double denominator = n * sum_xx - sum_x * sum_x;
+		if (n < 2 || denominator == 0) {
+			return fit;
+		}
+		fit.slope = (n * sum_xy - sum_x * sum_y) / denominator;
+		fit.intercept = (sum_y - fit.slope * sum_x) / n;
+
+		// Coefficient of determination
+		double variance_y = n * sum_yy - sum_y * sum_y;
+		if (variance_y == 0) {
+			fit.r_squared = 1;
+		} else {
+			double covariance = n * sum_xy - sum_x * sum_y;
+			fit.r_squared = (covariance * covariance) / (denominator * variance_y);
+		}
+		return fit;
+	}
+
+	/**
+	 * Returns the log-log fit of a statistic for an algorithm, over all the points where the algorithm has been measured.
+	 */
+	ScalingFit ScalingAnalyzer::getFit(DeterminizationAlgorithm* algorithm, string stat) {
+		vector<pair<double, double>> samples;
+		for (ScalingPoint& point : this->m_points) {
+			if (point.values.count(algorithm) && point.values[algorithm].count(stat)) {
+				samples.push_back(make_pair(point.parameter_value, point.values[algorithm][stat]));
+			}
+		}
+		return ScalingAnalyzer::fitLogLog(samples);
+	}
+
+	/**
+	 * Private method.
+	 * Prints the header of the log file, only if the file does not exist yet.
+	 */
+	void ScalingAnalyzer::printLogHeader(string log_file_name) {
+		ifstream ifile(log_file_name);
+		if (!(bool)ifile) {
+			ofstream file_out(log_file_name, ios::app);
+			file_out << "Parameter, Start value, End value, Algorithm, Statistic, Points, Slope, Intercept, R2, " << std::endl;
+			file_out.close();
+		}
+		ifile.close();
+	}
+
+	/**
+	 * Macro defining the format of the output.
+	 */
+	#define SCALING_FORMAT "\t" COLOR_PINK("%-20s %6s") " | %11.4f | %11.4f | %11.4f | %11u |\n"
+
+	/**
+	 * Presents the fitted exponents of all the algorithms, for all the statistics.
+	 * The output depends on the program settings, like the presentation of the results of the test cases.
+	 */
+	void ScalingAnalyzer::presentResults() {
+		bool do_print = this->m_config_reference->valueOf<bool>(PrintStatistics);
+		bool do_log   = this->m_config_reference->valueOf<bool>(LogStatistics);
+		if (this->m_points.empty() || (!do_print && !do_log)) {
+			return;
+		}
+
+		double start_value = this->m_points.front().parameter_value;
+		double end_value = this->m_points.back().parameter_value;
+
+		if (do_print) {
+			printf("SCALING RESULTS:\n");
+			printf("Parameter \"%s\" grown from " COLOR_BLUE("%.2f") " to " COLOR_BLUE("%.2f") " in " COLOR_BLUE("%lu") " points\n",
+				Configurations::nameOf(this->m_parameter).c_str(), start_value, end_value, this->m_points.size());
+			printf("\n_____________________________________|____" COLOR_YELLOW("SLOPE") "____|__" COLOR_YELLOW("INTERCEPT") "__|_____" COLOR_YELLOW("R^2") "_____|___" COLOR_YELLOW("POINTS") "____|\n");
+		}
+
+		ofstream file_out;
+		if (do_log) {
+			string log_file_name = SessionScheduler::getLogFileName(FILE_NAME_SCALING_LOG);
+			this->printLogHeader(log_file_name);
+			file_out = ofstream(log_file_name, ios::app);
+		}
+
+		for (DeterminizationAlgorithm* algo : this->m_algorithms) {
+			if (do_print) {
+				printf("\n" COLOR_PURPLE("%s") "\n", algo->name().c_str());
+			}
+			for (string stat : this->getScalingStatsList()) {
+				ScalingFit fit = this->getFit(algo, stat);
+				if (do_print) {
+					string name = stat.substr(0, stat.find(" "));
+					string unit = stat.substr(stat.find("["));
+					printf(SCALING_FORMAT, name.c_str(), unit.c_str(), fit.slope, fit.intercept, fit.r_squared, fit.points);
+				}
+				if (do_log) {
+					file_out << Configurations::abbreviationOf(this->m_parameter) << ", " << start_value << ", " << end_value << ", ";
+					file_out << algo->abbr() << ", " << stat << ", " << fit.points << ", ";
+					file_out << std::to_string(fit.slope) << ", " << std::to_string(fit.intercept) << ", " << std::to_string(fit.r_squared) << ", " << std::endl;
+				}
+			}
+		}
+
+		if (do_log) {
+			file_out.close();
+		}
+	}
+
+} /* namespace quicksc */
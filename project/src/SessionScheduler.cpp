@@ -0,0 +1,239 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * SessionScheduler.cpp
+ *
+ *
+ * This source file contains the implementation of the class SessionScheduler.
+ */
+
+#include "SessionScheduler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Properties.hpp"
+#include "Trace.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+using namespace std;
+
+namespace quicksc {
+
+	int SessionScheduler::current_job = NO_JOB;
+
+	/**
+	 * Constructor.
+	 * It requires the configurations, positioned on the first test case, and the number of worker processes.
+	 */
+	SessionScheduler::SessionScheduler(Configurations* configurations, unsigned int workers) {
+		this->m_config_reference = configurations;
+		this->m_workers = (workers > 0) ? workers : 1;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	SessionScheduler::~SessionScheduler() {}
+
+	/**
+	 * Private static method.
+	 * Returns the name of a file of a job, in the "jobs" folder.
+	 */
+	string SessionScheduler::getJobFileName(unsigned int job, string name, string extension) {
+		return string(DIR_JOBS) + "job" + std::to_string(job) + "_" + name + extension;
+	}
+
+	/**
+	 * Returns the name of a CSV log file, given its name without folder and extension.
+	 * In the main process it's the file in the results folder; in a job, it's the file reserved to the job,
+	 * which will be merged at the end of the execution.
+	 */
+	string SessionScheduler::getLogFileName(string name) {
+		if (SessionScheduler::current_job == NO_JOB) {
+			return string(DIR_RESULTS) + name + FILE_EXTENSION_CSV;
+		}
+		return SessionScheduler::getJobFileName(SessionScheduler::current_job, name, FILE_EXTENSION_CSV);
+	}
+
+	/**
+	 * Returns the name of the file where the events of the tracing are exported.
+	 * The traces of the jobs are not merged, so each job writes its own file directly in the results folder.
+	 */
+	string SessionScheduler::getTraceFileName() {
+		if (SessionScheduler::current_job == NO_JOB) {
+			return string(DIR_RESULTS) + FILE_NAME_TRACE + FILE_EXTENSION_JSON;
+		}
+		return string(DIR_RESULTS) + FILE_NAME_TRACE + "_job" + std::to_string(SessionScheduler::current_job) + FILE_EXTENSION_JSON;
+	}
+
+	/**
+	 * Private method.
+	 * Forks a child process executing the test case on which the configurations are currently positioned.
+	 * The standard output of the child is redirected to the output file of the job.
+	 * The exit code of the child is the value returned by the test case.
+	 */
+	pid_t SessionScheduler::launch(unsigned int job, std::function<int()> test_case) {
+		// The buffers are flushed, otherwise their content would be printed by both the processes
+		std::cout.flush();
+		fflush(stdout);
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			DEBUG_LOG_ERROR("Cannot fork the process for the job %u", job);
+			throw "Cannot fork the process for a job";
+		}
+		if (pid > 0) {
+			return pid;
+		}
+
+		// Child process
+		SessionScheduler::current_job = job;
+		// The events inherited from the parent are not part of the job
+		TRACE_RESET();
+		string output_file_name = SessionScheduler::getJobFileName(job, "output", ".txt");
+		int output_fd = open(output_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (output_fd < 0 || dup2(output_fd, STDOUT_FILENO) < 0) {
+			_exit(1);
+		}
+		close(output_fd);
+
+		int exit_code;
+		try {
+			exit_code = test_case();
+		} catch (const char* message) {
+			std::cerr << "Job " << job << " failed: " << message << std::endl;
+			exit_code = 1;
+		}
+		std::cout.flush();
+		fflush(stdout);
+		TRACE_EXPORT(SessionScheduler::getTraceFileName());
+		// The child terminates without calling the destructors of the objects inherited from the parent
+		_exit(exit_code);
+	}
+
+	/**
+	 * Private method.
+	 * Prints the output of a completed job, then removes its file.
+	 */
+	void SessionScheduler::printOutput(unsigned int job) {
+		string output_file_name = SessionScheduler::getJobFileName(job, "output", ".txt");
+		ifstream file_in(output_file_name);
+		if (file_in) {
+			std::cout << file_in.rdbuf();
+			std::cout.flush();
+		}
+		file_in.close();
+		remove(output_file_name.c_str());
+	}
+
+	/**
+	 * Private method.
+	 * Appends the log files of the jobs to the log file of the results folder, in the order of the jobs.
+	 * As in the sequential execution, the header (i.e. the first line of the log of each job) is kept only if
+	 * the log file did not exist yet, and only once.
+	 */
+	void SessionScheduler::mergeLog(unsigned int jobs_count, string name) {
+		string log_file_name = string(DIR_RESULTS) + name + FILE_EXTENSION_CSV;
+		ifstream existing_file(log_file_name);
+		bool header_needed = !(bool)existing_file;
+		existing_file.close();
+
+		for (unsigned int job = 0; job < jobs_count; job++) {
+			string job_file_name = SessionScheduler::getJobFileName(job, name, FILE_EXTENSION_CSV);
+			ifstream file_in(job_file_name);
+			if (!file_in) {
+				continue;
+			}
+			ofstream file_out(log_file_name, ios::app);
+			string line;
+			bool first_line = true;
+			while (std::getline(file_in, line)) {
+				if (!first_line || header_needed) {
+					file_out << line << std::endl;
+				}
+				first_line = false;
+			}
+			header_needed = false;
+			file_in.close();
+			file_out.close();
+			remove(job_file_name.c_str());
+		}
+	}
+
+	/**
+	 * Runs all the test cases of the configurations, starting from the current one, in the worker processes.
+	 * The configurations are advanced by the main process after each launch, so that every child inherits its own test case.
+	 * The output of the jobs is printed as soon as all the previous jobs are completed; the logs are merged at the end.
+	 * Returns the maximum exit code of the jobs (1 if a job terminated abnormally).
+	 */
+	int SessionScheduler::run(std::function<int()> test_case) {
+		if (mkdir(DIR_JOBS, 0755) != 0 && errno != EEXIST) {
+			DEBUG_LOG_ERROR("Cannot create the folder \"%s\" for the jobs", DIR_JOBS);
+			throw "Cannot create the folder for the jobs";
+		}
+
+		map<pid_t, unsigned int> running_jobs;
+		vector<bool> completed_jobs;
+		unsigned int launched_jobs = 0;
+		unsigned int printed_jobs = 0;
+		bool more_jobs = true;
+		int exit_code = 0;
+
+		while (more_jobs || !running_jobs.empty()) {
+			// Filling the free workers
+			while (more_jobs && running_jobs.size() < this->m_workers) {
+				pid_t pid = this->launch(launched_jobs, test_case);
+				running_jobs[pid] = launched_jobs;
+				completed_jobs.push_back(false);
+				launched_jobs++;
+				more_jobs = this->m_config_reference->nextTestCase();
+			}
+
+			// Waiting for the termination of a job
+			int status;
+			pid_t pid = waitpid(-1, &status, 0);
+			if (pid < 0) {
+				DEBUG_LOG_ERROR("Cannot wait for the termination of the jobs");
+				throw "Cannot wait for the termination of the jobs";
+			}
+			auto it = running_jobs.find(pid);
+			if (it == running_jobs.end()) {
+				continue;
+			}
+			unsigned int job = it->second;
+			running_jobs.erase(it);
+			completed_jobs[job] = true;
+			if (!WIFEXITED(status)) {
+				std::cerr << "Job " << job << " terminated abnormally (status = " << status << ")" << std::endl;
+				exit_code = std::max(exit_code, 1);
+			} else {
+				exit_code = std::max(exit_code, WEXITSTATUS(status));
+			}
+
+			// Printing the output of the completed prefix of jobs
+			while (printed_jobs < launched_jobs && completed_jobs[printed_jobs]) {
+				this->printOutput(printed_jobs);
+				printed_jobs++;
+			}
+		}
+
+		this->mergeLog(launched_jobs, FILE_NAME_STATS_LOG);
+		this->mergeLog(launched_jobs, FILE_NAME_SCALING_LOG);
+		// The folder is removed only if empty, i.e. if no file has been left by the jobs
+		rmdir(DIR_JOBS);
+		return exit_code;
+	}
+
+} /* namespace quicksc */
@@ -16,6 +16,7 @@
 #include "Singularity.hpp"
 
 #include "Alphabet.hpp"
+#include "OperationCounters.hpp"
 #include "Debug.hpp"
 
 namespace quicksc {
@@ -132,7 +133,12 @@ namespace quicksc {
 	 * If the insertion is successful, returns TRUE.
 	 */
 	bool SingularityList::insert(Singularity* new_singularity) {
-		return ((this->m_set.insert(new_singularity)).second);
+		if ((this->m_set.insert(new_singularity)).second) {
+			COUNT_OPERATION(OP_SINGULARITY_INSERT);
+			return true;
+		}
+		COUNT_OPERATION(OP_SINGULARITY_DUPLICATE);
+		return false;
 	}
 
 	/**
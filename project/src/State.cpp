@@ -19,6 +19,7 @@
 #include <string>
 
 #include "Alphabet.hpp"
+#include "OperationCounters.hpp"
 //#define DEBUG_MODE
 #include "Debug.hpp"
 
@@ -29,6 +30,8 @@ using std::string;
 
 namespace quicksc {
 
+	thread_local StateObserver* State::observer = NULL;
+
 	/**
 	 * Constructor of the class State.
 	 * Initializes the incoming and outgoing transitions sets as empty.
@@ -46,6 +49,9 @@ namespace quicksc {
 	 */
 	State::~State () {
 		DEBUG_LOG( "Destructing the State object \"%s\"", m_name.c_str() );
+		if (State::getObserver() != NULL) {
+			State::getObserver()->notifyDestruction(this);
+		}
 	}
 
 	/**
@@ -77,6 +83,9 @@ namespace quicksc {
 	 */
 	void State::setFinal(bool final) {
 		m_final = final;
+		if (State::getObserver() != NULL) {
+			State::getObserver()->notifyModification(this);
+		}
 	}
 
 	/**
@@ -90,6 +99,7 @@ namespace quicksc {
 	 * @return True if the transition has been added, false otherwise.
 	 */
 	bool State::connectChild(string label, State* child)	{
+		COUNT_OPERATION(OP_CONNECT_CHILD);
 		bool flag_new_insertion = false;
 
 		// If the current state has no outgoing transitions labeled with "label",
@@ -114,6 +124,9 @@ namespace quicksc {
 			// We add the transition in both sense
 			this->m_exiting_transitions[label].insert(child);
 			child->m_incoming_transitions[label].insert(getThis());
+			if (State::getObserver() != NULL) {
+				State::getObserver()->notifyModification(this);
+			}
 			return true;
 		}
 		else {
@@ -130,6 +143,7 @@ namespace quicksc {
 	 * Precondition: it is assumed that such a transition exists.
 	 */
 	void State::disconnectChild(string label, State* child) {
+		COUNT_OPERATION(OP_DISCONNECT_CHILD);
 		if (!this->hasExitingTransition(label)) {
 			DEBUG_LOG("There are no exiting transitions with label %s", label.c_str());
 			return;
@@ -142,12 +156,40 @@ namespace quicksc {
 			this->m_exiting_transitions[label].erase(iterator);
 			DEBUG_ASSERT_FALSE(this->hasExitingTransition(label, child));
 			child->m_incoming_transitions[label].erase(getThis());
+			if (State::getObserver() != NULL) {
+				State::getObserver()->notifyModification(this);
+			}
 		} else {
 			DEBUG_LOG_FAIL("The child state %s has not been found for the label %s", child->getName().c_str(), label.c_str());
 			return;
 		}
 	}
 
+	/**
+	 * Disconnects all the children reached from this state with the label passed as parameter.
+	 * Differently from "disconnectChild", the entries of the label are erased from the maps of the transitions
+	 * (in this state and in the children, when they have no other parents), so that no empty set of children is left.
+	 */
+	void State::disconnectChildren(string label) {
+		auto search = this->m_exiting_transitions.find(label);
+		if (search == this->m_exiting_transitions.end()) {
+			DEBUG_LOG("There are no exiting transitions with label %s", label.c_str());
+			return;
+		}
+		for (State* child : search->second) {
+			COUNT_OPERATION(OP_DISCONNECT_CHILD);
+			auto parents = child->m_incoming_transitions.find(label);
+			parents->second.erase(getThis());
+			if (parents->second.empty()) {
+				child->m_incoming_transitions.erase(parents);
+			}
+		}
+		this->m_exiting_transitions.erase(search);
+		if (State::getObserver() != NULL) {
+			State::getObserver()->notifyModification(this);
+		}
+	}
+
 	/**
 	 * Removes all the incoming and outgoing transitions
 	 * from this state.
@@ -607,6 +649,7 @@ namespace quicksc {
 	 * every time its extension is assigned or modified.
 	 */
 	string ConstructedState::createNameFromExtension(const Extension &ext) {
+		COUNT_OPERATION(OP_NAME_CONSTRUCTION);
 		if (ext.empty()) {
 			return EMPTY_EXTENSION_NAME;
 		}
@@ -635,6 +678,7 @@ namespace quicksc {
 		for (State* s : ext1) {
 			if (ext2.count(s) == 0) {
 				result.insert(s);
+				COUNT_OPERATION(OP_EXTENSION_INSERT);
 			}
 		}
 
@@ -646,6 +690,7 @@ namespace quicksc {
 	 * Computes the epsilon closure of an extension, that is, of a set of states (usually a set of states of an NFA).
 	 */
 	Extension ConstructedState::computeEpsilonClosure(const Extension &ext) {
+		COUNT_OPERATION(OP_EPSILON_CLOSURE);
 		Extension result = set<State*, State::Comparator>(ext);
 		list<State*> queue = list<State*>();
 		for (State* s : ext) {
@@ -656,6 +701,7 @@ namespace quicksc {
 			// Extract the state to process
 			State* current = queue.front();
 			queue.pop_front();
+			COUNT_OPERATION(OP_EPSILON_VISIT);
 			// Compute the states reachable through epsilon transitions
 			set<State*> closure = current->getChildren(EPSILON);
 			// For each state in the closure
@@ -676,6 +722,7 @@ namespace quicksc {
 	 * Computes the epsilon closure of a single state.
 	 */
 	Extension ConstructedState::computeEpsilonClosure(State* state) {
+		COUNT_OPERATION(OP_EPSILON_CLOSURE);
 		Extension result = set<State*, State::Comparator>();
 		result.insert(state);
 		list<State*> queue = list<State*>();
@@ -684,6 +731,7 @@ namespace quicksc {
 		while (!queue.empty()) {
 			State* current = queue.front();
 			queue.pop_front();
+			COUNT_OPERATION(OP_EPSILON_VISIT);
 			set<State*> closure = current->getChildren(EPSILON);
 			for (State* epsilon_child : closure) {
 				if (result.insert(epsilon_child).second) {
@@ -791,6 +839,7 @@ namespace quicksc {
 		for (State* member : this->m_extension) {
 			for (State* child : member->getChildren(label)) {
 				l_closure.insert(child);
+				COUNT_OPERATION(OP_EXTENSION_INSERT);
 			}
 		}
 		return ConstructedState::computeEpsilonClosure(l_closure);
@@ -808,6 +857,7 @@ namespace quicksc {
 		Extension l_closure;
 		for (State* child : this->getChildren(label)) {
 			l_closure.insert(child);
+			COUNT_OPERATION(OP_EXTENSION_INSERT);
 		}
 		return ConstructedState::computeEpsilonClosure(l_closure);
 	}
@@ -821,6 +871,9 @@ namespace quicksc {
 		this->m_extension = new_ext;
 		this->m_name = createNameFromExtension(m_extension);
 		this->m_final = hasFinalStates(m_extension);
+		if (State::getObserver() != NULL) {
+			State::getObserver()->notifyModification(this);
+		}
 	}
 
 	/**
@@ -889,6 +942,23 @@ namespace quicksc {
 		return clone;
 	}
 
+	/**
+	 * Static method.
+	 * Sets the observer notified of the modifications of the states made by the current thread.
+	 * A NULL value removes the observer.
+	 */
+	void State::setObserver(StateObserver* observer) {
+		State::observer = observer;
+	}
+
+	/**
+	 * Static method.
+	 * Returns the observer of the modifications made by the current thread, or NULL if it's not set.
+	 */
+	StateObserver* State::getObserver() {
+		return State::observer;
+	}
+
 	/**
 	 * This method clones the state, that is, it creates a new state with the same name, distance, finality.
 	 * 
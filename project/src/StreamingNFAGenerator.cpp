@@ -0,0 +1,836 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * StreamingNFAGenerator.cpp
+ *
+ *
+ * Source file for the class StreamingNFAGenerator and for the sinks AutomatonBuilder and BinaryFileSink.
+ *
+ * The transitions are sampled with rejection: a random transition is drawn and it's discarded if it has already been generated.
+ * Since the space of the possible transitions (n^2 * |labels|) is much larger than the number of transitions to generate
+ * (about n * |labels| * "%transitions"), the expected number of draws for each transition is constant; therefore, the whole
+ * generation takes O(m) time. When the space is almost saturated (e.g. very small automata with a high percentage of
+ * transitions), the generation of the additional transitions stops after MAX_SAMPLING_ATTEMPTS consecutive rejections.
+ *
+ * The random numbers are generated by a Mersenne Twister seeded with rand(), so the generation is still reproducible
+ * with the seed of the configurations.
+ */
+
+#include "StreamingNFAGenerator.hpp"
+
+#include <cmath>
+#include <limits>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+#define INTRA_STRATUM_TRANSITIONS_PERCENTAGE 0.5
+#define MAX_SAMPLING_ATTEMPTS 1000
+#define FILE_CHUNK_SIZE (1 << 20)
+#define EMPTY_KEY std::numeric_limits<uint64_t>::max()
+#define EPSILON_INDEX 0
+
+namespace quicksc {
+
+	/* Class AutomatonBuilder */
+
+	/**
+	 * Constructor.
+	 * The states are named with the prefix followed by their index.
+	 */
+	AutomatonBuilder::AutomatonBuilder(string name_prefix) {
+		this->m_name_prefix = name_prefix;
+		this->m_initial_state = 0;
+	}
+
+	/**
+	 * Destructor.
+	 * If the automaton has not been taken with "getAutomaton", it's deleted.
+	 */
+	AutomatonBuilder::~AutomatonBuilder() {
+		if (this->m_automaton != NULL) {
+			delete this->m_automaton;
+		}
+	}
+
+	/**
+	 * Starts the construction of a new automaton.
+	 */
+	void AutomatonBuilder::begin(unsigned long states_count, const vector<string>& labels, unsigned long initial_state) {
+		if (this->m_automaton != NULL) {
+			delete this->m_automaton;
+		}
+		this->m_automaton = new Automaton();
+		this->m_states = vector<State*>();
+		this->m_states.reserve(states_count);
+		this->m_labels = labels;
+		this->m_initial_state = initial_state;
+	}
+
+	/**
+	 * Creates a new state and adds it to the automaton.
+	 */
+	void AutomatonBuilder::addState(unsigned long index, bool final) {
+		DEBUG_ASSERT_TRUE(index == this->m_states.size());
+		State* state = new State(this->m_name_prefix + std::to_string(index), final);
+		this->m_states.push_back(state);
+		this->m_automaton->addState(state);
+	}
+
+	/**
+	 * Connects two states of the automaton, by index.
+	 */
+	void AutomatonBuilder::addTransition(unsigned long from, uint32_t label, unsigned long to) {
+		this->m_states[from]->connectChild(this->m_labels[label], this->m_states[to]);
+	}
+
+	/**
+	 * Ends the construction, setting the initial state (and therefore computing the distances of the states).
+	 */
+	void AutomatonBuilder::end() {
+		if (this->m_initial_state < this->m_states.size()) {
+			this->m_automaton->setInitialState(this->m_states[this->m_initial_state]);
+		}
+		this->m_states.clear();
+	}
+
+	/**
+	 * Returns the built automaton.
+	 * The ownership of the automaton passes to the caller, so a following call returns NULL.
+	 */
+	Automaton* AutomatonBuilder::getAutomaton() {
+		Automaton* automaton = this->m_automaton;
+		this->m_automaton = NULL;
+		return automaton;
+	}
+
+	/* Class BinaryFileSink */
+
+	/**
+	 * Constructor.
+	 * It opens (and truncates) the file; if the file cannot be opened, an exception is thrown.
+	 */
+	BinaryFileSink::BinaryFileSink(string file_name, string name_prefix) {
+		this->m_name_prefix = name_prefix;
+		this->m_file = std::ofstream(file_name, std::ios::binary | std::ios::trunc);
+		if (!this->m_file) {
+			DEBUG_LOG_ERROR("Cannot open the file \"%s\"", file_name.c_str());
+			throw "Cannot open the file for the generated automaton";
+		}
+		this->m_states_count = 0;
+		this->m_initial_state = 0;
+		this->m_states_written = 0;
+		this->m_transitions_written = 0;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	BinaryFileSink::~BinaryFileSink() {
+		if (this->m_file.is_open()) {
+			this->m_file.close();
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Writes the buffer on the file when it's larger than a chunk, or always if forced.
+	 */
+	void BinaryFileSink::flush(bool force) {
+		if (force || this->m_writer.getBuffer().length() >= FILE_CHUNK_SIZE) {
+			this->m_file.write(this->m_writer.getBuffer().data(), this->m_writer.getBuffer().length());
+			this->m_writer.clear();
+		}
+	}
+
+	/**
+	 * Writes the header of the binary form and the table of the labels.
+	 */
+	void BinaryFileSink::begin(unsigned long states_count, const vector<string>& labels, unsigned long initial_state) {
+		if (states_count >= NO_INITIAL_STATE) {
+			DEBUG_LOG_ERROR("The binary form cannot contain %lu states", states_count);
+			throw "Too many states for the binary form of an automaton";
+		}
+		this->m_states_count = states_count;
+		this->m_initial_state = initial_state;
+		this->m_writer.writeUInt32(AUTOMATON_MAGIC_NUMBER);
+		this->m_writer.writeUInt32(AUTOMATON_FORMAT_VERSION);
+		this->m_writer.writeUInt32(labels.size());
+		for (const string& label : labels) {
+			this->m_writer.writeString(label);
+		}
+		this->m_writer.writeUInt32(states_count);
+		if (states_count == 0) {
+			this->addState(0, false);
+		}
+	}
+
+	/**
+	 * Writes a state.
+	 * After the last state, it writes the initial state and the placeholder of the number of transitions, which is
+	 * overwritten at the end.
+	 */
+	void BinaryFileSink::addState(unsigned long index, bool final) {
+		if (this->m_states_count > 0) {
+			this->m_writer.writeString(this->m_name_prefix + std::to_string(index));
+			this->m_writer.writeUInt32(final ? 1 : 0);
+			this->m_states_written++;
+		}
+		if (this->m_states_written == this->m_states_count) {
+			this->m_writer.writeUInt32(this->m_states_count > 0 ? this->m_initial_state : NO_INITIAL_STATE);
+			this->flush(true);
+			this->m_transitions_count_position = this->m_file.tellp();
+			this->m_writer.writeUInt32(0);
+		}
+		this->flush(false);
+	}
+
+	/**
+	 * Writes a transition.
+	 */
+	void BinaryFileSink::addTransition(unsigned long from, uint32_t label, unsigned long to) {
+		this->m_writer.writeUInt32(from);
+		this->m_writer.writeUInt32(label);
+		this->m_writer.writeUInt32(to);
+		this->m_transitions_written++;
+		this->flush(false);
+	}
+
+	/**
+	 * Writes the remaining content and the number of transitions, then closes the file.
+	 */
+	void BinaryFileSink::end() {
+		this->flush(true);
+		uint32_t transitions_count = this->m_transitions_written;
+		this->m_file.seekp(this->m_transitions_count_position);
+		this->m_file.write((const char*) &transitions_count, sizeof(transitions_count));
+		this->m_file.close();
+	}
+
+	/**
+	 * Returns the number of transitions written.
+	 */
+	unsigned long BinaryFileSink::getTransitionsCount() {
+		return this->m_transitions_written;
+	}
+
+	/* Class KeySet */
+
+	/**
+	 * Constructor.
+	 * The table is sized for the expected number of keys, so that it does not grow in the common case.
+	 */
+	KeySet::KeySet(unsigned long expected_size) {
+		unsigned long capacity = 16;
+		while (capacity < 2 * expected_size) {
+			capacity <<= 1;
+		}
+		this->m_table = vector<uint64_t>(capacity, EMPTY_KEY);
+		this->m_mask = capacity - 1;
+		this->m_size = 0;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	KeySet::~KeySet() {}
+
+	/**
+	 * Mixes the bits of a key, so that consecutive keys are spread over the table.
+	 */
+	inline uint64_t mixKey(uint64_t key) {
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		return key;
+	}
+
+	/**
+	 * Private method.
+	 * Doubles the size of the table, re-inserting all the keys.
+	 */
+	void KeySet::grow() {
+		vector<uint64_t> old_table = std::move(this->m_table);
+		this->m_table = vector<uint64_t>(old_table.size() * 2, EMPTY_KEY);
+		this->m_mask = this->m_table.size() - 1;
+		this->m_size = 0;
+		for (uint64_t key : old_table) {
+			if (key != EMPTY_KEY) {
+				this->insert(key);
+			}
+		}
+	}
+
+	/**
+	 * Inserts a key in the set.
+	 * Returns true if the key was not already contained.
+	 */
+	bool KeySet::insert(uint64_t key) {
+		if (2 * (this->m_size + 1) > this->m_table.size()) {
+			this->grow();
+		}
+		uint64_t position = mixKey(key) & this->m_mask;
+		while (this->m_table[position] != EMPTY_KEY) {
+			if (this->m_table[position] == key) {
+				return false;
+			}
+			position = (position + 1) & this->m_mask;
+		}
+		this->m_table[position] = key;
+		this->m_size++;
+		return true;
+	}
+
+	/**
+	 * Returns true if the key is contained in the set.
+	 */
+	bool KeySet::contains(uint64_t key) {
+		uint64_t position = mixKey(key) & this->m_mask;
+		while (this->m_table[position] != EMPTY_KEY) {
+			if (this->m_table[position] == key) {
+				return true;
+			}
+			position = (position + 1) & this->m_mask;
+		}
+		return false;
+	}
+
+	/**
+	 * Returns the number of keys in the set.
+	 */
+	unsigned long KeySet::size() {
+		return this->m_size;
+	}
+
+	/* Class StreamingNFAGenerator */
+
+	/**
+	 * Constructor.
+	 */
+	StreamingNFAGenerator::StreamingNFAGenerator(Alphabet alphabet, Configurations* configurations) : AutomataGenerator(alphabet, configurations) {
+		this->m_states_count = 0;
+		this->m_labels_count = 0;
+		this->m_epsilon_probability = this->getEpsilonProbability();
+	}
+
+	/**
+	 * Destructor.
+	 */
+	StreamingNFAGenerator::~StreamingNFAGenerator() {}
+
+	/**
+	 * Private method.
+	 * Returns a random index in the range [0, bound).
+	 */
+	unsigned long StreamingNFAGenerator::randomIndex(unsigned long bound) {
+		return this->m_random() % bound;
+	}
+
+	/**
+	 * Private method.
+	 * Returns the index of a random symbol of the alphabet (never EPSILON).
+	 */
+	uint32_t StreamingNFAGenerator::randomSymbol() {
+		return 1 + this->randomIndex(this->m_labels_count - 1);
+	}
+
+	/**
+	 * Private method.
+	 * Returns the index of a random label, which is EPSILON with the probability specified by "EpsilonProbability".
+	 * The symbols are drawn with the frequency distribution of the configurations, when the labels are those of the alphabet
+	 * (i.e. not for Maslov automata); the deterministic parts, instead, draw their symbols uniformly with "randomSymbol".
+	 */
+	uint32_t StreamingNFAGenerator::randomLabel() {
+		double random_percentage = (this->m_random() >> 11) * 0x1.0p-53;
+		if (random_percentage < this->m_epsilon_probability) {
+			return EPSILON_INDEX;
+		}
+		if (this->m_symbol_sampler.isUniform() || this->m_symbol_sampler.size() != this->m_labels_count - 1) {
+			return this->randomSymbol();
+		}
+		uint32_t column = this->randomIndex(this->m_labels_count - 1);
+		double coin = (this->m_random() >> 11) * 0x1.0p-53;
+		return 1 + this->m_symbol_sampler.sample(column, coin);
+	}
+
+	/**
+	 * Private method.
+	 * Returns the unique key of a transition.
+	 */
+	uint64_t StreamingNFAGenerator::transitionKey(unsigned long from, uint32_t label, unsigned long to) {
+		return ((uint64_t) from * this->m_labels_count + label) * this->m_states_count + to;
+	}
+
+	/**
+	 * Private method.
+	 * Returns the unique key of a pair (state, label), used to keep track of the labels exiting from a deterministic state.
+	 */
+	uint64_t StreamingNFAGenerator::pairKey(unsigned long from, uint32_t label) {
+		return (uint64_t) from * this->m_labels_count + label;
+	}
+
+	/**
+	 * Private method.
+	 * Sends the transition to the sink, only if it has not been generated yet.
+	 * Returns true if the transition is new.
+	 */
+	bool StreamingNFAGenerator::emitTransition(TransitionSink& sink, KeySet& transitions, unsigned long from, uint32_t label, unsigned long to) {
+		if (!transitions.insert(this->transitionKey(from, label, to))) {
+			return false;
+		}
+		sink.addTransition(from, label, to);
+		return true;
+	}
+
+	/**
+	 * Private method.
+	 * Initializes the generation of a new automaton: it seeds the random generator, sends the table of the labels to the sink
+	 * and generates the states, with at least one final state. The initial state is always the state of index 0.
+	 */
+	void StreamingNFAGenerator::beginGeneration(TransitionSink& sink, const vector<string>& labels) {
+		this->m_random.seed(rand());
+		this->m_states_count = this->getSize();
+		this->m_labels_count = labels.size();
+
+		if (this->m_states_count == 0) {
+			DEBUG_LOG_ERROR("Cannot generate an automaton without states");
+			throw "Cannot generate an automaton without states";
+		}
+		// The keys of the transitions must fit in 64 bits
+		if ((double) this->m_states_count * this->m_states_count * this->m_labels_count >= (double) EMPTY_KEY) {
+			DEBUG_LOG_ERROR("Cannot generate an automaton with %lu states and %u labels", this->m_states_count, this->m_labels_count);
+			throw "Too many states and labels for the streaming generator";
+		}
+
+		sink.begin(this->m_states_count, labels, 0);
+
+		double final_probability = this->getFinalProbability();
+		vector<bool> final_flags = vector<bool>(this->m_states_count, false);
+		bool has_final_states = false;
+		for (unsigned long s = 0; s < this->m_states_count; s++) {
+			final_flags[s] = (this->generateNormalizedDouble() < final_probability);
+			has_final_states |= final_flags[s];
+		}
+		if (!has_final_states) {
+			final_flags[this->randomIndex(this->m_states_count)] = true;
+		}
+		for (unsigned long s = 0; s < this->m_states_count; s++) {
+			sink.addState(s, final_flags[s]);
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Returns the number of transitions to generate, as the NFAGenerator does.
+	 */
+	unsigned long StreamingNFAGenerator::computeTransitionsNumber() {
+		return this->computeDeterministicTransitionsNumber();
+	}
+
+	/**
+	 * Private method.
+	 * Subdivides the indices of the states in strata, with the same procedure of the NFAGenerator: each stratum of distance "d"
+	 * contains at most |alphabet|^d states, and the states are distributed in round-robin over the strata not yet full.
+	 * It checks that the number of states is compatible with the maximum distance; otherwise, it throws an exception.
+	 */
+	vector<vector<unsigned long>> StreamingNFAGenerator::computeStrata() {
+		if (this->getMaxDistance() == (unsigned int) UNDEFINED_VALUE) {
+			this->setMaxDistance(this->getSize() - 1);
+		}
+		unsigned int max_distance = this->getMaxDistance();
+		double log_alphabet = log(this->m_labels_count - 1);
+
+		if (this->getSize() <= max_distance) {
+			DEBUG_LOG_ERROR("Cannot generate an automaton with %lu states and maximum distance %u", this->getSize(), max_distance);
+			throw "Cannot generate a NFA with a maximum distance greater than the number of states";
+		} else if ((max_distance + 1) * log_alphabet < log(this->getSize() * (this->m_labels_count - 2) + 1)) {
+			DEBUG_LOG_ERROR("Cannot generate an automaton with %lu states and maximum distance %u: too many states", this->getSize(), max_distance);
+			throw "Cannot generate a NFA with too many states to be deterministically placed within the maximum distance";
+		}
+
+		vector<vector<unsigned long>> strata = vector<vector<unsigned long>>(max_distance + 1);
+		unsigned int stratum_starting_index = 0;
+		unsigned int stratum_index = 0;
+		for (unsigned long s = 0; s < this->m_states_count; s++) {
+			strata[stratum_index].push_back(s);
+			if (log(strata[stratum_index].size()) >= stratum_index * log_alphabet) {
+				stratum_starting_index++;
+			}
+			stratum_index++;
+			if (stratum_index >= strata.size()) {
+				stratum_index = (stratum_starting_index < strata.size()) ? stratum_starting_index : strata.size() - 1;
+			}
+		}
+		return strata;
+	}
+
+	/**
+	 * Private method.
+	 * Streams a completely random automaton, with the same semantics of NFAGenerator::generateRandomAutomaton.
+	 */
+	void StreamingNFAGenerator::streamRandomAutomaton(TransitionSink& sink) {
+		unsigned long n = this->m_states_count;
+		unsigned long transitions_number = this->computeTransitionsNumber();
+		KeySet transitions = KeySet(transitions_number);
+
+		// Satisfaction of the REACHABILITY property: each state is reached from a previous one
+		for (unsigned long i = 1; i < n; i++) {
+			this->emitTransition(sink, transitions, this->randomIndex(i), this->randomLabel(), i);
+		}
+
+		// Satisfaction of the NUMBER OF TRANSITIONS property, without repetitions
+		unsigned long transitions_created = n - 1;
+		unsigned int failures = 0;
+		while (n > 1 && transitions_created < transitions_number && failures < MAX_SAMPLING_ATTEMPTS) {
+			unsigned long from = 1 + this->randomIndex(n - 1);
+			unsigned long to = 1 + this->randomIndex(n - 1);
+			if (this->emitTransition(sink, transitions, from, this->randomLabel(), to)) {
+				transitions_created++;
+				failures = 0;
+			} else {
+				failures++;
+			}
+		}
+		DEBUG_LOG("Generated %lu transitions over %lu requested", transitions_created, transitions_number);
+	}
+
+	/**
+	 * Private method.
+	 * Streams a stratified automaton, with the same semantics of NFAGenerator::generateStratifiedAutomaton.
+	 * If required, the states within the safe zone have only deterministic exiting transitions, as in
+	 * NFAGenerator::generateStratifiedWithSafeZoneAutomaton.
+	 */
+	void StreamingNFAGenerator::streamStratifiedAutomaton(TransitionSink& sink, bool with_safe_zone) {
+		vector<vector<unsigned long>> strata = this->computeStrata();
+		unsigned int max_distance = strata.size() - 1;
+		unsigned int safe_zone_distance = with_safe_zone ? this->getSafeZoneDistance() : 0;
+
+		// Stratum of each state, and list of the states within the safe zone (i.e. with distance less than the safe-zone distance)
+		vector<unsigned int> stratum_of = vector<unsigned int>(this->m_states_count);
+		vector<unsigned long> safe_states;
+		for (unsigned int d = 0; d <= max_distance; d++) {
+			for (unsigned long s : strata[d]) {
+				stratum_of[s] = d;
+				if (d < safe_zone_distance) {
+					safe_states.push_back(s);
+				}
+			}
+		}
+
+		unsigned long transitions_number = this->computeTransitionsNumber();
+		KeySet transitions = KeySet(transitions_number);
+		KeySet used_pairs = KeySet(with_safe_zone ? safe_states.size() : 0);
+
+		// Satisfaction of the REACHABILITY property: each state is reached from the previous stratum
+		for (unsigned int d = 1; d <= max_distance; d++) {
+			for (unsigned long state : strata[d]) {
+				unsigned long parent;
+				uint32_t label;
+				if (d - 1 < safe_zone_distance) {
+					// The parent is in the safe zone: the label must not be already used by the parent
+					do {
+						parent = strata[d - 1][this->randomIndex(strata[d - 1].size())];
+						label = this->randomSymbol();
+					} while (!used_pairs.insert(this->pairKey(parent, label)));
+				} else {
+					parent = strata[d - 1][this->randomIndex(strata[d - 1].size())];
+					label = this->randomLabel();
+				}
+				this->emitTransition(sink, transitions, parent, label, state);
+			}
+		}
+
+		// Satisfaction of the TRANSITION PERCENTAGE, without repetitions
+		unsigned long transitions_created = this->m_states_count - 1;
+		unsigned int failures = 0;
+		while (transitions_created < transitions_number && failures < MAX_SAMPLING_ATTEMPTS) {
+			unsigned int stratum_index = this->randomIndex(max_distance + 1);
+			unsigned long from;
+			uint32_t label;
+
+			if (stratum_index < safe_zone_distance) {
+				// CASE 1: the origin is within the safe zone, the determinism must be guaranteed
+				from = safe_states[this->randomIndex(safe_states.size())];
+				label = this->randomSymbol();
+				if (used_pairs.contains(this->pairKey(from, label))) {
+					failures++;
+					continue;
+				}
+				stratum_index = stratum_of[from];
+			} else {
+				// CASE 2: the origin is outside the safe zone, any label (even EPSILON) can be used
+				from = strata[stratum_index][this->randomIndex(strata[stratum_index].size())];
+				label = this->randomLabel();
+			}
+
+			unsigned int to_distance = (this->generateNormalizedDouble() <= INTRA_STRATUM_TRANSITIONS_PERCENTAGE) ? stratum_index : stratum_index + 1;
+			if (to_distance > max_distance) {
+				to_distance = max_distance;
+			}
+			unsigned long to = strata[to_distance][this->randomIndex(strata[to_distance].size())];
+
+			if (this->emitTransition(sink, transitions, from, label, to)) {
+				if (stratum_index < safe_zone_distance) {
+					used_pairs.insert(this->pairKey(from, label));
+				}
+				transitions_created++;
+				failures = 0;
+			} else {
+				failures++;
+			}
+		}
+		DEBUG_LOG("Generated %lu transitions over %lu requested", transitions_created, transitions_number);
+	}
+
+	/**
+	 * Private method.
+	 * Streams an acyclic automaton, with the same semantics of NFAGenerator::generateAcyclicAutomaton.
+	 * Every transition goes from a state to a state of greater index; differently from the NFAGenerator, self-loops are never generated.
+	 */
+	void StreamingNFAGenerator::streamAcyclicAutomaton(TransitionSink& sink) {
+		unsigned long n = this->m_states_count;
+		unsigned long transitions_number = this->computeTransitionsNumber();
+		KeySet transitions = KeySet(transitions_number);
+
+		for (unsigned long i = 1; i < n; i++) {
+			this->emitTransition(sink, transitions, this->randomIndex(i), this->randomLabel(), i);
+		}
+
+		unsigned long transitions_created = n - 1;
+		unsigned int failures = 0;
+		while (n > 2 && transitions_created < transitions_number && failures < MAX_SAMPLING_ATTEMPTS) {
+			unsigned long index_1 = 1 + this->randomIndex(n - 1);
+			unsigned long index_2 = 1 + this->randomIndex(n - 1);
+			if (index_1 == index_2) {
+				failures++;
+				continue;
+			}
+			unsigned long from = (index_1 < index_2) ? index_1 : index_2;
+			unsigned long to = (index_1 < index_2) ? index_2 : index_1;
+			if (this->emitTransition(sink, transitions, from, this->randomLabel(), to)) {
+				transitions_created++;
+				failures = 0;
+			} else {
+				failures++;
+			}
+		}
+		DEBUG_LOG("Generated %lu transitions over %lu requested", transitions_created, transitions_number);
+	}
+
+	/**
+	 * Private method.
+	 * Streams a "weak" automaton, with the same semantics of NFAGenerator::generateWeakAutomaton:
+	 * a random DFA is generated, then a single epsilon-transition or non-deterministic transition is added.
+	 */
+	void StreamingNFAGenerator::streamWeakAutomaton(TransitionSink& sink) {
+		unsigned long n = this->m_states_count;
+		uint32_t symbols_count = this->m_labels_count - 1;
+		unsigned long transitions_number = this->computeTransitionsNumber();
+		if (transitions_number > n * symbols_count) {
+			transitions_number = n * symbols_count;
+		}
+		KeySet transitions = KeySet(transitions_number + 1);
+		KeySet used_pairs = KeySet(transitions_number);
+
+		// Covering tree: each state is reached from a previous one, with a label not yet used by the parent
+		for (unsigned long i = 1; i < n; i++) {
+			unsigned long parent;
+			uint32_t label;
+			do {
+				parent = this->randomIndex(i);
+				label = this->randomSymbol();
+			} while (!used_pairs.insert(this->pairKey(parent, label)));
+			this->emitTransition(sink, transitions, parent, label, i);
+		}
+
+		// Additional deterministic transitions
+		unsigned long transitions_created = n - 1;
+		unsigned int failures = 0;
+		while (transitions_created < transitions_number && failures < MAX_SAMPLING_ATTEMPTS) {
+			unsigned long from = this->randomIndex(n);
+			uint32_t label = this->randomSymbol();
+			if (used_pairs.insert(this->pairKey(from, label))) {
+				this->emitTransition(sink, transitions, from, label, this->randomIndex(n));
+				transitions_created++;
+				failures = 0;
+			} else {
+				failures++;
+			}
+		}
+
+		// Doping: a single epsilon-transition or non-deterministic transition
+		if (n < 2) {
+			return;
+		}
+		if (this->generateNormalizedDouble() <= this->m_epsilon_probability) {
+			unsigned long s1 = this->randomIndex(n);
+			unsigned long s2;
+			do {
+				s2 = this->randomIndex(n);
+			} while (s1 == s2);
+			this->emitTransition(sink, transitions, s1, EPSILON_INDEX, s2);
+		} else {
+			for (unsigned int attempt = 0; attempt < MAX_SAMPLING_ATTEMPTS * symbols_count; attempt++) {
+				// A label already used by the origin state is chosen, then a new destination
+				unsigned long s1 = this->randomIndex(n);
+				uint32_t label = this->randomSymbol();
+				if (used_pairs.contains(this->pairKey(s1, label)) && this->emitTransition(sink, transitions, s1, label, this->randomIndex(n))) {
+					break;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Private method.
+	 * Streams an automaton with the Maslov topology, with the same semantics of NFAGenerator::generateMaslovAutomaton.
+	 * The labels are always "a" and "b", independently of the alphabet.
+	 */
+	void StreamingNFAGenerator::streamMaslovAutomaton(TransitionSink& sink) {
+		unsigned long n = this->m_states_count;
+		const uint32_t a = 1, b = 2;
+		if (n < 2) {
+			DEBUG_LOG_ERROR("Cannot generate a Maslov automaton with %lu states", n);
+			throw "Cannot generate a Maslov automaton with less than two states";
+		}
+		KeySet transitions = KeySet(2 * n + 1);
+		for (unsigned long i = 1; i < n - 1; i++) {
+			this->emitTransition(sink, transitions, i, a, i + 1);
+			this->emitTransition(sink, transitions, i, b, i + 1);
+		}
+		this->emitTransition(sink, transitions, 0, a, 0);
+		this->emitTransition(sink, transitions, 0, b, 0);
+		this->emitTransition(sink, transitions, 0, a, 1);
+	}
+
+	/**
+	 * Static method.
+	 * Returns true if the streaming generator can generate automata of the structure.
+	 */
+	bool StreamingNFAGenerator::supportsStructure(AutomatonType type) {
+		switch (type) {
+		case AUTOMATON_RANDOM :
+		case AUTOMATON_STRATIFIED :
+		case AUTOMATON_STRATIFIED_WITH_SAFE_ZONE :
+		case AUTOMATON_ACYCLIC :
+		case AUTOMATON_WEAK :
+		case AUTOMATON_MASLOV :
+			return true;
+		default :
+			return false;
+		}
+	}
+
+	/**
+	 * Generates an automaton with the structure specified in the configurations, sending it to the sink.
+	 */
+	void StreamingNFAGenerator::generate(TransitionSink& sink) {
+		this->generate(sink, this->getAutomatonStructure());
+	}
+
+	/**
+	 * Generates an automaton of the requested structure, sending it to the sink.
+	 */
+	void StreamingNFAGenerator::generate(TransitionSink& sink, AutomatonType type) {
+		vector<string> labels;
+		labels.push_back(EPSILON);
+		if (type == AUTOMATON_MASLOV) {
+			labels.push_back("a");
+			labels.push_back("b");
+		} else {
+			const Alphabet& alphabet = this->getAlphabet();
+			labels.insert(labels.end(), alphabet.begin(), alphabet.end());
+		}
+		if (labels.size() < 2) {
+			DEBUG_LOG_ERROR("Cannot generate an automaton with an empty alphabet");
+			throw "Cannot generate an automaton with an empty alphabet";
+		}
+
+		this->beginGeneration(sink, labels);
+		switch (type) {
+
+		case AUTOMATON_RANDOM :
+			this->streamRandomAutomaton(sink);
+			break;
+
+		case AUTOMATON_STRATIFIED :
+			this->streamStratifiedAutomaton(sink, false);
+			break;
+
+		case AUTOMATON_STRATIFIED_WITH_SAFE_ZONE :
+			this->streamStratifiedAutomaton(sink, true);
+			break;
+
+		case AUTOMATON_ACYCLIC :
+			this->streamAcyclicAutomaton(sink);
+			break;
+
+		case AUTOMATON_WEAK :
+			this->streamWeakAutomaton(sink);
+			break;
+
+		case AUTOMATON_MASLOV :
+			this->streamMaslovAutomaton(sink);
+			break;
+
+		default :
+			DEBUG_LOG_ERROR("Cannot parse the value %d as an element of the enumeration AutomatonType", type);
+			throw "Unknown value for the AutomatonType enumeration";
+		}
+		sink.end();
+	}
+
+	/**
+	 * Private method.
+	 * Generates an automaton of the requested structure as an Automaton object.
+	 */
+	Automaton* StreamingNFAGenerator::buildAutomaton(AutomatonType type) {
+		AutomatonBuilder builder = AutomatonBuilder(this->getNamePrefix());
+		this->generate(builder, type);
+		return builder.getAutomaton();
+	}
+
+	/**
+	 * Generates a completely random automaton.
+	 */
+	Automaton* StreamingNFAGenerator::generateRandomAutomaton() {
+		return this->buildAutomaton(AUTOMATON_RANDOM);
+	}
+
+	/**
+	 * Generates a stratified automaton.
+	 */
+	Automaton* StreamingNFAGenerator::generateStratifiedAutomaton() {
+		return this->buildAutomaton(AUTOMATON_STRATIFIED);
+	}
+
+	/**
+	 * Generates a stratified automaton, deterministic within the safe zone.
+	 */
+	Automaton* StreamingNFAGenerator::generateStratifiedWithSafeZoneAutomaton() {
+		return this->buildAutomaton(AUTOMATON_STRATIFIED_WITH_SAFE_ZONE);
+	}
+
+	/**
+	 * Generates an acyclic automaton.
+	 */
+	Automaton* StreamingNFAGenerator::generateAcyclicAutomaton() {
+		return this->buildAutomaton(AUTOMATON_ACYCLIC);
+	}
+
+	/**
+	 * Generates a DFA with a single point of non-determinism.
+	 */
+	Automaton* StreamingNFAGenerator::generateWeakAutomaton() {
+		return this->buildAutomaton(AUTOMATON_WEAK);
+	}
+
+	/**
+	 * Generates an automaton with the Maslov topology.
+	 */
+	Automaton* StreamingNFAGenerator::generateMaslovAutomaton() {
+		return this->buildAutomaton(AUTOMATON_MASLOV);
+	}
+
+} /* namespace quicksc */
@@ -15,8 +15,10 @@
 #include <queue>
 
 #include "Debug.hpp"
+#include "ProductAutomaton.hpp"
 #include "Properties.hpp"
 #include "State.hpp"
+#include "Trace.hpp"
 
 namespace quicksc {
 
@@ -35,14 +37,37 @@ namespace quicksc {
 	 * It runs the algorithm on the NFA passed as parameter.
 	 */
 	Automaton* SubsetConstruction::run(Automaton* nfa) {
+		TRACE_SPAN("SC");
+		State* nfa_initial_state = nfa->getInitialState();
+		DEBUG_ASSERT_NOT_NULL(nfa_initial_state);
+		return this->construct(nfa_initial_state, NULL);
+	}
+
+	/**
+	 * Returns the DFA obtained by the Subset Construction algorithm, run on a product of automata.
+	 * The product is built on the fly, while the algorithm explores it: only the pairs of states actually
+	 * reached by the l-closures are created.
+	 */
+	Automaton* SubsetConstruction::run(ProductAutomaton* product) {
+		TRACE_SPAN("SC");
+		return this->construct(product->getInitialState(), product);
+	}
+
+	/**
+	 * Private method.
+	 * Builds the DFA starting from the initial state of the NFA.
+	 * If a product is passed as parameter, the closures are computed by the product, which expands
+	 * its states when they're reached; otherwise, the transitions of the NFA are read directly.
+	 */
+	Automaton* SubsetConstruction::construct(State* nfa_initial_state, ProductAutomaton* product) {
 		Automaton* dfa = new Automaton();
 
         // Create the initial state of the DFA
 		Extension initial_dfa_extension;
-		State* nfa_initial_state = nfa->getInitialState();
-		DEBUG_ASSERT_NOT_NULL(nfa_initial_state);
 		initial_dfa_extension.insert(nfa_initial_state);
-		Extension epsilon_closure = ConstructedState::computeEpsilonClosure(initial_dfa_extension);
+		Extension epsilon_closure = (product == NULL)
+				? ConstructedState::computeEpsilonClosure(initial_dfa_extension)
+				: product->computeEpsilonClosure(initial_dfa_extension);
 		ConstructedState * initial_dfa_state = new ConstructedState(epsilon_closure);
 
 		// Adding the initial state to the DFA
@@ -61,6 +86,13 @@ namespace quicksc {
         	ConstructedState* current_state = singularities_stack.front();			// Obtain the extracted state
             singularities_stack.pop();								// Remove the extracted state from the stack
 
+            // The states of a product have transitions only once expanded
+            if (product != NULL) {
+            	for (State* s : current_state->getExtension()) {
+            		product->expand(s);
+            	}
+            }
+
 			// For all the labels that mark outgoing transitions from this state
             for (string l : current_state->getLabelsExitingFromExtension()) {
 				// We skip the epsilon-transitions
@@ -69,7 +101,9 @@ namespace quicksc {
             	}
 
 				// We compute the l-closure of the state and create a new DFA state
-            	Extension l_closure = current_state->computeLClosureOfExtension(l);
+            	Extension l_closure = (product == NULL)
+            			? current_state->computeLClosureOfExtension(l)
+            			: product->computeLClosure(current_state->getExtension(), l);
             	ConstructedState* new_state = new ConstructedState(l_closure);
             	DEBUG_LOG("From state %s, with label %s, the state %s has been created",
             			current_state->getName().c_str(),
@@ -108,6 +142,8 @@ namespace quicksc {
         // Set the initial state of the DFA
 		// This procedure sets the distances from the initial state to all the other states, automatically
         dfa->setInitialState(initial_dfa_state);
+        TRACE_COUNTER("SC states", dfa->size());
+        this->collectOperationCounts();
 
         return dfa;
 	}
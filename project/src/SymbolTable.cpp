@@ -0,0 +1,190 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * SymbolTable.cpp
+ *
+ *
+ * This source file contains the implementation of the classes SymbolTable and SymbolSampler.
+ */
+
+#include "SymbolTable.hpp"
+
+#include <cmath>
+#include <cstring>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+using std::string;
+using std::vector;
+
+namespace quicksc {
+
+	/* Class SymbolTable */
+
+	/**
+	 * Constructor.
+	 * The letters are passed as an array of char terminated by '\0', and they must be all different.
+	 */
+	SymbolTable::SymbolTable(uint32_t cardinality, const char* letters) {
+		if (letters == NULL || strlen(letters) == 0) {
+			DEBUG_LOG_ERROR("Cannot build a table of symbols without letters");
+			throw "Cannot build a table of symbols without letters";
+		}
+		this->m_letters = string(letters);
+		this->m_cardinality = cardinality;
+	}
+
+	/**
+	 * Destructor.
+	 */
+	SymbolTable::~SymbolTable() {}
+
+	/**
+	 * Returns the number of symbols of the table.
+	 */
+	uint32_t SymbolTable::size() {
+		return this->m_cardinality;
+	}
+
+	/**
+	 * Returns the string form of the symbol with the given ID.
+	 * The ID is written in bijective numeration with base equal to the number of letters, i.e. without the zero digit:
+	 * with the letters "ab", the IDs 0, 1, 2, 3, 4, ... correspond to the symbols "a", "b", "aa", "ab", "ba", ...
+	 */
+	string SymbolTable::nameOf(uint32_t id) {
+		if (id >= this->m_cardinality) {
+			DEBUG_LOG_ERROR("The ID %u is not in the table of %u symbols", id, this->m_cardinality);
+			throw "The ID of the symbol is out of the table";
+		}
+		uint64_t base = this->m_letters.length();
+		uint64_t value = (uint64_t) id + 1;
+		string name = string();
+		while (value > 0) {
+			value--;
+			name.push_back(this->m_letters[value % base]);
+			value /= base;
+		}
+		return string(name.rbegin(), name.rend());
+	}
+
+	/**
+	 * Returns the ID of the symbol with the given string form.
+	 * If the string is not a symbol of the table, the constant SYMBOL_NOT_FOUND is returned.
+	 */
+	uint32_t SymbolTable::idOf(const string& name) {
+		if (name.empty()) {
+			return SYMBOL_NOT_FOUND;
+		}
+		uint64_t base = this->m_letters.length();
+		uint64_t value = 0;
+		for (char c : name) {
+			size_t digit = this->m_letters.find(c);
+			if (digit == string::npos) {
+				return SYMBOL_NOT_FOUND;
+			}
+			value = value * base + digit + 1;
+			if (value > this->m_cardinality) {
+				return SYMBOL_NOT_FOUND;
+			}
+		}
+		return (uint32_t) (value - 1);
+	}
+
+	/**
+	 * Returns the alphabet containing the string forms of all the symbols, ordered by ID.
+	 */
+	Alphabet SymbolTable::toAlphabet() {
+		Alphabet alphabet = Alphabet();
+		alphabet.reserve(this->m_cardinality);
+		for (uint32_t id = 0; id < this->m_cardinality; id++) {
+			alphabet.push_back(this->nameOf(id));
+		}
+		return alphabet;
+	}
+
+	/* Class SymbolSampler */
+
+	/**
+	 * Constructor.
+	 * It builds the alias table of the Zipf distribution with the given exponent over "cardinality" symbols.
+	 * If the exponent is zero (or negative) the table is not built, since the sampling is uniform.
+	 */
+	SymbolSampler::SymbolSampler(uint32_t cardinality, double zipf_exponent) {
+		this->m_cardinality = cardinality;
+		this->m_exponent = (zipf_exponent > 0) ? zipf_exponent : 0;
+		if (this->isUniform() || cardinality == 0) {
+			return;
+		}
+
+		// Weights scaled so that their average is 1
+		vector<double> scaled = vector<double>(cardinality);
+		double total = 0;
+		for (uint32_t i = 0; i < cardinality; i++) {
+			scaled[i] = pow(i + 1, - this->m_exponent);
+			total += scaled[i];
+		}
+		for (uint32_t i = 0; i < cardinality; i++) {
+			scaled[i] *= cardinality / total;
+		}
+
+		// Vose's method: the columns with less than the average are filled with the mass of a column with more
+		this->m_probabilities = vector<double>(cardinality, 1.0);
+		this->m_aliases = vector<uint32_t>(cardinality);
+		vector<uint32_t> small = vector<uint32_t>();
+		vector<uint32_t> large = vector<uint32_t>();
+		for (uint32_t i = 0; i < cardinality; i++) {
+			this->m_aliases[i] = i;
+			if (scaled[i] < 1.0) {
+				small.push_back(i);
+			} else {
+				large.push_back(i);
+			}
+		}
+		while (!small.empty() && !large.empty()) {
+			uint32_t less = small.back();
+			small.pop_back();
+			uint32_t more = large.back();
+			this->m_probabilities[less] = scaled[less];
+			this->m_aliases[less] = more;
+			scaled[more] -= (1.0 - scaled[less]);
+			if (scaled[more] < 1.0) {
+				large.pop_back();
+				small.push_back(more);
+			}
+		}
+		// The remaining columns (because of rounding errors) are kept entirely
+	}
+
+	/**
+	 * Destructor.
+	 */
+	SymbolSampler::~SymbolSampler() {}
+
+	/**
+	 * Returns true if the sampling is uniform, i.e. if the column drawn is always the sampled symbol.
+	 */
+	bool SymbolSampler::isUniform() {
+		return this->m_exponent == 0;
+	}
+
+	/**
+	 * Returns the number of symbols of the distribution.
+	 */
+	uint32_t SymbolSampler::size() {
+		return this->m_cardinality;
+	}
+
+	/**
+	 * Returns the ID of a symbol, given a column drawn uniformly in [0, size) and a coin drawn uniformly in [0, 1).
+	 * The two random values are passed by the caller, so that the sampler can be used with any random generator.
+	 */
+	uint32_t SymbolSampler::sample(uint32_t column, double coin) {
+		if (this->isUniform()) {
+			return column;
+		}
+		return (coin < this->m_probabilities[column]) ? column : this->m_aliases[column];
+	}
+
+} /* namespace quicksc */
@@ -0,0 +1,268 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * Trace.cpp
+ *
+ *
+ * This source file contains the implementation of the tracing layer: the per-thread buffers and the export of the events.
+ *
+ * A buffer is written only by its thread, which publishes the number of recorded events with an atomic counter;
+ * the exporting thread reads only the published events, so the two never need a lock. The chunks of a buffer are
+ * never moved nor freed, and the buffers are kept until the end of the process, so that the events of the
+ * terminated threads (e.g. the generators of the pipeline) can still be exported.
+ */
+
+#include "Trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+#define TRACE_CHUNK_CAPACITY		4096
+
+namespace quicksc {
+
+	/**
+	 * Fixed-size block of events of a buffer.
+	 */
+	struct TraceChunk {
+		TraceEvent events[TRACE_CHUNK_CAPACITY];
+		std::atomic<TraceChunk*> next;
+	};
+
+	/**
+	 * Buffer of the events recorded by a single thread.
+	 */
+	struct TraceBuffer {
+		unsigned int thread_id;				// Sequential identifier of the thread, in order of registration
+		bool main_thread;
+		const char* label;					// Name of the track, if it doesn't belong to a thread (NULL otherwise)
+		TraceChunk* head;
+		TraceChunk* tail;					// Chunk currently written by the thread
+		unsigned int tail_size;				// Number of events in the tail chunk
+		std::atomic<unsigned long> count;	// Number of events published to the exporter
+	};
+
+	/** Instant of the start of the tracing; all the timestamps are relative to it */
+	static const std::chrono::steady_clock::time_point trace_epoch = std::chrono::steady_clock::now();
+
+	/** Identifier of the main thread, which is the one initializing the static variables */
+	static const std::thread::id main_thread_id = std::this_thread::get_id();
+
+	/** All the buffers created so far, protected by the mutex (which is used only at the registration and at the export) */
+	static std::vector<TraceBuffer*> trace_buffers;
+	static std::mutex trace_buffers_mutex;
+
+	/** Buffer of the current thread, created at its first event */
+	static thread_local TraceBuffer* thread_buffer = NULL;
+
+	/** Buffer of the events imported from other processes, created at the first import, and the names of those events */
+	static TraceBuffer* imported_buffer = NULL;
+	static std::set<std::string> imported_names;
+
+	/**
+	 * Creates and registers a new buffer.
+	 */
+	static TraceBuffer* createBuffer(bool main_thread, const char* label) {
+		TraceBuffer* buffer = new TraceBuffer();
+		buffer->head = new TraceChunk();
+		buffer->head->next.store(NULL);
+		buffer->tail = buffer->head;
+		buffer->tail_size = 0;
+		buffer->count.store(0);
+		buffer->main_thread = main_thread;
+		buffer->label = label;
+		std::lock_guard<std::mutex> lock(trace_buffers_mutex);
+		buffer->thread_id = trace_buffers.size();
+		trace_buffers.push_back(buffer);
+		return buffer;
+	}
+
+	/**
+	 * Returns the buffer of the current thread, creating and registering it if it doesn't exist yet.
+	 */
+	static TraceBuffer* getThreadBuffer() {
+		if (thread_buffer == NULL) {
+			thread_buffer = createBuffer(std::this_thread::get_id() == main_thread_id, NULL);
+		}
+		return thread_buffer;
+	}
+
+	/**
+	 * Appends an event to a buffer, then publishes it.
+	 * A buffer is written by a single thread: its own thread, or the main thread for the imported events.
+	 */
+	static void appendEvent(TraceBuffer* buffer, const TraceEvent& event) {
+		if (buffer->tail_size == TRACE_CHUNK_CAPACITY) {
+			TraceChunk* chunk = buffer->tail->next.load(std::memory_order_relaxed);
+			if (chunk == NULL) {
+				chunk = new TraceChunk();
+				chunk->next.store(NULL);
+				buffer->tail->next.store(chunk, std::memory_order_release);
+			}
+			buffer->tail = chunk;
+			buffer->tail_size = 0;
+		}
+		buffer->tail->events[buffer->tail_size] = event;
+		buffer->tail_size++;
+		buffer->count.store(buffer->count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Appends an event to the buffer of the current thread, then publishes it.
+	 */
+	static void recordEvent(const TraceEvent& event) {
+		appendEvent(getThreadBuffer(), event);
+	}
+
+	/**
+	 * Returns the number of nanoseconds elapsed from the start of the tracing.
+	 */
+	uint64_t Tracer::now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - trace_epoch).count();
+	}
+
+	/**
+	 * Records a span of the current thread, with its start and end instants.
+	 */
+	void Tracer::recordSpan(const char* name, uint64_t start, uint64_t end) {
+		recordEvent({ name, 'X', start, end - start, 0 });
+	}
+
+	/**
+	 * Records the value of a counter at the current instant.
+	 */
+	void Tracer::recordCounter(const char* name, double value) {
+		recordEvent({ name, 'C', Tracer::now(), 0, value });
+	}
+
+	/**
+	 * Discards all the events recorded so far, keeping the chunks for the next ones.
+	 * It's used by a forked child process, which inherits the events of the parent.
+	 * It must be called when no other thread is recording.
+	 */
+	void Tracer::reset() {
+		std::lock_guard<std::mutex> lock(trace_buffers_mutex);
+		for (TraceBuffer* buffer : trace_buffers) {
+			buffer->tail = buffer->head;
+			buffer->tail_size = 0;
+			buffer->count.store(0);
+		}
+	}
+
+	/**
+	 * Returns a copy of all the published events of all the threads.
+	 * It's used by a forked child process to send its events to the parent, which imports them with "importEvents".
+	 */
+	std::vector<TraceEvent> Tracer::getEvents() {
+		std::vector<TraceEvent> events;
+		std::lock_guard<std::mutex> lock(trace_buffers_mutex);
+		for (TraceBuffer* buffer : trace_buffers) {
+			unsigned long remaining = buffer->count.load(std::memory_order_acquire);
+			TraceChunk* chunk = buffer->head;
+			while (remaining > 0 && chunk != NULL) {
+				unsigned long chunk_size = (remaining < TRACE_CHUNK_CAPACITY) ? remaining : TRACE_CHUNK_CAPACITY;
+				events.insert(events.end(), chunk->events, chunk->events + chunk_size);
+				remaining -= chunk_size;
+				chunk = chunk->next.load(std::memory_order_acquire);
+			}
+		}
+		return events;
+	}
+
+	/**
+	 * Records the events of another process in a dedicated track, called "isolated runs".
+	 * The timestamps must be relative to the same start of the tracing, as in a process forked from this one.
+	 * The names of the events are copied, so they can be freed after the call.
+	 * It must be called always by the same thread (the main one).
+	 */
+	void Tracer::importEvents(const std::vector<TraceEvent>& events) {
+		if (events.empty()) {
+			return;
+		}
+		if (imported_buffer == NULL) {
+			imported_buffer = createBuffer(false, "isolated runs");
+		}
+		for (TraceEvent event : events) {
+			event.name = imported_names.insert(event.name).first->c_str();
+			appendEvent(imported_buffer, event);
+		}
+	}
+
+	/**
+	 * Writes a name in a JSON string, escaping the special characters.
+	 */
+	static void writeJSONString(std::ofstream& file_out, const char* text) {
+		file_out << '"';
+		for (const char* c = text; *c != '\0'; c++) {
+			if (*c == '"' || *c == '\\') {
+				file_out << '\\';
+			}
+			file_out << *c;
+		}
+		file_out << '"';
+	}
+
+	/**
+	 * Writes all the published events of all the threads in a file, in the Chrome trace format.
+	 * The timestamps are written in microseconds, as required by the format.
+	 * Returns FALSE if the file cannot be written.
+	 */
+	bool Tracer::exportChromeTrace(std::string file_name) {
+		std::ofstream file_out(file_name);
+		if (!file_out.is_open()) {
+			DEBUG_LOG_ERROR("Cannot open the trace file \"%s\"", file_name.c_str());
+			return false;
+		}
+		pid_t pid = getpid();
+		bool first_event = true;
+		file_out << std::fixed << std::setprecision(3);
+		file_out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		std::lock_guard<std::mutex> lock(trace_buffers_mutex);
+		for (TraceBuffer* buffer : trace_buffers) {
+			// Name of the thread, shown by the viewer
+			file_out << (first_event ? "\n" : ",\n");
+			first_event = false;
+			file_out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->thread_id
+					<< ",\"args\":{\"name\":\"" << (buffer->label != NULL ? std::string(buffer->label)
+							: buffer->main_thread ? "main" : "thread " + std::to_string(buffer->thread_id)) << "\"}}";
+
+			unsigned long remaining = buffer->count.load(std::memory_order_acquire);
+			TraceChunk* chunk = buffer->head;
+			while (remaining > 0 && chunk != NULL) {
+				unsigned long chunk_size = (remaining < TRACE_CHUNK_CAPACITY) ? remaining : TRACE_CHUNK_CAPACITY;
+				for (unsigned long i = 0; i < chunk_size; i++) {
+					const TraceEvent& event = chunk->events[i];
+					file_out << ",\n{\"name\":";
+					writeJSONString(file_out, event.name);
+					file_out << ",\"ph\":\"" << event.phase << "\",\"pid\":" << pid << ",\"tid\":" << buffer->thread_id
+							<< ",\"ts\":" << (event.timestamp / 1000.0);
+					if (event.phase == 'X') {
+						file_out << ",\"dur\":" << (event.duration / 1000.0);
+					} else {
+						file_out << ",\"args\":{\"value\":" << event.value << "}";
+					}
+					file_out << "}";
+				}
+				remaining -= chunk_size;
+				chunk = chunk->next.load(std::memory_order_acquire);
+			}
+		}
+
+		file_out << "\n]}\n";
+		file_out.close();
+		return !file_out.fail();
+	}
+
+} /* namespace quicksc */
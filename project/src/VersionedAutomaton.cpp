@@ -0,0 +1,535 @@
+/*
+ * Michele Dusi, Gianfranco Lamperti
+ * Quick Subset Construction
+ *
+ * VersionedAutomaton.cpp
+ *
+ *
+ * This source file contains the implementation of the classes AutomatonSnapshot, SnapshotGuard and VersionedAutomaton.
+ */
+
+#include "VersionedAutomaton.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "Alphabet.hpp"
+
+//#define DEBUG_MODE
+#include "Debug.hpp"
+
+namespace quicksc {
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// AutomatonSnapshot
+
+	/**
+	 * Constructor.
+	 * It creates an empty snapshot, filled by the VersionedAutomaton at the publication.
+	 */
+	AutomatonSnapshot::AutomatonSnapshot() {
+		this->m_version = 0;
+		this->m_initial_state = SNAPSHOT_NO_STATE;
+		this->m_rows_count = 0;
+		this->m_states_count = 0;
+		this->m_transitions_count = 0;
+	}
+
+	/**
+	 * Destructor.
+	 * The chunks are deleted only if no other snapshot shares them.
+	 */
+	AutomatonSnapshot::~AutomatonSnapshot() {}
+
+	/**
+	 * Private method.
+	 * Returns the row of the state with the given number.
+	 */
+	const SnapshotRow& AutomatonSnapshot::getRow(uint32_t state) const {
+		return this->m_chunks[state / SNAPSHOT_CHUNK_SIZE]->rows[state % SNAPSHOT_CHUNK_SIZE];
+	}
+
+	/**
+	 * Private method.
+	 * Adds to the set all the states reachable from its states with epsilon-transitions.
+	 */
+	void AutomatonSnapshot::addEpsilonClosure(std::set<uint32_t>& states) const {
+		auto epsilon = this->m_labels->find(EPSILON);
+		if (epsilon == this->m_labels->end()) {
+			return;
+		}
+		std::vector<uint32_t> to_visit = std::vector<uint32_t>(states.begin(), states.end());
+		while (!to_visit.empty()) {
+			const SnapshotRow& row = this->getRow(to_visit.back());
+			to_visit.pop_back();
+			auto iterator = std::lower_bound(row.transitions.begin(), row.transitions.end(), std::make_pair(epsilon->second, (uint32_t) 0));
+			for (; iterator != row.transitions.end() && iterator->first == epsilon->second; iterator++) {
+				if (states.insert(iterator->second).second) {
+					to_visit.push_back(iterator->second);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Returns the number of the version, starting from 1 for the first publication.
+	 */
+	uint64_t AutomatonSnapshot::getVersion() const {
+		return this->m_version;
+	}
+
+	/**
+	 * Returns the number of states of the version.
+	 */
+	uint32_t AutomatonSnapshot::getStatesCount() const {
+		return this->m_states_count;
+	}
+
+	/**
+	 * Returns the number of transitions of the version.
+	 */
+	unsigned long AutomatonSnapshot::getTransitionsCount() const {
+		return this->m_transitions_count;
+	}
+
+	/**
+	 * Returns true if the version of the automaton accepts the word, given as a sequence of labels.
+	 * The automaton can be nondeterministic, also with epsilon-transitions: the word is accepted if at least one
+	 * of the states reached by its simulation is final.
+	 */
+	bool AutomatonSnapshot::accepts(const std::vector<std::string>& word) const {
+		if (this->m_initial_state == SNAPSHOT_NO_STATE) {
+			return false;
+		}
+		std::set<uint32_t> current = { this->m_initial_state };
+		this->addEpsilonClosure(current);
+		for (const std::string& label : word) {
+			auto label_iterator = this->m_labels->find(label);
+			if (label_iterator == this->m_labels->end()) {
+				return false;
+			}
+			std::set<uint32_t> next;
+			for (uint32_t state : current) {
+				const SnapshotRow& row = this->getRow(state);
+				auto iterator = std::lower_bound(row.transitions.begin(), row.transitions.end(), std::make_pair(label_iterator->second, (uint32_t) 0));
+				for (; iterator != row.transitions.end() && iterator->first == label_iterator->second; iterator++) {
+					next.insert(iterator->second);
+				}
+			}
+			if (next.empty()) {
+				return false;
+			}
+			this->addEpsilonClosure(next);
+			current.swap(next);
+		}
+		return std::any_of(current.begin(), current.end(), [this](uint32_t state) { return this->getRow(state).final; });
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// SnapshotGuard
+
+	/**
+	 * Constructor.
+	 * It's used by the VersionedAutomaton, after the slot has been reserved for the reader.
+	 */
+	SnapshotGuard::SnapshotGuard(VersionedAutomaton* owner, unsigned int slot, const AutomatonSnapshot* snapshot) {
+		this->m_owner = owner;
+		this->m_slot = slot;
+		this->m_snapshot = snapshot;
+	}
+
+	/**
+	 * Move constructor.
+	 * The slot passes to the new guard, so it's released only once.
+	 */
+	SnapshotGuard::SnapshotGuard(SnapshotGuard&& other) {
+		this->m_owner = other.m_owner;
+		this->m_slot = other.m_slot;
+		this->m_snapshot = other.m_snapshot;
+		other.m_owner = NULL;
+		other.m_snapshot = NULL;
+	}
+
+	/**
+	 * Destructor.
+	 * It releases the snapshot, which can then be deleted if it's not the current version anymore.
+	 */
+	SnapshotGuard::~SnapshotGuard() {
+		if (this->m_owner != NULL) {
+			this->m_owner->release(this->m_slot);
+		}
+	}
+
+	/**
+	 * Returns the pinned snapshot.
+	 */
+	const AutomatonSnapshot* SnapshotGuard::get() const {
+		return this->m_snapshot;
+	}
+
+	/**
+	 * Gives access to the methods of the pinned snapshot.
+	 */
+	const AutomatonSnapshot* SnapshotGuard::operator->() const {
+		return this->m_snapshot;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// VersionedAutomaton
+
+	/**
+	 * Constructor.
+	 * No version is available until an automaton is attached.
+	 */
+	VersionedAutomaton::VersionedAutomaton() {
+		this->m_automaton = NULL;
+		this->m_previous_observer = NULL;
+		this->m_rows_count = 0;
+		this->m_states_count = 0;
+		this->m_transitions_count = 0;
+		this->m_restart = false;
+		this->m_labels = std::make_shared<const std::map<std::string, uint32_t>>();
+		this->m_reclaimed_count = 0;
+		this->m_current.store(NULL);
+		this->m_epoch.store(1);
+		for (unsigned int slot = 0; slot < SNAPSHOT_READER_SLOTS; slot++) {
+			this->m_slots[slot].store(SNAPSHOT_FREE_SLOT);
+		}
+	}
+
+	/**
+	 * Destructor.
+	 * It deletes all the versions; there must be no readers holding a snapshot.
+	 */
+	VersionedAutomaton::~VersionedAutomaton() {
+		this->stopObserving();
+		for (auto &pair : this->m_retired) {
+			delete pair.second;
+		}
+		delete this->m_current.load();
+	}
+
+	/**
+	 * Starts the versioning of the automaton, and publishes its first version.
+	 * From now on, the modifications made by the current thread are observed, until the "detach" method is called.
+	 * If another automaton was attached before, its versions are replaced by the ones of the new automaton.
+	 */
+	void VersionedAutomaton::attach(Automaton* automaton) {
+		if (this->m_automaton != NULL) {
+			DEBUG_LOG_ERROR("Cannot attach an automaton to a VersionedAutomaton already attached to another one");
+			throw "The VersionedAutomaton is already attached to an automaton";
+		}
+		this->m_automaton = automaton;
+		this->m_previous_observer = State::getObserver();
+		State::setObserver(this);
+
+		// The numbering restarts from zero, so the following version doesn't share any chunk with the previous ones
+		this->m_numbers.clear();
+		this->m_modified_states.clear();
+		this->m_destroyed_rows.clear();
+		this->m_label_ids.clear();
+		this->m_labels = std::make_shared<const std::map<std::string, uint32_t>>();
+		this->m_rows_count = 0;
+		this->m_states_count = 0;
+		this->m_transitions_count = 0;
+		this->m_restart = true;
+		for (State* state : automaton->getStatesVector()) {
+			this->m_numbers[state] = this->m_rows_count++;
+			this->m_modified_states.insert(state);
+		}
+		this->publish();
+	}
+
+	/**
+	 * Publishes the last version of the automaton and stops the versioning.
+	 * The published versions remain available to the readers.
+	 */
+	void VersionedAutomaton::detach() {
+		if (this->m_automaton == NULL) {
+			return;
+		}
+		this->publish();
+		this->stopObserving();
+	}
+
+	/**
+	 * Private method.
+	 * Stops the versioning without publishing, restoring the observer of the thread set before the attachment.
+	 */
+	void VersionedAutomaton::stopObserving() {
+		if (this->m_automaton == NULL) {
+			return;
+		}
+		State::setObserver(this->m_previous_observer);
+		this->m_previous_observer = NULL;
+		this->m_automaton = NULL;
+	}
+
+	/**
+	 * Private method.
+	 * Returns the number of the state; if the state has not a number yet, it's assigned now,
+	 * and the state is added to the ones whose row must be built.
+	 */
+	uint32_t VersionedAutomaton::getNumber(State* state, std::vector<State*>& to_build) {
+		auto iterator = this->m_numbers.find(state);
+		if (iterator != this->m_numbers.end()) {
+			return iterator->second;
+		}
+		uint32_t number = this->m_rows_count++;
+		this->m_numbers[state] = number;
+		to_build.push_back(state);
+		return number;
+	}
+
+	/**
+	 * Publishes a new version of the automaton, containing all the modifications made since the previous one.
+	 * Only the rows of the modified states (and of the states reached for the first time) are built, and only the chunks
+	 * containing them are copied; the other chunks are shared with the previous version.
+	 * It must be called by the writer thread, when the automaton is in a consistent state.
+	 */
+	void VersionedAutomaton::publish() {
+		if (this->m_automaton == NULL) {
+			DEBUG_LOG_ERROR("Cannot publish a version without an attached automaton");
+			throw "No automaton is attached to the VersionedAutomaton";
+		}
+		AutomatonSnapshot* previous = this->m_current.load();
+		AutomatonSnapshot* snapshot = new AutomatonSnapshot();
+		snapshot->m_version = (previous != NULL) ? previous->m_version + 1 : 1;
+		if (previous != NULL && !this->m_restart) {
+			snapshot->m_chunks = previous->m_chunks;
+		}
+		this->m_restart = false;
+
+		// Copy-on-write of the chunks: each chunk is copied at the first modification of one of its rows
+		std::map<uint32_t, std::shared_ptr<SnapshotChunk>> copied_chunks;
+		auto get_writable_row = [&](uint32_t number) -> SnapshotRow& {
+			uint32_t chunk = number / SNAPSHOT_CHUNK_SIZE;
+			auto iterator = copied_chunks.find(chunk);
+			if (iterator == copied_chunks.end()) {
+				if (snapshot->m_chunks.size() <= chunk) {
+					snapshot->m_chunks.resize(chunk + 1);
+				}
+				std::shared_ptr<SnapshotChunk> copy = (snapshot->m_chunks[chunk] != NULL)
+						? std::make_shared<SnapshotChunk>(*snapshot->m_chunks[chunk])
+						: std::make_shared<SnapshotChunk>();
+				snapshot->m_chunks[chunk] = copy;
+				iterator = copied_chunks.insert({ chunk, copy }).first;
+			}
+			return iterator->second->rows[number % SNAPSHOT_CHUNK_SIZE];
+		};
+
+		// Rows of the destroyed states
+		for (uint32_t number : this->m_destroyed_rows) {
+			SnapshotRow& row = get_writable_row(number);
+			if (row.present) {
+				this->m_states_count--;
+				this->m_transitions_count -= row.transitions.size();
+			}
+			row = SnapshotRow();
+		}
+		this->m_destroyed_rows.clear();
+
+		// Rows of the modified states; the children without a number are numbered and built too
+		std::vector<State*> to_build;
+		for (State* state : this->m_modified_states) {
+			if (this->m_numbers.count(state) > 0) {
+				to_build.push_back(state);
+			}
+		}
+		this->m_modified_states.clear();
+		State* initial_state = this->m_automaton->getInitialState();
+		snapshot->m_initial_state = (initial_state != NULL) ? this->getNumber(initial_state, to_build) : SNAPSHOT_NO_STATE;
+		bool new_labels = false;
+		std::set<uint32_t> built;
+		while (!to_build.empty()) {
+			State* state = to_build.back();
+			to_build.pop_back();
+			uint32_t number = this->m_numbers[state];
+			if (!built.insert(number).second) {
+				continue;
+			}
+			SnapshotRow& row = get_writable_row(number);
+			if (row.present) {
+				this->m_transitions_count -= row.transitions.size();
+			} else {
+				this->m_states_count++;
+			}
+			row.present = true;
+			row.final = state->isFinal();
+			row.transitions.clear();
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				if (pair.second.empty()) {
+					continue;
+				}
+				auto label_iterator = this->m_label_ids.find(pair.first);
+				if (label_iterator == this->m_label_ids.end()) {
+					label_iterator = this->m_label_ids.insert({ pair.first, (uint32_t) this->m_label_ids.size() }).first;
+					new_labels = true;
+				}
+				for (State* child : pair.second) {
+					uint32_t child_number = this->getNumber(child, to_build);
+					// The row stays in place, since its chunk has already been copied
+					row.transitions.push_back({ label_iterator->second, child_number });
+				}
+			}
+			std::sort(row.transitions.begin(), row.transitions.end());
+			this->m_transitions_count += row.transitions.size();
+		}
+
+		// The table of the labels is shared until a new label appears
+		if (new_labels) {
+			this->m_labels = std::make_shared<const std::map<std::string, uint32_t>>(this->m_label_ids);
+		}
+		snapshot->m_labels = this->m_labels;
+		snapshot->m_rows_count = this->m_rows_count;
+		snapshot->m_states_count = this->m_states_count;
+		snapshot->m_transitions_count = this->m_transitions_count;
+
+		// The new version replaces the current one, which is retired at the new epoch
+		AutomatonSnapshot* old_snapshot = this->m_current.exchange(snapshot);
+		uint64_t retirement_epoch = this->m_epoch.fetch_add(1) + 1;
+		if (old_snapshot != NULL) {
+			this->m_retired.push_back({ retirement_epoch, old_snapshot });
+		}
+		DEBUG_LOG("Published version %lu, with %u rows built", snapshot->m_version, (unsigned int) built.size());
+		this->reclaim();
+	}
+
+	/**
+	 * Private method.
+	 * Deletes the retired versions that no reader can hold anymore, i.e. the ones retired at an epoch
+	 * not greater than the minimum epoch announced by the active readers.
+	 */
+	void VersionedAutomaton::reclaim() {
+		uint64_t minimum_epoch = UINT64_MAX;
+		for (unsigned int slot = 0; slot < SNAPSHOT_READER_SLOTS; slot++) {
+			uint64_t epoch = this->m_slots[slot].load();
+			if (epoch != SNAPSHOT_FREE_SLOT) {
+				minimum_epoch = std::min(minimum_epoch, epoch);
+			}
+		}
+		auto end = std::remove_if(this->m_retired.begin(), this->m_retired.end(), [this, minimum_epoch](auto &pair) {
+			if (pair.first > minimum_epoch) {
+				return false;
+			}
+			delete pair.second;
+			this->m_reclaimed_count++;
+			return true;
+		});
+		this->m_retired.erase(end, this->m_retired.end());
+	}
+
+	/**
+	 * Private method.
+	 * Releases the slot of a reader.
+	 */
+	void VersionedAutomaton::release(unsigned int slot) {
+		this->m_slots[slot].store(SNAPSHOT_FREE_SLOT);
+	}
+
+	/**
+	 * Pins the current version of the automaton, and returns the guard that keeps it alive.
+	 * It can be called by any thread. If all the slots are taken, it waits for a reader to release its snapshot.
+	 */
+	SnapshotGuard VersionedAutomaton::pin() {
+		if (this->m_current.load() == NULL) {
+			DEBUG_LOG_ERROR("Cannot pin a version before the first publication");
+			throw "No version of the automaton has been published";
+		}
+		while (true) {
+			for (unsigned int slot = 0; slot < SNAPSHOT_READER_SLOTS; slot++) {
+				// The epoch is announced before reading the current version: if the version is retired later,
+				// its retirement epoch is greater than the announced one, and the writer doesn't delete it
+				uint64_t free_slot = SNAPSHOT_FREE_SLOT;
+				uint64_t epoch = this->m_epoch.load();
+				if (this->m_slots[slot].compare_exchange_strong(free_slot, epoch)) {
+					return SnapshotGuard(this, slot, this->m_current.load());
+				}
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * Returns the number of the current version, or 0 if no version has been published.
+	 */
+	uint64_t VersionedAutomaton::getVersion() {
+		AutomatonSnapshot* current = this->m_current.load();
+		return (current != NULL) ? current->m_version : 0;
+	}
+
+	/**
+	 * Returns the number of old versions not deleted yet, since some readers may still hold them.
+	 */
+	unsigned long VersionedAutomaton::getRetiredCount() {
+		return this->m_retired.size();
+	}
+
+	/**
+	 * Returns the number of old versions deleted so far.
+	 */
+	unsigned long VersionedAutomaton::getReclaimedCount() {
+		return this->m_reclaimed_count;
+	}
+
+	/**
+	 * Records the modification of a state, whose row will be built again at the next publication.
+	 * The notification is forwarded to the previous observer of the thread, if any.
+	 */
+	void VersionedAutomaton::notifyModification(State* state) {
+		this->m_modified_states.insert(state);
+		if (this->m_previous_observer != NULL) {
+			this->m_previous_observer->notifyModification(state);
+		}
+	}
+
+	/**
+	 * Records the destruction of a state, whose row will be removed at the next publication.
+	 */
+	void VersionedAutomaton::notifyDestruction(State* state) {
+		this->m_modified_states.erase(state);
+		auto iterator = this->m_numbers.find(state);
+		if (iterator != this->m_numbers.end()) {
+			this->m_destroyed_rows.push_back(iterator->second);
+			this->m_numbers.erase(iterator);
+		}
+		if (this->m_previous_observer != NULL) {
+			this->m_previous_observer->notifyDestruction(state);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// ScopedAttachment
+
+	/**
+	 * Constructor.
+	 * It attaches the automaton to the VersionedAutomaton, if not NULL.
+	 */
+	ScopedAttachment::ScopedAttachment(VersionedAutomaton* versioned_automaton, Automaton* automaton) {
+		this->m_versioned_automaton = versioned_automaton;
+		if (this->m_versioned_automaton != NULL) {
+			this->m_versioned_automaton->attach(automaton);
+		}
+	}
+
+	/**
+	 * Destructor.
+	 * If the automaton has not been detached, the versioning is stopped without publishing the last version.
+	 */
+	ScopedAttachment::~ScopedAttachment() {
+		if (this->m_versioned_automaton != NULL) {
+			this->m_versioned_automaton->stopObserving();
+		}
+	}
+
+	/**
+	 * Publishes the last version of the automaton and stops the versioning.
+	 */
+	void ScopedAttachment::detach() {
+		if (this->m_versioned_automaton != NULL) {
+			this->m_versioned_automaton->detach();
+			this->m_versioned_automaton = NULL;
+		}
+	}
+
+} /* namespace quicksc */